@@ -0,0 +1,121 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                        LPLIB C++ FRONT END CHECK                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       run loops and pipelines through lplib3.hpp with       */
+/*                      capturing lambdas and compare them to serial results  */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdio>
+#include <vector>
+#include "lplib3.hpp"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbEdg 100000
+#define NmbPip 64
+
+
+/*----------------------------------------------------------------------------*/
+/* Count each vertex's edges with ParallelFor and LaunchParallel, then run    */
+/* pipelines that each depend on the previous one                             */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, bad = 0, EdgTyp, VerTyp, PipIdx = 0, NmbDon = 0, OrdErr = 0;
+   int64_t ParIdx;
+   float sta[2];
+   std::vector<itg> EdgVer(2 * (NmbEdg + 1));
+   std::vector<int> VerCnt(NmbEdg + 2, 0), EdgSiz(MaxPth, 0);
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[ 2*i ] = i;
+      EdgVer[ 2*i+1 ] = i + 1;
+   }
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   if( !(EdgTyp = NewType(ParIdx, NmbEdg))
+   ||  !(VerTyp = NewType(ParIdx, NmbEdg + 1))
+   ||  !BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0], sta) )
+   {
+      return(1);
+   }
+
+   // Each line's vertices, the dependencies keep the increments exclusive
+   if(lplib::ParallelFor(ParIdx, EdgTyp, VerTyp, [&](itg idx, int)
+      {
+         VerCnt[ EdgVer[ 2*idx ] ]++;
+         VerCnt[ EdgVer[ 2*idx+1 ] ]++;
+      }) < 0)
+   {
+      bad++;
+   }
+
+   for(i=2;i<=NmbEdg;i++)
+      if(VerCnt[i] != 2)
+         bad++;
+
+   // Whole ranges, each thread sums the size of the ranges it got
+   if(lplib::LaunchParallel(ParIdx, EdgTyp, 0, [&](itg BegIdx, itg EndIdx, int PthIdx)
+      {
+         EdgSiz[ PthIdx ] += (int)(EndIdx - BegIdx + 1);
+      }) < 0)
+   {
+      bad++;
+   }
+
+   for(i=0, NmbDon=0; i<MaxPth; i++)
+      NmbDon += EdgSiz[i];
+
+   if(NmbDon != NmbEdg)
+      bad++;
+
+   // Chained pipes must run one after the other, their lambda is copied
+   NmbDon = 0;
+
+   for(i=1;i<=NmbPip;i++)
+   {
+      int dep = PipIdx, rnk = i;
+
+      PipIdx = lplib::LaunchPipeline(ParIdx, dep ? 1 : 0, dep ? &dep : NULL,
+         [&NmbDon, &OrdErr, rnk]()
+         {
+            if(NmbDon != rnk - 1)
+               OrdErr++;
+
+            NmbDon++;
+         });
+
+      if(!PipIdx)
+         bad++;
+   }
+
+   WaitPipeline(ParIdx);
+
+   if(OrdErr || (NmbDon != NmbPip))
+      bad++;
+
+   StopParallel(ParIdx);
+
+   printf("%d errors, %d out of order pipes\n", bad, OrdErr);
+
+   return(bad ? 1 : 0);
+}
@@ -0,0 +1,229 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                        LPLIB MESH EDGES CHECK                              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       build the edges of a shuffled Kuhn tet mesh, alone    */
+/*                      and mixed with its boundary triangles and the hexes   */
+/*                      of its cubes, and compare them with a serial build    */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lplib3.h"
+#include "lplib3_helpers.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbCub 12
+#define NmbVer ((NmbCub + 1) * (NmbCub + 1) * (NmbCub + 1))
+#define NmbTet (6 * NmbCub * NmbCub * NmbCub)
+#define NmbHex (NmbCub * NmbCub * NmbCub)
+#define NmbTri (12 * NmbCub * NmbCub)
+#define NmbEdg (3 * NmbCub * (NmbCub + 1) * (NmbCub + 1) \
+             +  3 * NmbCub * NmbCub * (NmbCub + 1) + NmbHex)
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg      TetVer[ NmbTet + 1 ][4], HexVer[ NmbHex + 1 ][8];
+static itg      TriVer[ NmbTri + 1 ][3], Old2New[ NmbVer + 1 ], VerCrd[ NmbVer + 1 ][3];
+static uint64_t RefKey[ 6 * NmbTet ], OutKey[ 6 * NmbTet ];
+static uint64_t RndSed = 1;
+
+
+/*----------------------------------------------------------------------------*/
+/* Reproducible pseudo random generator                                       */
+/*----------------------------------------------------------------------------*/
+
+static itg RndInt(itg siz)
+{
+   RndSed = RndSed * 6364136223846793005ULL + 1442695040888963407ULL;
+   return((itg)((RndSed >> 33) % siz));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a Kuhn tet mesh of NmbCub^3 cubes with randomly numbered vertices,   */
+/* the hexes of its cubes and its boundary triangles                          */
+/*----------------------------------------------------------------------------*/
+
+static int BldMsh()
+{
+   int i, j, k, l, d, a, CubVer[8], TriIdx = 0, TetIdx = 0, HexIdx = 0, n = NmbCub;
+   itg idx, tmp, *fac[3];
+   int KuhTet[6][4] = {  {0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                         {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+   int TetFac[4][3] = { {1,2,3}, {2,0,3}, {3,0,1}, {0,2,1} };
+
+   for(i=1;i<=NmbVer;i++)
+      Old2New[i] = i;
+
+   for(i=NmbVer;i>1;i--)
+   {
+      idx = 1 + RndInt(i);
+      tmp = Old2New[i];
+      Old2New[i] = Old2New[ idx ];
+      Old2New[ idx ] = tmp;
+   }
+
+   for(k=0;k<=n;k++)
+      for(j=0;j<=n;j++)
+         for(i=0;i<=n;i++)
+         {
+            idx = Old2New[ 1 + i + (n+1) * (j + (n+1) * k) ];
+            VerCrd[ idx ][0] = i;
+            VerCrd[ idx ][1] = j;
+            VerCrd[ idx ][2] = k;
+         }
+
+   for(k=0;k<n;k++)
+      for(j=0;j<n;j++)
+         for(i=0;i<n;i++)
+         {
+            for(l=0;l<8;l++)
+               CubVer[l] = 1 + (i + ((l & 1) ^ ((l >> 1) & 1)))
+                         + (n+1) * (j + ((l >> 1) & 1))
+                         + (n+1) * (n+1) * (k + ((l >> 2) & 1));
+
+            HexIdx++;
+
+            for(l=0;l<8;l++)
+               HexVer[ HexIdx ][l] = Old2New[ CubVer[l] ];
+
+            for(l=0;l<6;l++)
+            {
+               TetIdx++;
+
+               for(d=0;d<4;d++)
+                  TetVer[ TetIdx ][d] = Old2New[ CubVer[ KuhTet[l][d] ] ];
+
+               // Faces whose vertices all lie on a side of the box
+               for(d=0;d<4;d++)
+               {
+                  fac[0] = VerCrd[ TetVer[ TetIdx ][ TetFac[d][0] ] ];
+                  fac[1] = VerCrd[ TetVer[ TetIdx ][ TetFac[d][1] ] ];
+                  fac[2] = VerCrd[ TetVer[ TetIdx ][ TetFac[d][2] ] ];
+
+                  for(a=0;a<3;a++)
+                     if( (fac[0][a] == fac[1][a]) && (fac[0][a] == fac[2][a])
+                     &&  (!fac[0][a] || (fac[0][a] == n)) )
+                     {
+                        TriIdx++;
+                        TriVer[ TriIdx ][0] = TetVer[ TetIdx ][ TetFac[d][0] ];
+                        TriVer[ TriIdx ][1] = TetVer[ TetIdx ][ TetFac[d][1] ];
+                        TriVer[ TriIdx ][2] = TetVer[ TetIdx ][ TetFac[d][2] ];
+                     }
+               }
+            }
+         }
+
+   return(TriIdx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort 64-bit keys made of an edge's smallest and largest vertices           */
+/*----------------------------------------------------------------------------*/
+
+static int CmpKey(const void *a, const void *b)
+{
+   uint64_t ka = *(uint64_t *)a, kb = *(uint64_t *)b;
+
+   return((ka > kb) - (ka < kb));
+}
+
+static uint64_t GetKey(itg a, itg b)
+{
+   return((a < b) ? (uint64_t)a * (NmbVer + 1) + b : (uint64_t)b * (NmbVer + 1) + a);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compare a built edge table with the serial reference                       */
+/*----------------------------------------------------------------------------*/
+
+static int ChkEdg(itg NmbOut, itg *EdgTab)
+{
+   itg i;
+
+   if(NmbOut != NmbEdg)
+      return(1);
+
+   for(i=1;i<=NmbOut;i++)
+      OutKey[ i-1 ] = GetKey(EdgTab[ 2*i ], EdgTab[ 2*i+1 ]);
+
+   qsort(OutKey, NmbOut, sizeof(uint64_t), CmpKey);
+
+   return(memcmp(OutKey, RefKey, NmbEdg * sizeof(uint64_t)) != 0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build the edges of the tets alone, then of the mixed mesh, whose hexes and */
+/* triangles add no new edges, then with the compatibility wrapper            */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int bad = 0, EleTyp[3] = {LplTet, LplTri, LplHex};
+   int TetEdg[6][2] = { {0,1}, {1,2}, {2,0}, {3,0}, {3,1}, {3,2} };
+   itg i, j, NmbRef = 0, NmbOut, *EdgTab;
+   itg NmbEle[3] = {NmbTet, NmbTri, NmbHex};
+   itg *EleTab[3] = {&TetVer[0][0], &TriVer[0][0], &HexVer[0][0]};
+   int64_t ParIdx;
+
+   if(BldMsh() != NmbTri)
+      return(1);
+
+   // Serial reference: the sorted unique keys of all the tets' edges
+   for(i=1;i<=NmbTet;i++)
+      for(j=0;j<6;j++)
+         RefKey[ NmbRef++ ] = GetKey(TetVer[i][ TetEdg[j][0] ], TetVer[i][ TetEdg[j][1] ]);
+
+   qsort(RefKey, NmbRef, sizeof(uint64_t), CmpKey);
+
+   for(i=1, j=1; i<NmbRef; i++)
+      if(RefKey[i] != RefKey[ j-1 ])
+         RefKey[ j++ ] = RefKey[i];
+
+   if(j != NmbEdg)
+      bad++;
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   NmbOut = ParallelBuildMeshEdges(ParIdx, 1, EleTyp, NmbEle, EleTab, &EdgTab);
+   bad += ChkEdg(NmbOut, EdgTab);
+   free(EdgTab);
+
+   NmbOut = ParallelBuildMeshEdges(ParIdx, 3, EleTyp, NmbEle, EleTab, &EdgTab);
+   bad += ChkEdg(NmbOut, EdgTab);
+   free(EdgTab);
+
+   StopParallel(ParIdx);
+
+   NmbOut = ParallelBuildEdges(NmbTet, LplTet, EleTab[0], &EdgTab);
+   bad += ChkEdg(NmbOut, EdgTab);
+   free(EdgTab);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
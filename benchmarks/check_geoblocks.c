@@ -0,0 +1,166 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                      LPLIB GEOMETRIC BLOCKS CHECK                          */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       run a dependency loop over the geometric blocks of a  */
+/*                      shuffled grid's edges and check the calls' ordering   */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 14 2026                                           */
+/*   Last modification: oct 14 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define GrdSiz 100
+#define NmbVer (GrdSiz * GrdSiz)
+#define NmbEdg (2 * GrdSiz * (GrdSiz - 1))
+#define NmbRep 50
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg EdgVer[ NmbEdg + 1 ][2], *EdgOrd;
+static int VerOwn[ NmbVer + 1 ], EdgCnt[ NmbEdg + 1 ], NmbCfl;
+static double EdgCrd[ NmbEdg + 1 ][2];
+
+
+/*----------------------------------------------------------------------------*/
+/* Tag an edge's vertices with the WP that writes them, count the conflicts   */
+/* and the edge's visits                                                      */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   itg i, j, EdgIdx;
+   int old;
+
+   (void)(PthIdx);
+   (void)(arg);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      EdgIdx = EdgOrd[i];
+      EdgCnt[ EdgIdx ]++;
+
+      for(j=0;j<2;j++)
+      {
+         old = 0;
+
+         if( !__atomic_compare_exchange_n(&VerOwn[ EdgVer[ EdgIdx ][j] ], &old,
+               BegIdx, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) && (old != BegIdx) )
+         {
+            __atomic_fetch_add(&NmbCfl, 1, __ATOMIC_RELAXED);
+         }
+      }
+   }
+
+   // Let the other threads run so that conflicting WP would overlap
+   sched_yield();
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      for(j=0;j<2;j++)
+         __atomic_store_n(&VerOwn[ EdgVer[ EdgOrd[i] ][j] ], 0, __ATOMIC_RELEASE);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a grid's edges in random order and loop over their geometric blocks  */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, j, k, r, tmp, EdgTyp, VerTyp, bad = 0;
+   int64_t ParIdx;
+   float sta[2];
+
+   for(i=0, k=1; i<GrdSiz; i++)
+      for(j=0;j<GrdSiz-1;j++)
+      {
+         // Horizontal, then vertical edges
+         EdgVer[k][0] = i * GrdSiz + j + 1;
+         EdgVer[k][1] = i * GrdSiz + j + 2;
+         k++;
+         EdgVer[k][0] = j * GrdSiz + i + 1;
+         EdgVer[k][1] = (j + 1) * GrdSiz + i + 1;
+         k++;
+      }
+
+   // Shuffle the edges so that the index ranges are scattered in space
+   srand(1);
+
+   for(i=NmbEdg;i>1;i--)
+   {
+      k = 1 + rand() % i;
+
+      for(j=0;j<2;j++)
+      {
+         tmp = EdgVer[i][j];
+         EdgVer[i][j] = EdgVer[k][j];
+         EdgVer[k][j] = tmp;
+      }
+   }
+
+   for(i=1;i<=NmbEdg;i++)
+      for(j=0;j<2;j++)
+         EdgCrd[i][j] = ( ((EdgVer[i][0] - 1) / (j ? 1 : GrdSiz)) % GrdSiz
+                        + ((EdgVer[i][1] - 1) / (j ? 1 : GrdSiz)) % GrdSiz ) / 2.;
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   EdgTyp = NewType(ParIdx, NmbEdg);
+   VerTyp = NewType(ParIdx, NmbVer);
+
+   if( !SetGeometricBlocks(ParIdx, EdgTyp, 2, &EdgCrd[0][0], &EdgOrd)
+   ||  !BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta) )
+   {
+      return(1);
+   }
+
+   for(r=1;r<=NmbRep;r++)
+   {
+      NmbCfl = 0;
+
+      if( (LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, NULL) < 0) || NmbCfl )
+         bad++;
+
+      for(i=1;i<=NmbEdg;i++)
+         if(EdgCnt[i] != r)
+         {
+            bad++;
+            break;
+         }
+   }
+
+   // Both types are tied by their dependencies and may not be renumbered
+   if( SetGeometricBlocks(ParIdx, EdgTyp, 2, &EdgCrd[0][0], &EdgOrd)
+   ||  SetGeometricBlocks(ParIdx, VerTyp, 2, &EdgCrd[0][0], &EdgOrd)
+   ||  SetGeometricBlocks(ParIdx, EdgTyp, 2, NULL, NULL) )
+   {
+      printf("geometric blocks set after the dependencies\n");
+      bad++;
+   }
+
+   StopParallel(ParIdx);
+   printf("%d errors out of %d launches\n", bad, NmbRep);
+
+   return(bad ? 1 : 0);
+}
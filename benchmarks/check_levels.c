@@ -0,0 +1,159 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   LPLIB AUTOMATIC BLOCK LEVELS CHECK                       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       add a dependency after some launches with automatic   */
+/*                      blocks and check that no conflicting WP run together  */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 14 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbEdg 20000
+#define ExtVer 313
+#define NmbRep 100
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg EdgVer[ NmbEdg + 1 ][2];
+static int VerOwn[ NmbEdg + 2 ], NmbCfl;
+
+
+/*----------------------------------------------------------------------------*/
+/* Tag a vertex with the WP that writes it and count the conflicts            */
+/*----------------------------------------------------------------------------*/
+
+static void TagVer(itg VerIdx, int tag)
+{
+   int old = 0;
+
+   if( !__atomic_compare_exchange_n(&VerOwn[ VerIdx ], &old, tag, 0,
+         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) && (old != tag) )
+   {
+      __atomic_fetch_add(&NmbCfl, 1, __ATOMIC_RELAXED);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Edge 1 also writes the extra vertex added with UpdateDependency            */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   itg i;
+
+   (void)(PthIdx);
+   (void)(arg);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      TagVer(EdgVer[i][0], BegIdx);
+      TagVer(EdgVer[i][1], BegIdx);
+
+      if(i == 1)
+         TagVer(ExtVer, BegIdx);
+   }
+
+   // Let the other threads run so that conflicting WP would overlap
+   sched_yield();
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      __atomic_store_n(&VerOwn[ EdgVer[i][0] ], 0, __ATOMIC_RELEASE);
+      __atomic_store_n(&VerOwn[ EdgVer[i][1] ], 0, __ATOMIC_RELEASE);
+
+      if(i == 1)
+         __atomic_store_n(&VerOwn[ ExtVer ], 0, __ATOMIC_RELEASE);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the loops with and without the automatic levels                        */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, EdgTyp, VerTyp, BlkIdx, CflRep = 0;
+   int64_t ParIdx;
+   float sta[2];
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[i][0] = i;
+      EdgVer[i][1] = i + 1;
+   }
+
+   if(!(ParIdx = InitParallel(GetNumberOfCores() < 4 ? 4 : GetNumberOfCores())))
+      return(1);
+
+   EdgTyp = NewType(ParIdx, NmbEdg);
+   VerTyp = NewType(ParIdx, NmbEdg + 1);
+   SetExtendedAttributes(ParIdx, EnableAutomaticBlocks);
+   SetExtendedAttributes(ParIdx, SetSmallBlock, 64);
+   SetExtendedAttributes(ParIdx, SetDependencyBlock, 64);
+
+   if(!BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta))
+      return(1);
+
+   BlkIdx = GetBlkIdx(ParIdx, EdgTyp, NmbEdg);
+
+   // Let the launches move to the coarser levels
+   for(i=0;i<20;i++)
+      LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, NULL);
+
+   // The queries must still answer from the finest blocks
+   if(GetBlkIdx(ParIdx, EdgTyp, NmbEdg) != BlkIdx)
+   {
+      printf("block index changed from %d to %d\n",
+               BlkIdx, GetBlkIdx(ParIdx, EdgTyp, NmbEdg));
+      return(1);
+   }
+
+   UpdateDependency(ParIdx, EdgTyp, VerTyp, 1, ExtVer);
+
+   // A line beyond NmbLin is not covered by the coarser levels
+   UpdateDependency(ParIdx, EdgTyp, VerTyp, 2 * NmbEdg, ExtVer);
+
+   // Check the levels first, then the finest blocks alone
+   for(i=0;i<2*NmbRep;i++)
+   {
+      if(i == NmbRep)
+      {
+         // A word beyond the stride of the coarser levels drops them
+         UpdateDependency(ParIdx, EdgTyp, VerTyp, 2, 2 * NmbEdg);
+         SetExtendedAttributes(ParIdx, DisableAutomaticBlocks);
+      }
+
+      NmbCfl = 0;
+      LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, NULL);
+      CflRep += (NmbCfl > 0);
+   }
+
+   StopParallel(ParIdx);
+   printf("%d launches out of %d ran conflicting WP\n", CflRep, 2*NmbRep);
+
+   return(CflRep ? 1 : 0);
+}
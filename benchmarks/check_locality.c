@@ -0,0 +1,117 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     LPLIB LOCALITY SCHEDULING CHECK                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       run dependency loops with the locality scheduling,    */
+/*                      with and without locks, check the vertices' counts    */
+/*                      and that the threads did follow their previous WP     */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbEdg 200000
+#define NmbRep 10
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg EdgVer[ NmbEdg + 1 ][2];
+static int VerCnt[ NmbEdg + 2 ];
+
+
+/*----------------------------------------------------------------------------*/
+/* Count each vertex's visits, the dependencies keep the increments exclusive */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg BegIdx, itg EndIdx, int PthIdx, int *tab)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      tab[ EdgVer[i][0] ]++;
+      tab[ EdgVer[i][1] ]++;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the loops with the dynamic and the lock-free schedulers                */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, r, m, EdgTyp, VerTyp, bad = 0;
+   int64_t ParIdx;
+   float sta[2], hit;
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[i][0] = i;
+      EdgVer[i][1] = i + 1;
+   }
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   SetExtendedAttributes(ParIdx, EnableLocalityScheduling);
+
+   if( !(EdgTyp = NewType(ParIdx, NmbEdg))
+   ||  !(VerTyp = NewType(ParIdx, NmbEdg + 1))
+   ||  !BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta) )
+   {
+      return(1);
+   }
+
+   for(m=0;m<2;m++)
+   {
+      SetExtendedAttributes(ParIdx, m ? LockFreeScheduling : DynamicScheduling);
+
+      for(r=1;r<=NmbRep;r++)
+      {
+         if(LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, VerCnt) < 0)
+            bad++;
+
+         // A chain of WP always leaves a neighbour to the ones run first
+         hit = GetLocalityStats(ParIdx);
+
+         if( (hit <= 0.) || (hit > 1.) )
+            bad++;
+      }
+
+      for(i=2;i<=NmbEdg;i++)
+         if(VerCnt[i] != 2 * (m + 1) * NmbRep)
+         {
+            bad++;
+            break;
+         }
+   }
+
+   StopParallel(ParIdx);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
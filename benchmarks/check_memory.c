@@ -0,0 +1,217 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     LPLIB PARALLEL MEMORY CALLS CHECK                      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       fill, copy, gather, scatter and sum misaligned tables */
+/*                      of odd sizes, below and above the parallel and the    */
+/*                      streaming thresholds, and compare with serial loops   */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define MaxSiz 40000003
+#define NmbSiz 5
+#define MaxItm 1000003
+#define ItmSiz 12
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static char    *src, *dst;
+static int64_t ParIdx;
+static int     NmbRej;
+
+
+/*----------------------------------------------------------------------------*/
+/* The memory calls must be refused from a running loop                       */
+/*----------------------------------------------------------------------------*/
+
+static void RejPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   (void)(BegIdx);
+   (void)(EndIdx);
+   (void)(arg);
+
+   if(!PthIdx && !ParallelMemCopy(ParIdx, dst, src, 1000))
+      NmbRej++;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run each call on odd sizes and offsets and check every byte                */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int s, p, TmpTyp, bad = 0;
+   size_t i, siz, SizTab[ NmbSiz ] = {0, 1, 4097, 1000001, MaxSiz - 8};
+   size_t PatSiz[3] = {1, 3, 13};
+   char pat[13] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+   itg n, *tab, *ref, *IdxTab, NmbTab[3] = {1, 4097, MaxItm - 1};
+   uint64_t rnd = 1;
+
+   if( !(src = malloc(MaxSiz)) || !(dst = malloc(MaxSiz))
+   ||  !(tab = malloc((MaxItm + 1) * sizeof(itg)))
+   ||  !(ref = malloc((MaxItm + 1) * sizeof(itg)))
+   ||  !(IdxTab = malloc((MaxItm + 1) * sizeof(itg))) )
+   {
+      return(1);
+   }
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   for(i=0;i<MaxSiz;i++)
+      src[i] = (char)(i * 7 + 3);
+
+   // Fill and copy from odd addresses, the last pattern may be truncated
+   for(s=0;s<NmbSiz;s++)
+   {
+      siz = SizTab[s];
+
+      for(p=0;p<3;p++)
+      {
+         memset(dst, 0x55, siz + 8);
+
+         if(!ParallelMemFill(ParIdx, dst + 3, siz, pat, PatSiz[p]))
+            bad++;
+
+         for(i=0;i<siz;i++)
+            if(dst[ i + 3 ] != pat[ i % PatSiz[p] ])
+            {
+               printf("fill of %zu bytes with %zu failed at %zu\n", siz, PatSiz[p], i);
+               bad++;
+               break;
+            }
+
+         if( (dst[2] != 0x55) || (dst[ siz + 3 ] != 0x55) )
+            bad++;
+      }
+
+      memset(dst, 0x55, siz + 8);
+
+      if( !ParallelMemCopy(ParIdx, dst + 5, src + 1, siz)
+      ||  memcmp(dst + 5, src + 1, siz) || (dst[4] != 0x55) || (dst[ siz + 5 ] != 0x55) )
+      {
+         printf("copy of %zu bytes failed\n", siz);
+         bad++;
+      }
+
+      memset(dst, 0x55, siz + 8);
+
+      if( !ParallelMemClear(ParIdx, dst + 1, siz) || (dst[0] != 0x55)
+      ||  (dst[ siz + 1 ] != 0x55) )
+      {
+         bad++;
+      }
+
+      for(i=0;i<siz;i++)
+         if(dst[ i + 1 ])
+         {
+            printf("clear of %zu bytes failed\n", siz);
+            bad++;
+            break;
+         }
+   }
+
+   // Gather and scatter items of 12 bytes, at an odd address, through a
+   // random permutation, then check that a scatter undoes the gather
+   for(s=0;s<3;s++)
+   {
+      n = NmbTab[s];
+
+      for(i=1;i<=(size_t)n;i++)
+         IdxTab[i] = (itg)i;
+
+      for(i=n;i>1;i--)
+      {
+         rnd = rnd * 6364136223846793005ULL + 1442695040888963407ULL;
+         p = 1 + (int)((rnd >> 33) % i);
+         IdxTab[0] = IdxTab[i];
+         IdxTab[i] = IdxTab[p];
+         IdxTab[p] = IdxTab[0];
+      }
+
+      if(!ParallelGather(ParIdx, dst + 1, src + 1, ItmSiz, n, IdxTab))
+         bad++;
+
+      for(i=1;i<=(size_t)n;i++)
+         if(memcmp(dst + 1 + i * ItmSiz, src + 1 + IdxTab[i] * ItmSiz, ItmSiz))
+         {
+            printf("gather of %d items failed\n", (int)n);
+            bad++;
+            break;
+         }
+
+      memset(src + 1 + ItmSiz, 0, n * ItmSiz);
+
+      if(!ParallelScatter(ParIdx, src + 1, dst + 1, ItmSiz, n, IdxTab))
+         bad++;
+
+      for(i=ItmSiz;i<(size_t)(n + 1) * ItmSiz;i++)
+         if(src[ i + 1 ] != (char)((i + 1) * 7 + 3))
+         {
+            printf("scatter of %d items failed\n", (int)n);
+            bad++;
+            break;
+         }
+   }
+
+   // Prefix sums of small values compared with a serial loop
+   for(s=0;s<3;s++)
+   {
+      n = NmbTab[s];
+
+      for(i=0;i<=(size_t)n;i++)
+         tab[i] = ref[i] = (itg)(i % 5);
+
+      for(i=1;i<=(size_t)n;i++)
+         ref[i] += ref[ i-1 ];
+
+      if( !ParallelPrefixSum(ParIdx, n, tab)
+      ||  memcmp(tab, ref, (n + 1) * sizeof(itg)) )
+      {
+         printf("prefix sum of %d items failed\n", (int)n);
+         bad++;
+      }
+   }
+
+   // Calls from within a loop are refused instead of deadlocking
+   if( !(TmpTyp = NewType(ParIdx, 1000))
+   ||  (LaunchParallel(ParIdx, TmpTyp, 0, RejPrc, NULL) < 0) || (NmbRej != 1) )
+   {
+      bad++;
+   }
+
+   StopParallel(ParIdx);
+   free(src);
+   free(dst);
+   free(tab);
+   free(ref);
+   free(IdxTab);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
@@ -0,0 +1,252 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                      LPLIB MESH NEIGHBOURS CHECK                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       build the neighbours of a shuffled Kuhn tet mesh, of  */
+/*                      the hexes of its cubes and of its boundary triangles  */
+/*                      and check their faces' counts and their symmetry      */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lplib3.h"
+#include "lplib3_helpers.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbCub 12
+#define NmbVer ((NmbCub + 1) * (NmbCub + 1) * (NmbCub + 1))
+#define NmbTet (6 * NmbCub * NmbCub * NmbCub)
+#define NmbHex (NmbCub * NmbCub * NmbCub)
+#define NmbTri (12 * NmbCub * NmbCub)
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg      TetVer[ NmbTet + 1 ][4], HexVer[ NmbHex + 1 ][8];
+static itg      TriVer[ NmbTri + 1 ][3], Old2New[ NmbVer + 1 ], VerCrd[ NmbVer + 1 ][3];
+static itg      NgbTab[ (NmbTet + 1) * 6 ];
+static uint64_t RndSed = 1;
+
+// Local vertices of each kind's faces, as documented by the helpers
+static int TetFac[4][4] = { {1,2,3,-1}, {2,0,3,-1}, {3,0,1,-1}, {0,2,1,-1} };
+static int TriFac[3][4] = { {1,2,-1,-1}, {2,0,-1,-1}, {0,1,-1,-1} };
+static int HexFac[6][4] = { {0,3,2,1}, {4,5,6,7}, {0,1,5,4},
+                            {1,2,6,5}, {2,3,7,6}, {3,0,4,7} };
+
+
+/*----------------------------------------------------------------------------*/
+/* Reproducible pseudo random generator                                       */
+/*----------------------------------------------------------------------------*/
+
+static itg RndInt(itg siz)
+{
+   RndSed = RndSed * 6364136223846793005ULL + 1442695040888963407ULL;
+   return((itg)((RndSed >> 33) % siz));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a Kuhn tet mesh of NmbCub^3 cubes with randomly numbered vertices,   */
+/* the hexes of its cubes and its boundary triangles                          */
+/*----------------------------------------------------------------------------*/
+
+static int BldMsh()
+{
+   int i, j, k, l, d, a, CubVer[8], TriIdx = 0, TetIdx = 0, HexIdx = 0, n = NmbCub;
+   itg idx, tmp, *fac[3];
+   int KuhTet[6][4] = {  {0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                         {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+
+   for(i=1;i<=NmbVer;i++)
+      Old2New[i] = i;
+
+   for(i=NmbVer;i>1;i--)
+   {
+      idx = 1 + RndInt(i);
+      tmp = Old2New[i];
+      Old2New[i] = Old2New[ idx ];
+      Old2New[ idx ] = tmp;
+   }
+
+   for(k=0;k<=n;k++)
+      for(j=0;j<=n;j++)
+         for(i=0;i<=n;i++)
+         {
+            idx = Old2New[ 1 + i + (n+1) * (j + (n+1) * k) ];
+            VerCrd[ idx ][0] = i;
+            VerCrd[ idx ][1] = j;
+            VerCrd[ idx ][2] = k;
+         }
+
+   for(k=0;k<n;k++)
+      for(j=0;j<n;j++)
+         for(i=0;i<n;i++)
+         {
+            for(l=0;l<8;l++)
+               CubVer[l] = 1 + (i + ((l & 1) ^ ((l >> 1) & 1)))
+                         + (n+1) * (j + ((l >> 1) & 1))
+                         + (n+1) * (n+1) * (k + ((l >> 2) & 1));
+
+            HexIdx++;
+
+            for(l=0;l<8;l++)
+               HexVer[ HexIdx ][l] = Old2New[ CubVer[l] ];
+
+            for(l=0;l<6;l++)
+            {
+               TetIdx++;
+
+               for(d=0;d<4;d++)
+                  TetVer[ TetIdx ][d] = Old2New[ CubVer[ KuhTet[l][d] ] ];
+
+               // Faces whose vertices all lie on a side of the box
+               for(d=0;d<4;d++)
+               {
+                  fac[0] = VerCrd[ TetVer[ TetIdx ][ TetFac[d][0] ] ];
+                  fac[1] = VerCrd[ TetVer[ TetIdx ][ TetFac[d][1] ] ];
+                  fac[2] = VerCrd[ TetVer[ TetIdx ][ TetFac[d][2] ] ];
+
+                  for(a=0;a<3;a++)
+                     if( (fac[0][a] == fac[1][a]) && (fac[0][a] == fac[2][a])
+                     &&  (!fac[0][a] || (fac[0][a] == n)) )
+                     {
+                        TriIdx++;
+                        TriVer[ TriIdx ][0] = TetVer[ TetIdx ][ TetFac[d][0] ];
+                        TriVer[ TriIdx ][1] = TetVer[ TetIdx ][ TetFac[d][1] ];
+                        TriVer[ TriIdx ][2] = TetVer[ TetIdx ][ TetFac[d][2] ];
+                     }
+               }
+            }
+         }
+
+   return(TriIdx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check that each neighbour links back through a face with the same          */
+/* vertices and count the boundary faces                                      */
+/*----------------------------------------------------------------------------*/
+
+static int ChkNgb( itg NmbEle, int EleSiz, int NmbFac, int (*FacTab)[4],
+                   itg *EleTab, itg *NmbBnd )
+{
+   int i, j, f, g, NmbFacVer, hit;
+   itg e, ngb, *ele, *oth;
+
+   *NmbBnd = 0;
+
+   for(e=1;e<=NmbEle;e++)
+   {
+      ele = &EleTab[ e * EleSiz ];
+
+      for(f=0;f<NmbFac;f++)
+      {
+         if(!(ngb = NgbTab[ e * NmbFac + f ]))
+         {
+            (*NmbBnd)++;
+            continue;
+         }
+
+         if( (ngb < 1) || (ngb > NmbEle) || (ngb == e) )
+            return(1);
+
+         oth = &EleTab[ ngb * EleSiz ];
+         NmbFacVer = (FacTab[f][3] < 0) ? ((FacTab[f][2] < 0) ? 2 : 3) : 4;
+
+         // The neighbour's face leading back must hold the same vertices
+         for(g=0;g<NmbFac;g++)
+            if(NgbTab[ ngb * NmbFac + g ] == e)
+               break;
+
+         if(g == NmbFac)
+            return(1);
+
+         for(i=0;i<NmbFacVer;i++)
+         {
+            for(j=hit=0;j<NmbFacVer;j++)
+               if(ele[ FacTab[f][i] ] == oth[ FacTab[g][j] ])
+                  hit = 1;
+
+            if(!hit)
+               return(1);
+         }
+      }
+   }
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build the neighbours of each kind and check the number of unique and       */
+/* boundary faces: a closed surface has none of the latter                    */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int bad = 0, n = NmbCub;
+   itg NmbBnd;
+   int64_t ParIdx;
+
+   if(BldMsh() != NmbTri)
+      return(1);
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   if( (ParallelBuildNeighbours(ParIdx, LplTet, NmbTet, &TetVer[0][0], NgbTab)
+         != 12 * n * n * n + 6 * n * n)
+   ||  ChkNgb(NmbTet, 4, 4, TetFac, &TetVer[0][0], &NmbBnd)
+   ||  (NmbBnd != 12 * n * n) )
+   {
+      printf("tets' neighbours failed\n");
+      bad++;
+   }
+
+   memset(NgbTab, 0, sizeof(NgbTab));
+
+   if( (ParallelBuildNeighbours(ParIdx, LplHex, NmbHex, &HexVer[0][0], NgbTab)
+         != 3 * n * n * (n + 1))
+   ||  ChkNgb(NmbHex, 8, 6, HexFac, &HexVer[0][0], &NmbBnd)
+   ||  (NmbBnd != 6 * n * n) )
+   {
+      printf("hexes' neighbours failed\n");
+      bad++;
+   }
+
+   memset(NgbTab, 0, sizeof(NgbTab));
+
+   if( (ParallelBuildNeighbours(ParIdx, LplTri, NmbTri, &TriVer[0][0], NgbTab)
+         != 3 * NmbTri / 2)
+   ||  ChkNgb(NmbTri, 3, 3, TriFac, &TriVer[0][0], &NmbBnd)
+   ||  NmbBnd )
+   {
+      printf("triangles' neighbours failed\n");
+      bad++;
+   }
+
+   StopParallel(ParIdx);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                         LPLIB PIPELINES CHECK                              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       launch graphs of pipes depending on earlier ones and  */
+/*                      check that each runs once, after all its dependencies */
+/*                      and before WaitPipeline returns                       */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbPip 2000
+#define NmbRep 3
+#define MaxDep 3
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static int PipDep[ NmbPip + 1 ][ MaxDep ], PipNmbDep[ NmbPip + 1 ];
+static int PipIdx[ NmbPip + 1 ], PipRnk[ NmbPip + 1 ], PipCnt[ NmbPip + 1 ];
+static int NmbDon, OrdErr;
+
+
+/*----------------------------------------------------------------------------*/
+/* Check that the pipe's dependencies have completed and count its run        */
+/*----------------------------------------------------------------------------*/
+
+static void PipPrc(int *rnk)
+{
+   int i;
+
+   for(i=0;i<PipNmbDep[ *rnk ];i++)
+      if(!__atomic_load_n(&PipCnt[ PipDep[ *rnk ][i] ], __ATOMIC_ACQUIRE))
+         __atomic_add_fetch(&OrdErr, 1, __ATOMIC_RELAXED);
+
+   // Let the other pipes run meanwhile
+   if(!(*rnk % 16))
+      sched_yield();
+
+   __atomic_add_fetch(&PipCnt[ *rnk ], 1, __ATOMIC_RELEASE);
+   __atomic_add_fetch(&NmbDon, 1, __ATOMIC_RELAXED);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Each pipe depends on up to three earlier ones, some on none                */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, j, r, bad = 0, DepTab[ MaxDep ];
+   int64_t ParIdx;
+
+   for(i=1;i<=NmbPip;i++)
+   {
+      PipRnk[i] = i;
+
+      if((i > 1) && (i % 50))
+      {
+         PipDep[i][ PipNmbDep[i]++ ] = i - 1;
+
+         if(i > 8)
+            PipDep[i][ PipNmbDep[i]++ ] = i / 2;
+
+         if(i > 20)
+            PipDep[i][ PipNmbDep[i]++ ] = i - 20;
+      }
+   }
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   for(r=1;r<=NmbRep;r++)
+   {
+      NmbDon = 0;
+
+      for(i=1;i<=NmbPip;i++)
+         PipCnt[i] = 0;
+
+      for(i=1;i<=NmbPip;i++)
+      {
+         for(j=0;j<PipNmbDep[i];j++)
+            DepTab[j] = PipIdx[ PipDep[i][j] ];
+
+         if(!(PipIdx[i] = LaunchPipeline(ParIdx, PipPrc, &PipRnk[i], PipNmbDep[i], DepTab)))
+            bad++;
+      }
+
+      WaitPipeline(ParIdx);
+
+      if(__atomic_load_n(&NmbDon, __ATOMIC_ACQUIRE) != NmbPip)
+         bad++;
+
+      for(i=1;i<=NmbPip;i++)
+         if(PipCnt[i] != 1)
+         {
+            bad++;
+            break;
+         }
+   }
+
+   StopParallel(ParIdx);
+
+   printf("%d errors, %d pipes ran before their dependencies\n", bad, OrdErr);
+
+   return((bad || OrdErr) ? 1 : 0);
+}
@@ -0,0 +1,171 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          LPLIB MEMORY POOL CHECK                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       build, resize and free types and run deterministic    */
+/*                      dependency loops with an allocator whose blocks are   */
+/*                      only aligned on 8 bytes and check the pool's headers  */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libmemblocks1.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbEdg 100000
+#define BigSiz (1 << 21)
+#define NmbRep 20
+#define CanVal 0x5a5a5a5a5a5a5a5aULL
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg EdgVer[ NmbEdg + 1 ][2];
+static int VerCnt[ NmbEdg + 2 ];
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a block 8 bytes before a cache line: the real block's address     */
+/* and a canary that the pool's header must not overwrite lie just before it  */
+/*----------------------------------------------------------------------------*/
+
+void *LmbAlcPag(LmbSct *lmb, int64_t siz, int flg, int ClrFlg)
+{
+   char *adr, *ptr;
+
+   (void)(flg);
+
+   if(!(adr = malloc(siz + 160)))
+      return(NULL);
+
+   ptr = (char *)(((uintptr_t)adr + 32 + 63) & ~(uintptr_t)63) + 56;
+   ((void **)ptr)[-2] = adr;
+   ((uint64_t *)ptr)[-1] = CanVal;
+
+   if(ClrFlg == LMB_ALLOC_AND_CLEAR)
+      memset(ptr, 0, siz);
+
+   __atomic_add_fetch(&lmb->NmbAlc, 1, __ATOMIC_SEQ_CST);
+
+   return(ptr);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check the block's canary and release it                                    */
+/*----------------------------------------------------------------------------*/
+
+void LmbRlsPag(LmbSct *lmb, void *ptr)
+{
+   if(!ptr)
+      return;
+
+   if(((uint64_t *)ptr)[-1] != CanVal)
+      __atomic_add_fetch(&lmb->NmbBad, 1, __ATOMIC_SEQ_CST);
+
+   __atomic_add_fetch(&lmb->NmbRls, 1, __ATOMIC_SEQ_CST);
+   free(((void **)ptr)[-2]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Count each vertex's visits through the edges                               */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg BegIdx, itg EndIdx, int PthIdx, int *tab)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      tab[ EdgVer[i][0] ]++;
+      tab[ EdgVer[i][1] ]++;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate the pool's small and large classes and a deterministic launch's   */
+/* graph from the misaligned blocks, then check the results and the canaries  */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, r, EdgTyp, VerTyp, BigTyp, bad = 0;
+   int64_t ParIdx;
+   float sta[2];
+   LmbSct lmb;
+
+   memset(&lmb, 0, sizeof(LmbSct));
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[i][0] = i;
+      EdgVer[i][1] = i + 1;
+   }
+
+   if(!(ParIdx = InitParallelAttr(4, 1 << 20, &lmb)))
+      return(1);
+
+   SetExtendedAttributes(ParIdx, DeterministicScheduling);
+
+   for(r=1;r<=NmbRep;r++)
+   {
+      if( !(EdgTyp = NewType(ParIdx, NmbEdg / 2))
+      ||  !(VerTyp = NewType(ParIdx, NmbEdg + 1))
+      ||  !(BigTyp = NewType(ParIdx, BigSiz))
+      ||  !ResizeType(ParIdx, EdgTyp, NmbEdg) )
+      {
+         bad++;
+         break;
+      }
+
+      if(!BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta)
+      ||  (LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, VerCnt) < 0) )
+      {
+         bad++;
+      }
+
+      for(i=2;i<=NmbEdg;i++)
+         if(VerCnt[i] != 2 * r)
+         {
+            bad++;
+            break;
+         }
+
+      FreeType(ParIdx, BigTyp);
+      FreeType(ParIdx, VerTyp);
+      FreeType(ParIdx, EdgTyp);
+   }
+
+   StopParallel(ParIdx);
+
+   if(lmb.NmbRls != lmb.NmbAlc)
+      bad++;
+
+   printf("%d errors, %d overwritten canaries out of %d blocks\n",
+            bad, (int)lmb.NmbBad, (int)lmb.NmbAlc);
+
+   return((bad || lmb.NmbBad) ? 1 : 0);
+}
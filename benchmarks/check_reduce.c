@@ -0,0 +1,231 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              LPLIB ASYNCHRONOUS LAUNCHES AND REDUCTIONS CHECK              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       run reductions and multiple arguments launches, then  */
+/*                      resize and free types, while asynchronous ones that   */
+/*                      the master joins are pending                          */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 14 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbEdg 100000
+#define NmbAsy 4
+#define NmbRep 50
+#define VecSiz 16
+#define NewSiz 4000000
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg EdgVer[ NmbEdg + 1 ][2];
+static int VerCnt[ NmbEdg + 2 ], EdgCnt[ NmbEdg + 1 ];
+static itg PthCnt[ MaxPth + 1 ];
+
+
+/*----------------------------------------------------------------------------*/
+/* Asynchronous loop: count each vertex's visits through the edges            */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg BegIdx, itg EndIdx, int PthIdx, int *tab)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      tab[ EdgVer[i][0] ]++;
+      tab[ EdgVer[i][1] ]++;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Multiple arguments loop: count the edge and its vertices' visits           */
+/*----------------------------------------------------------------------------*/
+
+static void MulPrc(itg BegIdx, itg EndIdx, int PthIdx, int *EdgTab, int *VerTab)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      EdgTab[i]++;
+      VerTab[ EdgVer[i][0] ]++;
+      VerTab[ EdgVer[i][1] ]++;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Count the lines each thread visits                                         */
+/*----------------------------------------------------------------------------*/
+
+static void CntPrc(itg BegIdx, itg EndIdx, int PthIdx, itg *tab)
+{
+   tab[ PthIdx ] += EndIdx - BegIdx + 1;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Reduction loops: the sum of the indices and a vector of their residues     */
+/*----------------------------------------------------------------------------*/
+
+static void SumPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg, double *sum)
+{
+   itg i;
+
+   (void)(PthIdx);
+   (void)(arg);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      *sum += i;
+}
+
+static void VecPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg, double *vec)
+{
+   itg i;
+
+   (void)(PthIdx);
+   (void)(arg);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      vec[ i % VecSiz ] += 1.;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Queue some asynchronous launches, reduce or launch with multiple           */
+/* arguments right away and check all the results                             */
+/* Then resize and free the type of a pending launch, which must first run    */
+/* over the type's former size                                                */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, r, EdgTyp, VerTyp, TmpTyp, bad = 0;
+   int64_t ParIdx, hdl = 0;
+   float sta[2];
+   double sum, vec[ VecSiz ];
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[i][0] = i;
+      EdgVer[i][1] = i + 1;
+   }
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   // Only the lock-free scheduler lets the master join
+   SetExtendedAttributes(ParIdx, LockFreeScheduling);
+   EdgTyp = NewType(ParIdx, NmbEdg);
+   VerTyp = NewType(ParIdx, NmbEdg + 1);
+
+   if(!BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta))
+      return(1);
+
+   for(r=1;r<=NmbRep;r++)
+   {
+      for(i=0;i<NmbAsy;i++)
+         hdl = LaunchParallelAsync(ParIdx, EdgTyp, VerTyp, EdgPrc, VerCnt, 1);
+
+      // Alternate the scratch sizes so that they get reallocated
+      if(r & 1)
+      {
+         if( (LaunchParallelReduce(ParIdx, EdgTyp, 0, SumPrc, NULL,
+               ReduceSumDouble, sizeof(double), NULL, &sum) < 0)
+         ||  (sum != (double)NmbEdg * (NmbEdg + 1) / 2) )
+         {
+            bad++;
+         }
+      }
+      else
+      {
+         if(LaunchParallelReduce(ParIdx, EdgTyp, VerTyp, VecPrc, NULL,
+               ReduceSumDouble, VecSiz * sizeof(double), NULL, vec) < 0)
+         {
+            bad++;
+         }
+
+         for(i=0;i<VecSiz;i++)
+            if(vec[i] != (double)((NmbEdg - i) / VecSiz + (i > 0)))
+               bad++;
+      }
+
+      // The reductions waited for all the asynchronous launches
+      if(!hdl || !TestParallel(ParIdx, hdl))
+         bad++;
+
+      // So do the launches with multiple arguments, that the pending WP
+      // must not be given
+      for(i=0;i<NmbAsy;i++)
+         LaunchParallelAsync(ParIdx, EdgTyp, VerTyp, EdgPrc, VerCnt, 1);
+
+      if(LaunchParallelMultiArg(ParIdx, EdgTyp, VerTyp, MulPrc, 2, EdgCnt, VerCnt) < 0)
+         bad++;
+
+      for(i=1;i<=NmbEdg;i++)
+         if(EdgCnt[i] != r)
+         {
+            bad++;
+            break;
+         }
+
+      for(i=2;i<=NmbEdg;i++)
+         if(VerCnt[i] != 2 * (2 * NmbAsy + 1) * r)
+         {
+            bad++;
+            break;
+         }
+   }
+
+   for(r=1;r<=NmbRep;r++)
+   {
+      for(i=0;i<=MaxPth;i++)
+         PthCnt[i] = 0;
+
+      TmpTyp = NewType(ParIdx, NmbEdg);
+      hdl = LaunchParallelAsync(ParIdx, TmpTyp, 0, CntPrc, PthCnt, 1);
+
+      if(!hdl || !ResizeType(ParIdx, TmpTyp, NewSiz) || !TestParallel(ParIdx, hdl))
+         bad++;
+
+      FreeType(ParIdx, TmpTyp);
+      WaitParallel(ParIdx, hdl);
+
+      for(i=1;i<=MaxPth;i++)
+         PthCnt[0] += PthCnt[i];
+
+      if(PthCnt[0] != NmbEdg)
+         bad++;
+   }
+
+   StopParallel(ParIdx);
+   printf("%d errors in %d rounds\n", bad, NmbRep);
+
+   return(bad ? 1 : 0);
+}
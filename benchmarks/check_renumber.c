@@ -0,0 +1,236 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                       LPLIB MESH RENUMBERING CHECK                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       renumber a shuffled tet mesh with RenumberMesh and    */
+/*                      check that the vertices and elements were permuted    */
+/*                      along with their coordinates, references and vertices */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbCub 30
+#define NmbVer ((NmbCub + 1) * (NmbCub + 1) * (NmbCub + 1))
+#define NmbTet (6 * NmbCub * NmbCub * NmbCub)
+#define NmbEdg (NmbCub * (NmbCub + 1) * (NmbCub + 1))
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static double   crd[ NmbVer + 1 ][3], OldCrd[ NmbVer + 1 ][3];
+static itg      VerRef[ NmbVer + 1 ], Old2New[ NmbVer + 1 ], VisTab[ NmbVer + 1 ];
+static itg      TetVer[ NmbTet + 1 ][4], OldTet[ NmbTet + 1 ][4], TetRef[ NmbTet + 1 ];
+static itg      EdgVer[ NmbEdg + 1 ][2], OldEdg[ NmbEdg + 1 ][2];
+static uint64_t RndSed = 1;
+
+
+/*----------------------------------------------------------------------------*/
+/* Reproducible pseudo random generator                                       */
+/*----------------------------------------------------------------------------*/
+
+static itg RndInt(itg siz)
+{
+   RndSed = RndSed * 6364136223846793005ULL + 1442695040888963407ULL;
+   return((itg)((RndSed >> 33) % siz));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a Kuhn tet mesh of NmbCub^3 cubes and the grid's edges along x,      */
+/* with randomly numbered vertices                                            */
+/*----------------------------------------------------------------------------*/
+
+static void BldMsh()
+{
+   int i, j, k, l, CubVer[8];
+   itg idx, tmp, TetIdx = 0, EdgIdx = 0, n = NmbCub;
+   int KuhTet[6][4] = {  {0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                         {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+
+   for(i=1;i<=NmbVer;i++)
+      Old2New[i] = i;
+
+   for(i=NmbVer;i>1;i--)
+   {
+      idx = 1 + RndInt(i);
+      tmp = Old2New[i];
+      Old2New[i] = Old2New[ idx ];
+      Old2New[ idx ] = tmp;
+   }
+
+   for(k=0;k<=n;k++)
+      for(j=0;j<=n;j++)
+         for(i=0;i<=n;i++)
+         {
+            idx = Old2New[ 1 + i + (n+1) * (j + (n+1) * k) ];
+            crd[ idx ][0] = i;
+            crd[ idx ][1] = j;
+            crd[ idx ][2] = k;
+            VerRef[ idx ] = 1 + i + (n+1) * (j + (n+1) * k);
+
+            if(i < n)
+            {
+               EdgIdx++;
+               EdgVer[ EdgIdx ][0] = idx;
+               EdgVer[ EdgIdx ][1] = Old2New[ 2 + i + (n+1) * (j + (n+1) * k) ];
+            }
+         }
+
+   for(k=0;k<n;k++)
+      for(j=0;j<n;j++)
+         for(i=0;i<n;i++)
+         {
+            for(l=0;l<8;l++)
+               CubVer[l] = 1 + (i + ((l & 1) ^ ((l >> 1) & 1)))
+                         + (n+1) * (j + ((l >> 1) & 1))
+                         + (n+1) * (n+1) * (k + ((l >> 2) & 1));
+
+            for(l=0;l<6;l++)
+            {
+               TetIdx++;
+               TetVer[ TetIdx ][0] = Old2New[ CubVer[ KuhTet[l][0] ] ];
+               TetVer[ TetIdx ][1] = Old2New[ CubVer[ KuhTet[l][1] ] ];
+               TetVer[ TetIdx ][2] = Old2New[ CubVer[ KuhTet[l][2] ] ];
+               TetVer[ TetIdx ][3] = Old2New[ CubVer[ KuhTet[l][3] ] ];
+               TetRef[ TetIdx ] = TetIdx;
+            }
+         }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sum the index gaps between the tets' vertices                              */
+/*----------------------------------------------------------------------------*/
+
+static double GetGap()
+{
+   itg i;
+   double gap = 0.;
+
+   for(i=1;i<=NmbTet;i++)
+      gap += labs((long)TetVer[i][0] - (long)TetVer[i][3]);
+
+   return(gap / NmbTet);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Renumber the mesh and check each table against its copy                    */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int j, bad = 0, EleSiz[2] = {4, 2};
+   itg i, k, NmbEle[2] = {NmbTet, NmbEdg};
+   itg *EleTab[2] = {&TetVer[0][0], &EdgVer[0][0]}, *EleRef[2] = {TetRef, NULL};
+   int64_t ParIdx;
+   double OldGap;
+
+   BldMsh();
+   memcpy(OldCrd, crd, sizeof(crd));
+   memcpy(OldTet, TetVer, sizeof(TetVer));
+   memcpy(OldEdg, EdgVer, sizeof(EdgVer));
+   OldGap = GetGap();
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   // Invalid arguments must be refused
+   if(RenumberMesh(ParIdx, 3, 0, &crd[0][0], VerRef, 0, NULL, NULL, NULL, NULL, NULL))
+      bad++;
+
+   if(!RenumberMesh( ParIdx, 3, NmbVer, &crd[0][0], VerRef, 2, NmbEle, EleSiz,
+                     EleTab, EleRef, Old2New ))
+   {
+      bad++;
+   }
+
+   StopParallel(ParIdx);
+
+   // Old2New must be a permutation moving the coordinates and references
+   for(i=1;i<=NmbVer;i++)
+   {
+      k = Old2New[i];
+
+      if( (k < 1) || (k > NmbVer) || VisTab[k]++
+      ||  memcmp(crd[k], OldCrd[i], 3 * sizeof(double))
+      ||  (VerRef[k] != 1 + (itg)OldCrd[i][0] + (NmbCub + 1)
+                      * ((itg)OldCrd[i][1] + (NmbCub + 1) * (itg)OldCrd[i][2])) )
+      {
+         bad++;
+         break;
+      }
+   }
+
+   // The tets' references give their old index, hence their old vertices,
+   // whose first one is cleared to catch references given twice
+   for(i=1;i<=NmbTet;i++)
+   {
+      k = TetRef[i];
+
+      if( (k < 1) || (k > NmbTet) || !OldTet[k][0] )
+      {
+         bad++;
+         break;
+      }
+
+      for(j=0;j<4;j++)
+         if(TetVer[i][j] != Old2New[ OldTet[k][j] ])
+            bad++;
+
+      OldTet[k][0] = 0;
+   }
+
+   for(i=1;i<=NmbTet;i++)
+      if(OldTet[i][0])
+      {
+         bad++;
+         break;
+      }
+
+   // Each renumbered edge must be found once among the old ones
+   memset(VisTab, 0, sizeof(VisTab));
+
+   for(i=1;i<=NmbEdg;i++)
+      VisTab[ Old2New[ OldEdg[i][0] ] ] = Old2New[ OldEdg[i][1] ];
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      if(VisTab[ EdgVer[i][0] ] != EdgVer[i][1])
+      {
+         bad++;
+         break;
+      }
+
+      VisTab[ EdgVer[i][0] ] = 0;
+   }
+
+   // The SFC order must bring the tets' vertices closer together
+   if(GetGap() * 4. > OldGap)
+      bad++;
+
+   printf("%d errors, tets' vertex gap from %g to %g\n", bad, OldGap, GetGap());
+
+   return(bad ? 1 : 0);
+}
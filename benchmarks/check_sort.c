@@ -0,0 +1,135 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                        LPLIB PARALLEL SORTS CHECK                          */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       sort tables with many equal keys through the parallel */
+/*                      qsort and radix sort and compare them with a serial   */
+/*                      qsort, small tables included                          */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define MaxSiz 1000003
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static uint64_t SrtTab[ MaxSiz ][2], RefTab[ MaxSiz ][2];
+static char     VisTab[ MaxSiz ];
+
+
+/*----------------------------------------------------------------------------*/
+/* Compare the keys only, or the keys then the values                         */
+/*----------------------------------------------------------------------------*/
+
+static int CmpKey(const void *a, const void *b)
+{
+   uint64_t *pa = (uint64_t *)a, *pb = (uint64_t *)b;
+
+   return((pa[0] > pb[0]) - (pa[0] < pb[0]));
+}
+
+static int CmpPai(const void *a, const void *b)
+{
+   uint64_t *pa = (uint64_t *)a, *pb = (uint64_t *)b;
+
+   if(pa[0] != pb[0])
+      return((pa[0] > pb[0]) - (pa[0] < pb[0]));
+
+   return((pa[1] > pb[1]) - (pa[1] < pb[1]));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Fill a table with 64-bit keys, a third of them taken among a few values,   */
+/* and their original positions as values                                     */
+/*----------------------------------------------------------------------------*/
+
+static void SetTab(size_t nel)
+{
+   size_t i;
+   uint64_t key = 88172645463325252ULL;
+
+   for(i=0;i<nel;i++)
+   {
+      key ^= key << 13;
+      key ^= key >> 7;
+      key ^= key << 17;
+      SrtTab[i][0] = (i % 3) ? key : key % 100;
+      SrtTab[i][1] = i;
+   }
+
+   memcpy(RefTab, SrtTab, nel * 2 * sizeof(uint64_t));
+   qsort(RefTab, nel, 2 * sizeof(uint64_t), CmpPai);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort tables below and above the parallel threshold with both procedures    */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int s, bad = 0;
+   size_t i, SizTab[6] = {0, 1, 2, 1000, 200001, MaxSiz};
+   int64_t ParIdx;
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   for(s=0;s<6;s++)
+   {
+      // The radix sort is stable: equal keys keep their positions' order
+      SetTab(SizTab[s]);
+
+      if(!ParallelRadixSort(ParIdx, SrtTab, SizTab[s])
+      ||  memcmp(SrtTab, RefTab, SizTab[s] * 2 * sizeof(uint64_t)) )
+      {
+         printf("radix sort of %zu pairs failed\n", SizTab[s]);
+         bad++;
+      }
+
+      // The qsort is not: the keys must be sorted and the values permuted
+      SetTab(SizTab[s]);
+      ParallelQsort(ParIdx, SrtTab, SizTab[s], 2 * sizeof(uint64_t), CmpKey);
+      memset(VisTab, 0, SizTab[s]);
+
+      for(i=0;i<SizTab[s];i++)
+      {
+         if( (SrtTab[i][0] != RefTab[i][0]) || (SrtTab[i][1] >= SizTab[s])
+         ||  VisTab[ SrtTab[i][1] ]++ )
+         {
+            printf("qsort of %zu pairs failed at %zu\n", SizTab[s], i);
+            bad++;
+            break;
+         }
+      }
+   }
+
+   StopParallel(ParIdx);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
@@ -0,0 +1,180 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    LPLIB SPARSE DEPENDENCIES CHECK                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       build the dependencies of scattered edges as dense,   */
+/*                      sparse and automatic ones, with coarse and fine       */
+/*                      blocks, and check that no conflicting WP run together */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbEdg 20000
+#define NmbVer 10000
+#define NmbRep 10
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg EdgVer[ NmbEdg + 1 ][2];
+static int VerOwn[ NmbVer + 1 ], VerCnt[ NmbVer + 1 ], ExpCnt[ NmbVer + 1 ];
+static int NmbCfl;
+
+
+/*----------------------------------------------------------------------------*/
+/* Tag a vertex with the WP that writes it and count the conflicts            */
+/*----------------------------------------------------------------------------*/
+
+static void TagVer(itg VerIdx, int tag)
+{
+   int old = 0;
+
+   if( !__atomic_compare_exchange_n(&VerOwn[ VerIdx ], &old, tag, 0,
+         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) && (old != tag) )
+   {
+      __atomic_fetch_add(&NmbCfl, 1, __ATOMIC_RELAXED);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Tag and count the edges' vertices, then release them                       */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg BegIdx, itg EndIdx, int PthIdx, int *tab)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      TagVer(EdgVer[i][0], BegIdx);
+      TagVer(EdgVer[i][1], BegIdx);
+      tab[ EdgVer[i][0] ]++;
+      tab[ EdgVer[i][1] ]++;
+   }
+
+   // Let the other threads run so that conflicting WP would overlap
+   sched_yield();
+
+   for(i=BegIdx;i<=EndIdx;i++)
+   {
+      __atomic_store_n(&VerOwn[ EdgVer[i][0] ], 0, __ATOMIC_RELEASE);
+      __atomic_store_n(&VerOwn[ EdgVer[i][1] ], 0, __ATOMIC_RELEASE);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build the dependencies one by one or in parallel with each storage mode    */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, r, m, b, EdgTyp, VerTyp, bad = 0;
+   int DepMod[3] = {DenseDependencies, SparseDependencies, AutomaticDependencies};
+   int64_t ParIdx;
+   float sta[2];
+
+   // Edges link vertices far apart so that each WP spans many words
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[i][0] = (itg)(((int64_t)i * 7919) % NmbVer) + 1;
+      EdgVer[i][1] = (itg)(((int64_t)i * 104729 + 17) % NmbVer) + 1;
+      ExpCnt[ EdgVer[i][0] ] += NmbRep;
+      ExpCnt[ EdgVer[i][1] ] += NmbRep;
+   }
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   // Default blocks, then many small WP against many dependency blocks,
+   // which lets the automatic mode choose the sparse lists
+   for(b=0;b<2;b++)
+   {
+      SetExtendedAttributes(ParIdx, SetSmallBlock, b ? 1000 : 64);
+      SetExtendedAttributes(ParIdx, SetDependencyBlock, b ? 1024 : 256);
+
+      for(m=0;m<3;m++)
+      {
+         SetExtendedAttributes(ParIdx, DepMod[m]);
+
+         if( !(EdgTyp = NewType(ParIdx, NmbEdg))
+         ||  !(VerTyp = NewType(ParIdx, NmbVer)) )
+         {
+            return(1);
+         }
+
+         // Each mode is built by the sequential calls with one block size
+         // and in parallel with the other
+         if((m + b) & 1)
+         {
+            if(!BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta))
+               bad++;
+         }
+         else
+         {
+            BeginDependency(ParIdx, EdgTyp, VerTyp);
+
+            for(i=1;i<=NmbEdg;i++)
+            {
+               AddDependency(ParIdx, i, EdgVer[i][0]);
+               AddDependency(ParIdx, i, EdgVer[i][1]);
+            }
+
+            if(!EndDependency(ParIdx, sta))
+               bad++;
+         }
+
+         for(i=1;i<=NmbVer;i++)
+            VerCnt[i] = 0;
+
+         NmbCfl = 0;
+
+         for(r=1;r<=NmbRep;r++)
+            if(LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, VerCnt) < 0)
+               bad++;
+
+         if(NmbCfl)
+            bad++;
+
+         for(i=1;i<=NmbVer;i++)
+            if(VerCnt[i] != ExpCnt[i])
+            {
+               bad++;
+               break;
+            }
+
+         FreeType(ParIdx, VerTyp);
+         FreeType(ParIdx, EdgTyp);
+      }
+   }
+
+   StopParallel(ParIdx);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
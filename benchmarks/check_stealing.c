@@ -0,0 +1,110 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                       LPLIB WORK STEALING CHECK                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       slow down a thread during loops without dependencies  */
+/*                      and check that every line is run once and that the    */
+/*                      other threads steal its chunks                        */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbLin 1000000
+#define NmbRep 5
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static char LinCnt[ NmbLin + 1 ];
+static int  SlwFlg;
+
+
+/*----------------------------------------------------------------------------*/
+/* Count each line's visits, the first thread sleeps in its first chunk       */
+/*----------------------------------------------------------------------------*/
+
+static void LinPrc(itg BegIdx, itg EndIdx, int PthIdx, char *tab)
+{
+   itg i;
+
+   if(!PthIdx && __atomic_exchange_n(&SlwFlg, 0, __ATOMIC_SEQ_CST))
+      usleep(100000);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      tab[i]++;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the loops and compare the threads' statistics with the lines' counts   */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, r, LinTyp, NmbStl, bad = 0, StlTab[ MaxPth ];
+   itg LinTab[ MaxPth ], NmbDon;
+   int64_t ParIdx;
+   float imb;
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   if(!(LinTyp = NewType(ParIdx, NmbLin)))
+      return(1);
+
+   SetExtendedAttributes(ParIdx, EnableWorkStealing);
+
+   for(r=1;r<=NmbRep;r++)
+   {
+      SlwFlg = 1;
+
+      if(LaunchParallel(ParIdx, LinTyp, 0, LinPrc, LinCnt) < 0)
+         bad++;
+
+      for(i=1;i<=NmbLin;i++)
+         if(LinCnt[i] != r)
+         {
+            bad++;
+            break;
+         }
+
+      imb = GetWorkStealingStats(ParIdx, LinTab, StlTab);
+
+      for(i=0, NmbDon=0, NmbStl=0; i<4; i++)
+      {
+         NmbDon += LinTab[i];
+         NmbStl += StlTab[i];
+      }
+
+      // The sleeping thread's chunks must have been taken by the others
+      if( (NmbDon != NmbLin) || !NmbStl || (imb < 1.) )
+         bad++;
+   }
+
+   StopParallel(ParIdx);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
@@ -0,0 +1,170 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          LPLIB THREAD TEAMS CHECK                          */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       build and stop teams from a pipeline while the parent */
+/*                      runs dependency loops and check both sides' results   */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 14 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbEdg 20000
+#define NmbTem 1000
+#define TemLin 1000
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg EdgVer[ NmbEdg + 1 ][2];
+static int EdgCnt[ NmbEdg + 1 ], TemBad, TemEnd;
+static double TemTab[ TemLin + 1 ];
+
+
+/*----------------------------------------------------------------------------*/
+/* Count each edge's visits and let the other threads run once in a while     */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   itg i;
+
+   (void)(PthIdx);
+   (void)(arg);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      EdgCnt[i]++;
+
+   sched_yield();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Team loop                                                                  */
+/*----------------------------------------------------------------------------*/
+
+static void TemPrc(itg BegIdx, itg EndIdx, int PthIdx, double *tab)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      tab[i] += 1.;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Lend two threads to a new team, run a loop on it and give them back        */
+/*----------------------------------------------------------------------------*/
+
+static void TemStg(int64_t *ParIdx)
+{
+   int i, TemTyp;
+   int64_t TemIdx;
+
+   for(i=0; (i<NmbTem) && !__atomic_load_n(&TemEnd, __ATOMIC_ACQUIRE); i++)
+   {
+      if(!(TemIdx = InitTeam(*ParIdx, 2)))
+      {
+         TemBad++;
+         break;
+      }
+
+      TemTab[1] = TemTab[ TemLin ] = 0.;
+      TemTyp = NewType(TemIdx, TemLin);
+
+      if( (LaunchParallel(TemIdx, TemTyp, 0, TemPrc, TemTab) < 0)
+      ||  (TemTab[1] != 1.) || (TemTab[ TemLin ] != 1.) )
+      {
+         TemBad++;
+      }
+
+      FreeType(TemIdx, TemTyp);
+      StopParallel(TemIdx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the parent's dependency loops with the default scheduler while the     */
+/* pipeline lends and takes back its threads                                  */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, j, r, EdgTyp, VerTyp, bad = 0;
+   int64_t ParIdx, TemIdx;
+   float sta[2];
+
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[i][0] = i;
+      EdgVer[i][1] = i + 1;
+   }
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   EdgTyp = NewType(ParIdx, NmbEdg);
+   VerTyp = NewType(ParIdx, NmbEdg + 1);
+
+   if(!BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta))
+      return(1);
+
+   LaunchPipeline(ParIdx, TemStg, &ParIdx, 0, NULL);
+
+   for(r=1;r<=200;r++)
+   {
+      if(LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, NULL) < 0)
+         bad++;
+
+      for(j=1;j<=NmbEdg;j++)
+         if(EdgCnt[j] != r)
+         {
+            bad++;
+            break;
+         }
+   }
+
+   __atomic_store_n(&TemEnd, 1, __ATOMIC_RELEASE);
+   WaitPipeline(ParIdx);
+
+   // The parent must not be stopped while a team still holds some threads
+   if(!(TemIdx = InitTeam(ParIdx, 2)))
+      bad++;
+   else
+   {
+      StopParallel(ParIdx);
+
+      if(LaunchParallel(ParIdx, EdgTyp, VerTyp, EdgPrc, NULL) < 0)
+         bad++;
+
+      StopParallel(TemIdx);
+   }
+
+   StopParallel(ParIdx);
+   printf("parent errors %d, team errors %d\n", bad, TemBad);
+
+   return((bad || TemBad) ? 1 : 0);
+}
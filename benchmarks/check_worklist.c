@@ -0,0 +1,256 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          LPLIB WORK LISTS CHECK                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       check the FIFO lists' order, that edges pushed to a   */
+/*                      list never run against a conflicting batch and that   */
+/*                      a LIFO tree is processed once and shared by threads   */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sched.h>
+#include "lplib3.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbFif 100000
+#define NmbEdg 20000
+#define NmbVer 10000
+#define NmbItm 200000
+#define NmbSlw 200
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static itg     OrdTab[ 2 * NmbFif + 1 ], EdgVer[ NmbEdg + 1 ][2];
+static int     VerOwn[ NmbVer + 1 ], VerCnt[ NmbVer + 1 ], ExpCnt[ NmbVer + 1 ];
+static int     ItmCnt[ NmbItm + 1 ], PthCnt[ MaxPth ];
+static int     LstIdx, NmbOrd, NmbCfl;
+static int64_t ParIdx;
+
+
+/*----------------------------------------------------------------------------*/
+/* Record the processing order and push a second round of items              */
+/*----------------------------------------------------------------------------*/
+
+static void FifPrc(itg NmbBat, itg *BatTab, int PthIdx, void *arg)
+{
+   itg i;
+
+   (void)(arg);
+
+   for(i=0;i<NmbBat;i++)
+   {
+      OrdTab[ ++NmbOrd ] = BatTab[i];
+
+      if(BatTab[i] <= NmbFif)
+         PushWorkList(ParIdx, LstIdx, PthIdx, BatTab[i] + NmbFif);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Tag the edges' vertices with the running thread and count the conflicts    */
+/*----------------------------------------------------------------------------*/
+
+static void EdgPrc(itg NmbBat, itg *BatTab, int PthIdx, void *arg)
+{
+   int j, old;
+   itg i, v;
+
+   (void)(arg);
+
+   for(i=0;i<NmbBat;i++)
+      for(j=0;j<2;j++)
+      {
+         v = EdgVer[ BatTab[i] ][j];
+         old = 0;
+
+         if( !__atomic_compare_exchange_n(&VerOwn[v], &old, PthIdx + 1, 0,
+               __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) && (old != PthIdx + 1) )
+         {
+            __atomic_fetch_add(&NmbCfl, 1, __ATOMIC_RELAXED);
+         }
+
+         VerCnt[v]++;
+      }
+
+   // Let the other threads run so that conflicting batches would overlap
+   sched_yield();
+
+   for(i=0;i<NmbBat;i++)
+   {
+      __atomic_store_n(&VerOwn[ EdgVer[ BatTab[i] ][0] ], 0, __ATOMIC_RELEASE);
+      __atomic_store_n(&VerOwn[ EdgVer[ BatTab[i] ][1] ], 0, __ATOMIC_RELEASE);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Count each item of a binary tree and push its children, the first ones     */
+/* are slowed down so that the idle threads ask for a share                   */
+/*----------------------------------------------------------------------------*/
+
+static void TrePrc(itg NmbBat, itg *BatTab, int PthIdx, void *arg)
+{
+   itg i;
+
+   (void)(arg);
+
+   for(i=0;i<NmbBat;i++)
+   {
+      __atomic_fetch_add(&ItmCnt[ BatTab[i] ], 1, __ATOMIC_RELAXED);
+      PthCnt[ PthIdx ]++;
+
+      if(BatTab[i] <= NmbSlw)
+         usleep(100);
+
+      if(2 * BatTab[i] <= NmbItm)
+         PushWorkList(ParIdx, LstIdx, PthIdx, 2 * BatTab[i]);
+
+      if(2 * BatTab[i] + 1 <= NmbItm)
+         PushWorkList(ParIdx, LstIdx, PthIdx, 2 * BatTab[i] + 1);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the three scenarios                                                    */
+/*----------------------------------------------------------------------------*/
+
+int main()
+{
+   int i, m, EdgTyp, VerTyp, NmbAct, bad = 0;
+   int LstMod[2] = {FifoWorkList, LifoWorkList};
+   float sta[2];
+
+   // A single thread must process a FIFO list in push order, the items
+   // pushed during the launch coming after the initial ones
+   if(!(ParIdx = InitParallel(1)))
+      return(1);
+
+   if(!(LstIdx = NewWorkList(ParIdx, 2 * NmbFif, 7, FifoWorkList)))
+      return(1);
+
+   for(i=1;i<=NmbFif;i++)
+      PushWorkList(ParIdx, LstIdx, -1, i);
+
+   if(LaunchWorkList(ParIdx, LstIdx, 0, 0, FifPrc, NULL) != 2 * NmbFif)
+      bad++;
+
+   for(i=1;i<=2 * NmbFif;i++)
+      if(OrdTab[i] != i)
+      {
+         printf("FIFO order failed at %d\n", i);
+         bad++;
+         break;
+      }
+
+   StopParallel(ParIdx);
+
+   if(!(ParIdx = InitParallel(4)))
+      return(1);
+
+   // Edges linking far apart vertices, pushed backwards along with items
+   // beyond the type's lines, which must be dropped
+   for(i=1;i<=NmbEdg;i++)
+   {
+      EdgVer[i][0] = (itg)(((int64_t)i * 7919) % NmbVer) + 1;
+      EdgVer[i][1] = (itg)(((int64_t)i * 104729 + 17) % NmbVer) + 1;
+      ExpCnt[ EdgVer[i][0] ]++;
+      ExpCnt[ EdgVer[i][1] ]++;
+   }
+
+   if( !(EdgTyp = NewType(ParIdx, NmbEdg)) || !(VerTyp = NewType(ParIdx, NmbVer))
+   ||  !BuildDependencyParallel(ParIdx, EdgTyp, VerTyp, 2, &EdgVer[0][0], sta)
+   ||  !(LstIdx = NewWorkList(ParIdx, NmbEdg + 10, 16, FifoWorkList)) )
+   {
+      return(1);
+   }
+
+   for(i=NmbEdg + 10; i>=1; i--)
+      PushWorkList(ParIdx, LstIdx, -1, i);
+
+   if(LaunchWorkList(ParIdx, LstIdx, EdgTyp, VerTyp, EdgPrc, NULL) != NmbEdg)
+      bad++;
+
+   if(NmbCfl)
+   {
+      printf("%d conflicts between batches\n", NmbCfl);
+      bad++;
+   }
+
+   for(i=1;i<=NmbVer;i++)
+      if(VerCnt[i] != ExpCnt[i])
+      {
+         bad++;
+         break;
+      }
+
+   FreeWorkList(ParIdx, LstIdx);
+   FreeType(ParIdx, VerTyp);
+   FreeType(ParIdx, EdgTyp);
+
+   // A tree grown from its root must be processed once per item whatever
+   // the mode and by several threads
+   for(m=0;m<2;m++)
+   {
+      for(i=1;i<=NmbItm;i++)
+         ItmCnt[i] = 0;
+
+      for(i=0;i<MaxPth;i++)
+         PthCnt[i] = 0;
+
+      if(!(LstIdx = NewWorkList(ParIdx, NmbItm, 8, LstMod[m])))
+         return(1);
+
+      PushWorkList(ParIdx, LstIdx, -1, 1);
+
+      if(LaunchWorkList(ParIdx, LstIdx, 0, 0, TrePrc, NULL) != NmbItm)
+         bad++;
+
+      for(i=1;i<=NmbItm;i++)
+         if(ItmCnt[i] != 1)
+         {
+            printf("item %d processed %d times in mode %d\n", i, ItmCnt[i], m);
+            bad++;
+            break;
+         }
+
+      for(i=NmbAct=0;i<MaxPth;i++)
+         if(PthCnt[i])
+            NmbAct++;
+
+      if(NmbAct < 2)
+      {
+         printf("a single thread processed the tree in mode %d\n", m);
+         bad++;
+      }
+
+      FreeWorkList(ParIdx, LstIdx);
+   }
+
+   StopParallel(ParIdx);
+
+   printf("%d errors\n", bad);
+
+   return(bad ? 1 : 0);
+}
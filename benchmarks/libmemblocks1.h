@@ -0,0 +1,31 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     LIBMEMBLOCKS STAND-IN FOR CHECK_POOL                   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       the few libMemBlocks calls used by LPlib, implemented */
+/*                      by check_pool with blocks that start 8 bytes before   */
+/*                      a cache line and are guarded by a canary              */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 15 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _LIBMEMBLOCKS1_H
+#define _LIBMEMBLOCKS1_H
+
+#include <stdint.h>
+
+enum LmbClr {LMB_ALLOC_DONT_CLEAR, LMB_ALLOC_AND_CLEAR};
+
+typedef struct
+{
+   int64_t NmbAlc, NmbRls, NmbBad;
+}LmbSct;
+
+void *LmbAlcPag(LmbSct *, int64_t, int, int);
+void  LmbRlsPag(LmbSct *, void *);
+
+#endif
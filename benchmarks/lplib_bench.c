@@ -0,0 +1,657 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     LPLIB SELF CONTAINED BENCHMARK SUITE                   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       time the main LPlib procedures on synthetic meshes    */
+/*                      across thread counts and print a CSV report           */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 14 2026                                           */
+/*   Last modification: oct 15 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* Includes                                                                   */
+/*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+#include "lplib3.h"
+#include "lplib3_helpers.h"
+
+
+/*----------------------------------------------------------------------------*/
+/* Defines                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#define NmbBch    9
+#define NmbOvh    1000
+#define NmbPip    1000
+#define MemSiz    (256 * 1024 * 1024)
+
+enum BchTyp {  BchBig, BchDyn, BchSta, BchDet, BchCol,
+               BchHil, BchEdg, BchPip, BchMem, BchOvh };
+
+
+/*----------------------------------------------------------------------------*/
+/* Structures' prototypes                                                     */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+   char     *nam;
+   itg      NmbVer, NmbTet, (*TetVer)[4], *TetSlb;
+   int      NmbCol, NmbGrn, (*ColTab)[2], (*GrnTab)[2];
+   itg      (*ColVer)[4];
+   double   (*crd)[3], *VerVal, box[6];
+}MshSct;
+
+typedef struct
+{
+   double   tim[ NmbBch + 1 ];
+}RefSct;
+
+
+/*----------------------------------------------------------------------------*/
+/* Global variables                                                           */
+/*----------------------------------------------------------------------------*/
+
+static char *BchNam[] = {  "big", "dynamic", "static", "deterministic",
+                           "colorgrains", "hilbert", "edges", "pipeline",
+                           "memclear", "overhead" };
+
+static uint64_t RndSed = 1;
+
+
+/*----------------------------------------------------------------------------*/
+/* Reproducible pseudo random generator                                       */
+/*----------------------------------------------------------------------------*/
+
+static uint64_t RndInt()
+{
+   RndSed = RndSed * 6364136223846793005ULL + 1442695040888963407ULL;
+   return(RndSed >> 33);
+}
+
+static double RndDbl()
+{
+   return((double)RndInt() / (double)(1ULL << 31));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a structured tet mesh of n^3 cubes split in 6 tets                   */
+/* The unstructured flavor jitters the vertices and shuffles all numberings   */
+/* The slab index of each tet is kept to build colors and grains later        */
+/*----------------------------------------------------------------------------*/
+
+static int BldMsh(MshSct *msh, int n, int UnsFlg)
+{
+   int      i, j, k, l, CubVer[8];
+   itg      idx, tmp, *Old2New, NmbSlb;
+   double   h = 1. / n;
+   int      KuhTet[6][4] = { {0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                             {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+
+   msh->nam = UnsFlg ? "unstructured" : "structured";
+   msh->NmbVer = (itg)(n+1) * (n+1) * (n+1);
+   msh->NmbTet = (itg)6 * n * n * n;
+   msh->crd = malloc((msh->NmbVer+1) * 3 * sizeof(double));
+   msh->VerVal = calloc(msh->NmbVer+1, sizeof(double));
+   msh->TetVer = malloc((msh->NmbTet+1) * 4 * sizeof(itg));
+   msh->TetSlb = malloc((msh->NmbTet+1) * sizeof(itg));
+   Old2New = malloc((msh->NmbVer+1) * sizeof(itg));
+
+   if(!msh->crd || !msh->VerVal || !msh->TetVer || !msh->TetSlb || !Old2New)
+   {
+      free(Old2New);
+      return(0);
+   }
+
+   // Random vertex numbering for the unstructured flavor
+   for(i=1;i<=msh->NmbVer;i++)
+      Old2New[i] = i;
+
+   if(UnsFlg)
+      for(i=msh->NmbVer;i>1;i--)
+      {
+         idx = 1 + RndInt() % i;
+         tmp = Old2New[i];
+         Old2New[i] = Old2New[ idx ];
+         Old2New[ idx ] = tmp;
+      }
+
+   // Vertices on a regular grid, slightly moved in the unstructured case
+   for(k=0;k<=n;k++)
+      for(j=0;j<=n;j++)
+         for(i=0;i<=n;i++)
+         {
+            idx = Old2New[ 1 + i + (itg)(n+1) * (j + (itg)(n+1) * k) ];
+            msh->crd[ idx ][0] = i * h;
+            msh->crd[ idx ][1] = j * h;
+            msh->crd[ idx ][2] = k * h;
+
+            if(UnsFlg)
+               for(l=0;l<3;l++)
+                  msh->crd[ idx ][l] += (RndDbl() - .5) * .4 * h;
+         }
+
+   // Split each cube along its main diagonal
+   idx = 0;
+
+   for(k=0;k<n;k++)
+      for(j=0;j<n;j++)
+         for(i=0;i<n;i++)
+         {
+            for(l=0;l<8;l++)
+               CubVer[l] = 1 + (i + ((l & 1) ^ ((l >> 1) & 1)))
+                         + (n+1) * (j + ((l >> 1) & 1))
+                         + (n+1) * (n+1) * (k + ((l >> 2) & 1));
+
+            for(l=0;l<6;l++)
+            {
+               idx++;
+               msh->TetVer[ idx ][0] = Old2New[ CubVer[ KuhTet[l][0] ] ];
+               msh->TetVer[ idx ][1] = Old2New[ CubVer[ KuhTet[l][1] ] ];
+               msh->TetVer[ idx ][2] = Old2New[ CubVer[ KuhTet[l][2] ] ];
+               msh->TetVer[ idx ][3] = Old2New[ CubVer[ KuhTet[l][3] ] ];
+               msh->TetSlb[ idx ] = k;
+            }
+         }
+
+   // Shuffle the tets together with their slab index
+   if(UnsFlg)
+      for(i=msh->NmbTet;i>1;i--)
+      {
+         idx = 1 + RndInt() % i;
+
+         for(l=0;l<4;l++)
+         {
+            tmp = msh->TetVer[i][l];
+            msh->TetVer[i][l] = msh->TetVer[ idx ][l];
+            msh->TetVer[ idx ][l] = tmp;
+         }
+
+         tmp = msh->TetSlb[i];
+         msh->TetSlb[i] = msh->TetSlb[ idx ];
+         msh->TetSlb[ idx ] = tmp;
+      }
+
+   free(Old2New);
+
+   // Bounding box
+   for(l=0;l<3;l++)
+   {
+      msh->box[l] = DBL_MAX;
+      msh->box[l+3] = -DBL_MAX;
+   }
+
+   for(i=1;i<=msh->NmbVer;i++)
+      for(l=0;l<3;l++)
+      {
+         msh->box[l] = fmin(msh->box[l], msh->crd[i][l]);
+         msh->box[l+3] = fmax(msh->box[l+3], msh->crd[i][l]);
+      }
+
+   // Vertex sharing slabs must not run concurrently: even slabs make
+   // the first color and odd ones the second, each slab is a grain
+   NmbSlb = n;
+   msh->NmbCol = (NmbSlb > 1) ? 2 : 1;
+   msh->NmbGrn = NmbSlb;
+   msh->ColTab = malloc((msh->NmbCol+1) * 2 * sizeof(int));
+   msh->GrnTab = malloc((msh->NmbGrn+1) * 2 * sizeof(int));
+   msh->ColVer = malloc((msh->NmbTet+1) * 4 * sizeof(itg));
+
+   if(!msh->ColTab || !msh->GrnTab || !msh->ColVer)
+      return(0);
+
+   msh->ColTab[1][0] = 1;
+   msh->ColTab[1][1] = (NmbSlb + 1) / 2;
+
+   if(msh->NmbCol == 2)
+   {
+      msh->ColTab[2][0] = msh->ColTab[1][1] + 1;
+      msh->ColTab[2][1] = NmbSlb;
+   }
+
+   // Grain g gathers the tets of slab k, grains are sorted by color
+   for(k=0;k<NmbSlb;k++)
+   {
+      j = (k & 1) ? (NmbSlb + 1) / 2 + k / 2 + 1 : k / 2 + 1;
+      msh->GrnTab[j][0] = 6 * n * n;
+   }
+
+   idx = 1;
+
+   for(j=1;j<=NmbSlb;j++)
+   {
+      tmp = msh->GrnTab[j][0];
+      msh->GrnTab[j][0] = idx;
+      msh->GrnTab[j][1] = idx;
+      idx += tmp;
+   }
+
+   for(i=1;i<=msh->NmbTet;i++)
+   {
+      k = msh->TetSlb[i];
+      j = (k & 1) ? (NmbSlb + 1) / 2 + k / 2 + 1 : k / 2 + 1;
+      memcpy(msh->ColVer[ msh->GrnTab[j][1]++ ], msh->TetVer[i], 4 * sizeof(itg));
+   }
+
+   for(j=1;j<=NmbSlb;j++)
+      msh->GrnTab[j][1]--;
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a mesh                                                                */
+/*----------------------------------------------------------------------------*/
+
+static void FreMsh(MshSct *msh)
+{
+   free(msh->crd);
+   free(msh->VerVal);
+   free(msh->TetVer);
+   free(msh->TetSlb);
+   free(msh->ColTab);
+   free(msh->GrnTab);
+   free(msh->ColVer);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Parallel loops: a direct vertex loop, a scattering tet loop,               */
+/* its colored version and an empty loop to measure the launch overhead       */
+/*----------------------------------------------------------------------------*/
+
+static void VerPrc(itg BegIdx, itg EndIdx, int PthIdx, MshSct *msh)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      msh->VerVal[i] = sqrt( msh->crd[i][0] * msh->crd[i][0]
+                           + msh->crd[i][1] * msh->crd[i][1]
+                           + msh->crd[i][2] * msh->crd[i][2] );
+}
+
+static void ScaTet(itg (*TetVer)[4], double (*crd)[3], double *VerVal, itg idx)
+{
+   int j;
+   double siz;
+   itg *tet = TetVer[ idx ];
+
+   siz = fabs(crd[ tet[0] ][0] - crd[ tet[3] ][0])
+       + fabs(crd[ tet[0] ][1] - crd[ tet[3] ][1])
+       + fabs(crd[ tet[0] ][2] - crd[ tet[3] ][2]);
+
+   for(j=0;j<4;j++)
+      VerVal[ tet[j] ] += .25 * siz;
+}
+
+static void TetPrc(itg BegIdx, itg EndIdx, int PthIdx, MshSct *msh)
+{
+   itg i;
+
+   (void)(PthIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      ScaTet(msh->TetVer, msh->crd, msh->VerVal, i);
+}
+
+static void ColPrc(int BegIdx, int EndIdx, int GrnIdx, MshSct *msh)
+{
+   itg i;
+
+   (void)(GrnIdx);
+
+   for(i=BegIdx;i<=EndIdx;i++)
+      ScaTet(msh->ColVer, msh->crd, msh->VerVal, i);
+}
+
+static void NulPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   (void)(BegIdx);
+   (void)(EndIdx);
+   (void)(PthIdx);
+   (void)(arg);
+}
+
+static void PipPrc(void *arg)
+{
+   (void)(arg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Print a CSV record, the speedup is relative to the first thread count      */
+/*----------------------------------------------------------------------------*/
+
+static void PrtRes(  char *MshNam, int bch, int NmbCpu, double NmbCal,
+                     double NmbItm, double tim, RefSct *ref )
+{
+   if(!ref->tim[ bch ])
+      ref->tim[ bch ] = tim;
+
+   printf("%s,%s,%d,%.0f,%.0f,%.6e,%.6e,%.3f,%.3f\n",
+            BchNam[ bch ], MshNam, NmbCpu, NmbCal, NmbItm, tim,
+            tim > 0. ? NmbItm / tim : 0., tim * 1e6 / NmbCal,
+            tim > 0. ? ref->tim[ bch ] / tim : 0.);
+
+   fflush(stdout);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check the reproducibility of the scattering loop's floating point sums:    */
+/* the deterministic scheduling must match the serial loop bit for bit and    */
+/* the static one must give the same sums from one launch to the next         */
+/*----------------------------------------------------------------------------*/
+
+static int ChkDet(int64_t ParIdx, int TetTyp, int StaTyp, int VerTyp, MshSct *msh)
+{
+   int      r, DetDif = 0, StaDif = 0;
+   itg      i;
+   size_t   siz = (msh->NmbVer+1) * sizeof(double);
+   double   *SerVal, *StaVal;
+
+   if(!(SerVal = calloc(msh->NmbVer+1, sizeof(double))))
+      return(0);
+
+   if(!(StaVal = malloc(siz)))
+   {
+      free(SerVal);
+      return(0);
+   }
+
+   for(i=1;i<=msh->NmbTet;i++)
+      ScaTet(msh->TetVer, msh->crd, SerVal, i);
+
+   for(r=0;r<2;r++)
+   {
+      SetExtendedAttributes(ParIdx, DeterministicScheduling);
+      memset(msh->VerVal, 0, siz);
+      LaunchParallel(ParIdx, TetTyp, VerTyp, (void *)TetPrc, (void *)msh);
+      DetDif |= memcmp(msh->VerVal, SerVal, siz) != 0;
+
+      SetExtendedAttributes(ParIdx, StaticScheduling);
+      memset(msh->VerVal, 0, siz);
+      LaunchParallel(ParIdx, StaTyp, VerTyp, (void *)TetPrc, (void *)msh);
+
+      if(!r)
+         memcpy(StaVal, msh->VerVal, siz);
+      else
+         StaDif |= memcmp(msh->VerVal, StaVal, siz) != 0;
+   }
+
+   SetExtendedAttributes(ParIdx, DynamicScheduling);
+   free(StaVal);
+   free(SerVal);
+
+   printf("# %s mesh: deterministic sums %s the serial ones, static sums %s\n",
+            msh->nam, DetDif ? "differ from" : "match",
+            StaDif ? "vary" : "are reproducible");
+
+   return(!DetDif && !StaDif);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the mesh dependent benchmarks with a given LPlib instance              */
+/* Each timing is the best of NmbRep runs                                     */
+/*----------------------------------------------------------------------------*/
+
+static int BchMsh(int64_t ParIdx, int NmbCpu, MshSct *msh, int NmbRep, RefSct *ref)
+{
+   int      r, VerTyp, TetTyp, StaTyp, ColTyp, EleTyp = LplTet;
+   itg      *EdgTab, *EleTab = &msh->TetVer[0][0], NmbEdg = 0;
+   float    sta[2];
+   double   tim, BstTim[ NmbBch + 1 ];
+   uint64_t (*idx)[2];
+
+   for(r=0;r<=NmbBch;r++)
+      BstTim[r] = DBL_MAX;
+
+   if( !(VerTyp = NewType(ParIdx, msh->NmbVer))
+   ||  !(TetTyp = NewType(ParIdx, msh->NmbTet))
+   ||  !(StaTyp = NewType(ParIdx, msh->NmbTet))
+   ||  !(ColTyp = NewType(ParIdx, msh->NmbTet)) )
+   {
+      return(0);
+   }
+
+   // Static scheduling needs its own type as the WP groups are built
+   // along with the dependencies
+   SetExtendedAttributes(ParIdx, StaticScheduling);
+
+   if(!BuildDependencyParallel(ParIdx, StaTyp, VerTyp, 4, EleTab, sta))
+      return(0);
+
+   SetExtendedAttributes(ParIdx, DynamicScheduling);
+
+   if( !BuildDependencyParallel(ParIdx, TetTyp, VerTyp, 4, EleTab, sta)
+   ||  SetColorGrains(ParIdx, ColTyp, msh->NmbCol, &msh->ColTab[0][0],
+                                      msh->NmbGrn, &msh->GrnTab[0][0]) )
+   {
+      return(0);
+   }
+
+   if(!(idx = malloc((msh->NmbVer+1) * 2 * sizeof(uint64_t))))
+      return(0);
+
+   for(r=0;r<NmbRep;r++)
+   {
+      tim = GetWallClock();
+      LaunchParallel(ParIdx, VerTyp, 0, (void *)VerPrc, (void *)msh);
+      BstTim[ BchBig ] = fmin(BstTim[ BchBig ], GetWallClock() - tim);
+
+      tim = GetWallClock();
+      LaunchParallel(ParIdx, TetTyp, VerTyp, (void *)TetPrc, (void *)msh);
+      BstTim[ BchDyn ] = fmin(BstTim[ BchDyn ], GetWallClock() - tim);
+
+      SetExtendedAttributes(ParIdx, StaticScheduling);
+      tim = GetWallClock();
+      LaunchParallel(ParIdx, StaTyp, VerTyp, (void *)TetPrc, (void *)msh);
+      BstTim[ BchSta ] = fmin(BstTim[ BchSta ], GetWallClock() - tim);
+      SetExtendedAttributes(ParIdx, DynamicScheduling);
+
+      SetExtendedAttributes(ParIdx, DeterministicScheduling);
+      tim = GetWallClock();
+      LaunchParallel(ParIdx, TetTyp, VerTyp, (void *)TetPrc, (void *)msh);
+      BstTim[ BchDet ] = fmin(BstTim[ BchDet ], GetWallClock() - tim);
+      SetExtendedAttributes(ParIdx, DynamicScheduling);
+
+      tim = GetWallClock();
+      LaunchColorGrains(ParIdx, ColTyp, (void *)ColPrc, (void *)msh);
+      BstTim[ BchCol ] = fmin(BstTim[ BchCol ], GetWallClock() - tim);
+
+      tim = GetWallClock();
+      HilbertRenumbering(ParIdx, msh->NmbVer, msh->box, msh->crd, idx);
+      BstTim[ BchHil ] = fmin(BstTim[ BchHil ], GetWallClock() - tim);
+
+      tim = GetWallClock();
+      NmbEdg = ParallelBuildMeshEdges( ParIdx, 1, &EleTyp, &msh->NmbTet,
+                                       &EleTab, &EdgTab );
+      BstTim[ BchEdg ] = fmin(BstTim[ BchEdg ], GetWallClock() - tim);
+
+      if(!NmbEdg)
+         break;
+
+      free(EdgTab);
+   }
+
+   free(idx);
+
+   if(NmbEdg && !ChkDet(ParIdx, TetTyp, StaTyp, VerTyp, msh))
+      NmbEdg = 0;
+
+   FreeType(ParIdx, ColTyp);
+   FreeType(ParIdx, StaTyp);
+   FreeType(ParIdx, TetTyp);
+   FreeType(ParIdx, VerTyp);
+
+   if(!NmbEdg)
+      return(0);
+
+   PrtRes(msh->nam, BchBig, NmbCpu, 1, msh->NmbVer, BstTim[ BchBig ], ref);
+   PrtRes(msh->nam, BchDyn, NmbCpu, 1, msh->NmbTet, BstTim[ BchDyn ], ref);
+   PrtRes(msh->nam, BchSta, NmbCpu, 1, msh->NmbTet, BstTim[ BchSta ], ref);
+   PrtRes(msh->nam, BchDet, NmbCpu, 1, msh->NmbTet, BstTim[ BchDet ], ref);
+   PrtRes(msh->nam, BchCol, NmbCpu, 1, msh->NmbTet, BstTim[ BchCol ], ref);
+   PrtRes(msh->nam, BchHil, NmbCpu, 1, msh->NmbVer, BstTim[ BchHil ], ref);
+   PrtRes(msh->nam, BchEdg, NmbCpu, 1, msh->NmbTet, BstTim[ BchEdg ], ref);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the mesh independent benchmarks: pipeline, memory clear and the        */
+/* cost of launching an empty loop                                            */
+/*----------------------------------------------------------------------------*/
+
+static int BchLib(int64_t ParIdx, int NmbCpu, int NmbRep, RefSct *ref)
+{
+   int      i, r, TypIdx, dep;
+   char     *mem;
+   double   tim, BstTim[ NmbBch + 1 ];
+
+   for(r=0;r<=NmbBch;r++)
+      BstTim[r] = DBL_MAX;
+
+   if( !(mem = malloc(MemSiz)) || !(TypIdx = NewType(ParIdx, NmbCpu)) )
+   {
+      free(mem);
+      return(0);
+   }
+
+   for(r=0;r<NmbRep;r++)
+   {
+      // Half the pipes are independent, the other half depend on the former one
+      tim = GetWallClock();
+      dep = 0;
+
+      for(i=0;i<NmbPip;i++)
+         dep = LaunchPipeline(ParIdx, (void *)PipPrc, NULL, (i & 1) && dep, &dep);
+
+      WaitPipeline(ParIdx);
+      BstTim[ BchPip ] = fmin(BstTim[ BchPip ], GetWallClock() - tim);
+
+      tim = GetWallClock();
+      ParallelMemClear(ParIdx, mem, MemSiz);
+      BstTim[ BchMem ] = fmin(BstTim[ BchMem ], GetWallClock() - tim);
+
+      tim = GetWallClock();
+
+      for(i=0;i<NmbOvh;i++)
+         LaunchParallel(ParIdx, TypIdx, 0, (void *)NulPrc, NULL);
+
+      BstTim[ BchOvh ] = fmin(BstTim[ BchOvh ], GetWallClock() - tim);
+   }
+
+   FreeType(ParIdx, TypIdx);
+   free(mem);
+
+   PrtRes("none", BchPip, NmbCpu, NmbPip, NmbPip, BstTim[ BchPip ], ref);
+   PrtRes("none", BchMem, NmbCpu, 1, MemSiz, BstTim[ BchMem ], ref);
+   PrtRes("none", BchOvh, NmbCpu, NmbOvh, NmbOvh, BstTim[ BchOvh ], ref);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Usage: lplib_bench [-n cubes per side] [-t max threads] [-r repetitions]   */
+/* The report is a CSV table written on the standard output                   */
+/*----------------------------------------------------------------------------*/
+
+int main(int ArgCnt, char **ArgVec)
+{
+   int      i, n = 48, MaxCpu = GetNumberOfCores(), NmbRep = 5, NmbCpu;
+   int64_t  ParIdx;
+   MshSct   msh[2];
+   RefSct   ref[3];
+
+   for(i=1;i<ArgCnt-1;i++)
+   {
+      if(!strcmp(ArgVec[i], "-n"))
+         n = atoi(ArgVec[++i]);
+      else if(!strcmp(ArgVec[i], "-t"))
+         MaxCpu = atoi(ArgVec[++i]);
+      else if(!strcmp(ArgVec[i], "-r"))
+         NmbRep = atoi(ArgVec[++i]);
+   }
+
+   if( (n < 1) || (MaxCpu < 1) || (MaxCpu > MaxPth) || (NmbRep < 1) )
+   {
+      fprintf(stderr, "usage: %s [-n cubes] [-t threads] [-r repetitions]\n", ArgVec[0]);
+      return(1);
+   }
+
+   // Lattice numbering first, then a jittered and shuffled version
+   memset(msh, 0, sizeof(msh));
+   memset(ref, 0, sizeof(ref));
+
+   if(!BldMsh(&msh[0], n, 0) || !BldMsh(&msh[1], n, 1))
+   {
+      fprintf(stderr, "could not allocate the meshes\n");
+      FreMsh(&msh[0]);
+      FreMsh(&msh[1]);
+      return(1);
+   }
+
+   printf("# lplib_bench: %d vertices, %d tets, %d repetitions\n",
+            (int)msh[0].NmbVer, (int)msh[0].NmbTet, NmbRep);
+   puts("benchmark,mesh,threads,calls,items,seconds,items_per_s,us_per_call,speedup");
+
+   // Double the number of threads up to the maximum
+   for(NmbCpu=1; NmbCpu<=MaxCpu; NmbCpu = (NmbCpu < MaxCpu && 2*NmbCpu > MaxCpu) ? MaxCpu : 2*NmbCpu)
+   {
+      if(!(ParIdx = InitParallel(NmbCpu)))
+      {
+         fprintf(stderr, "could not start %d threads\n", NmbCpu);
+         FreMsh(&msh[0]);
+         FreMsh(&msh[1]);
+         return(1);
+      }
+
+      for(i=0;i<2;i++)
+         if(!BchMsh(ParIdx, NmbCpu, &msh[i], NmbRep, &ref[i]))
+         {
+            fprintf(stderr, "benchmark failed on the %s mesh\n", msh[i].nam);
+            StopParallel(ParIdx);
+            FreMsh(&msh[0]);
+            FreMsh(&msh[1]);
+            return(1);
+         }
+
+      if(!BchLib(ParIdx, NmbCpu, NmbRep, &ref[2]))
+      {
+         fprintf(stderr, "library benchmark failed\n");
+         StopParallel(ParIdx);
+         FreMsh(&msh[0]);
+         FreMsh(&msh[1]);
+         return(1);
+      }
+
+      StopParallel(ParIdx);
+
+      if(NmbCpu == MaxCpu)
+         break;
+   }
+
+   FreMsh(&msh[0]);
+   FreMsh(&msh[1]);
+
+   return(0);
+}
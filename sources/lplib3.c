@@ -9,7 +9,7 @@
 /*   Description:       Handles threads, scheduling & dependencies            */
 /*   Author:            Loic MARECHAL                                         */
 /*   Creation date:     feb 25 2008                                           */
-/*   Last modification: nov 29 2024                                           */
+/*   Last modification: oct 15 2026                                           */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
 
@@ -22,6 +22,11 @@
 #define _CRT_SECURE_NO_WARNINGS
 #endif
 
+// Needed for the threads' affinity under Linux
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -33,6 +38,7 @@
 #include <sys/timeb.h>
 #else
 #include <unistd.h>
+#include <sched.h>
 #include <sys/time.h>
 #endif
 
@@ -45,6 +51,22 @@
 #include <math.h>
 #include <errno.h>
 #include <limits.h>
+#include <float.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#if defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+#endif
 
 #ifdef WITH_LIBMEMBLOCKS
 #include <libmemblocks1.h>
@@ -66,8 +88,191 @@
 #define MaxVarArg 20
 #define MaxF77Arg 20
 #define WrkPerGrp 8
+#define StlPerPth 16
+#define PagSiz    4096
+#define LocWin    4
+#define WrdAln    8
+#define SpsRat    4
+#define MinSrtSiz 65536
+#define SfcBat    16
+#define MaxSfcSta 16
+#define MaxLvl    8
+#define LvlPrb    64
+#define MinWrkTim 5e-5
+#define CacLin    64
+#define MaxStg    32
+#define MaxAsy    64
+#define MaxLst    16
+#define DefBatSiz 64
+#define MinPolCls 12
+#define MaxPolCls 21
+#define MaxPolBlk 4
+#define PolHdr    (2 * (int)sizeof(void *))
+#define MinStmSiz 33554432
+#define MinMemSiz 65536
+#define FilBlkSiz 4096
+
+#ifdef INT64
+#define MaxItg    INT64_MAX
+#define MinItg    INT64_MIN
+#else
+#define MaxItg    INT32_MAX
+#define MinItg    INT32_MIN
+#endif
+
+enum ParCmd {RunBigWrk, RunStlWrk, RunSmlWrk, RunDetWrk, RunLfrWrk, RunColWrk,
+             RunPthWrk, RunFusWrk, RunLstWrk, RunRsvWrk, EndPth};
+enum SchTyp {StaSch, LckSch, LfrSch, RsvSch};
+enum DepTyp {DnsDep, SpsDep, AutDep};
+
+
+/*----------------------------------------------------------------------------*/
+/* Atomic operations and thread yielding wrappers                             */
+/*----------------------------------------------------------------------------*/
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC has no generic atomics: the interlocked intrinsic is chosen from
+// the size of the operand, which is a 32 or 64-bit integer
+#define AtmI32(p)       ((volatile long *)(p))
+#define AtmI64(p)       ((volatile __int64 *)(p))
+#define AtmLod(p)       ((sizeof(*(p)) == 8) ? _InterlockedOr64(AtmI64(p), 0) \
+                                             : _InterlockedOr(AtmI32(p), 0))
+#define AtmSto(p, v)    ((sizeof(*(p)) == 8) \
+                        ? (void)_InterlockedExchange64(AtmI64(p), (__int64)(v)) \
+                        : (void)_InterlockedExchange(AtmI32(p), (long)(v)))
+#define AtmAdd(p, v)    ((sizeof(*(p)) == 8) \
+                        ? _InterlockedExchangeAdd64(AtmI64(p), (__int64)(v)) + (__int64)(v) \
+                        : _InterlockedExchangeAdd(AtmI32(p), (long)(v)) + (long)(v))
+#define AtmAnd(p, v)    ((sizeof(*(p)) == 8) \
+                        ? _InterlockedAnd64(AtmI64(p), (__int64)(v)) & (__int64)(v) \
+                        : _InterlockedAnd(AtmI32(p), (long)(v)) & (long)(v))
+#define AtmCas(p, o, n) ((sizeof(*(p)) == 8) \
+                        ? CasI64(AtmI64(p), (__int64 *)(o), (__int64)(n)) \
+                        : CasI32(AtmI32(p), (long *)(o), (long)(n)))
+
+static __inline int CasI32(volatile long *p, long *o, long n)
+{
+   long old = _InterlockedCompareExchange(p, n, *o);
+
+   if(old == *o)
+      return(1);
+
+   *o = old;
+   return(0);
+}
+
+static __inline int CasI64(volatile __int64 *p, __int64 *o, __int64 n)
+{
+   __int64 old = _InterlockedCompareExchange64(p, n, *o);
+
+   if(old == *o)
+      return(1);
+
+   *o = old;
+   return(0);
+}
+#else
+#define AtmLod(p)       __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define AtmSto(p, v)    __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define AtmAdd(p, v)    __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define AtmAnd(p, v)    __atomic_and_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define AtmCas(p, o, n) __atomic_compare_exchange_n((p), (o), (n), 0, \
+                           __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#endif
+
+// Fields or structures written by different threads start on their own line,
+// the alignment is given before the declaration as both compilers accept it
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CacAln __declspec(align(CacLin))
+#else
+#define CacAln __attribute__((aligned(CacLin)))
+#endif
 
-enum ParCmd {RunBigWrk, RunSmlWrk, RunDetWrk, RunColWrk, ClrMem, EndPth};
+#ifdef _WIN32
+#define YldPth() Sleep(0)
+#else
+#define YldPth() sched_yield()
+#endif
+
+// Position of a line in the type's geometric order, lines added afterward
+// by a ResizeType stay in place
+#define PosLin(t, i) (((t)->GeoPos && ((i) <= (t)->GeoNmb)) ? (t)->GeoPos[i] : (i))
+
+// Vector kernels over the dependency words, VecWid is the number of words
+#if defined(__AVX512F__)
+#define VecWid       8
+#define VecTyp       __m512i
+#define VecLod(p)    _mm512_loadu_si512((void *)(p))
+#define VecSto(p, v) _mm512_storeu_si512((void *)(p), (v))
+#define VecOr(a, b)  _mm512_or_si512((a), (b))
+#define VecAnd(a, b) _mm512_and_si512((a), (b))
+#define VecAnn(a, b) _mm512_andnot_si512((b), (a))
+#define VecTst(a, b) (_mm512_test_epi64_mask((a), (b)) != 0)
+#elif defined(__AVX2__)
+#define VecWid       4
+#define VecTyp       __m256i
+#define VecLod(p)    _mm256_loadu_si256((const __m256i *)(p))
+#define VecSto(p, v) _mm256_storeu_si256((__m256i *)(p), (v))
+#define VecOr(a, b)  _mm256_or_si256((a), (b))
+#define VecAnd(a, b) _mm256_and_si256((a), (b))
+#define VecAnn(a, b) _mm256_andnot_si256((b), (a))
+#define VecTst(a, b) (!_mm256_testz_si256((a), (b)))
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define VecWid       2
+#define VecTyp       uint64x2_t
+#define VecLod(p)    vld1q_u64((const uint64_t *)(p))
+#define VecSto(p, v) vst1q_u64((uint64_t *)(p), (v))
+#define VecOr(a, b)  vorrq_u64((a), (b))
+#define VecAnd(a, b) vandq_u64((a), (b))
+#define VecAnn(a, b) vbicq_u64((a), (b))
+#define VecTst(a, b) (vmaxvq_u32(vreinterpretq_u32_u64(vandq_u64((a), (b)))) != 0)
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CpuPau() _mm_pause()
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#define CpuPau() __yield()
+#elif defined(__x86_64__) || defined(__i386__)
+#define CpuPau() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define CpuPau() __asm__ __volatile__("yield")
+#else
+#define CpuPau()
+#endif
+
+// Number of set bits in a dependency word
+#if defined(_MSC_VER) && !defined(__clang__)
+static __inline int BitCnt(uint64_t wrd)
+{
+   wrd = wrd - ((wrd >> 1) & 0x5555555555555555ULL);
+   wrd = (wrd & 0x3333333333333333ULL) + ((wrd >> 2) & 0x3333333333333333ULL);
+   wrd = (wrd + (wrd >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+   return((int)((wrd * 0x0101010101010101ULL) >> 56));
+}
+#else
+#define BitCnt(w) __builtin_popcountll(w)
+#endif
+
+// Index of the lowest set bit of a non-zero dependency word
+#if defined(_MSC_VER) && !defined(__clang__)
+static __inline int BitCtz(uint64_t wrd)
+{
+   unsigned long idx;
+
+#ifdef _WIN64
+   _BitScanForward64(&idx, wrd);
+   return((int)idx);
+#else
+   if(_BitScanForward(&idx, (unsigned long)wrd))
+      return((int)idx);
+
+   _BitScanForward(&idx, (unsigned long)(wrd >> 32));
+   return((int)idx + 32);
+#endif
+}
+#else
+#define BitCtz(w) __builtin_ctzll(w)
+#endif
 
 
 /*----------------------------------------------------------------------------*/
@@ -76,11 +281,18 @@ enum ParCmd {RunBigWrk, RunSmlWrk, RunDetWrk, RunColWrk, ClrMem, EndPth};
 
 typedef struct WrkSct
 {
-   itg               BegIdx, EndIdx, ItlTab[ MaxPth ][2];
-   int               NmbDep, *DepWrdTab, GrpIdx, rnd;
+   itg               BegIdx, EndIdx;
+   int               NmbDep, GrpIdx, rnd, flg, pos, upd, NmbSps, MaxSps, *SpsIdx;
+   uint64_t          *DepWrdTab, *SpsMsk;
    struct WrkSct     *pre, *nex;
 }WrkSct;
 
+// Only the big WP, one per thread, hold a table of interleaved blocks
+typedef struct
+{
+   itg               ItlTab[ MaxPth ][2];
+}BigSct;
+
 typedef struct GrpSct
 {
    int               idx, NmbSmlWrk[ MaxPth ];
@@ -90,20 +302,59 @@ typedef struct GrpSct
 
 typedef struct
 {
-   itg               NmbLin, MaxNmbLin;
+   int               NmbSmlWrk, SmlWrkSiz, WrdStr;
+   float             acc;
+   double            tim;
+   uint64_t          *DepWrdMat;
+   void              *DepMatAdr;
+   WrkSct            *SmlWrkTab, **OrdTab;
+}LvlSct;
+
+typedef struct
+{
+   itg               NmbLin, MaxNmbLin, GeoNmb, *GeoIdx, *GeoPos;
    int               NmbSmlWrk, SmlWrkSiz, DepWrkSiz, NmbGrp, NmbCol, NmbGrn;
-   int               NmbDepWrd, *DepWrdMat, *RunDepTab, (*ColTab)[2], (*GrnTab)[2];
-   WrkSct            *SmlWrkTab, *BigWrkTab;
+   int               MaxSmlWrk, NmbDepWrd, DepWrdStr, SpsFlg, DepErr, NmbSrtWrk;
+   int               DepIdx;
+   int               (*ColTab)[2], (*GrnTab)[2];
+   uint64_t          *DepWrdMat, *RunDepTab;
+   void              *DepMatAdr, *RunDepAdr;
+   WrkSct            *SmlWrkTab, **OrdTab;
+   BigSct            *BigWrkTab;
    GrpSct            *NexGrp;
+   int               NmbLvl, CurLvl, LstLvl, LvlCnt;
+   LvlSct            *LvlTab;
 }TypSct;
 
 typedef struct
 {
-   int               idx, NmbDetWrk, GrnIdx;
-   char              *ClrAdr;
+   double            beg, end;
+   itg               BegIdx, EndIdx;
+   int               lch, tid;
+}EvtSct;
+
+typedef struct
+{
+   void              *prc;
+   int               TypIdx1, TypIdx2, NmbBlk;
+   float             acc;
+   double            beg, end;
+}LchSct;
+
+typedef struct CacAln PthSct
+{
+   int               idx, NmbDetWrk, GrnIdx, gen, prk, StlCpt, LocHit, LocTry;
+   int               NmbEvt, MaxEvt, NmbBlk;
+   EvtSct            *EvtTab;
+   itg               StlBeg, StlEnd, StlLin;
+   uint64_t          StlWrd;
+   float             sta[2];
+   double            StlTim;
    size_t            StkSiz;
    void *            *UsrStk;
    WrkSct            *wrk, **DetWrkTab;
+   BigSct            *big;
+   struct PthSct     *TemPth;
    pthread_mutex_t   mtx;
    pthread_cond_t    cnd;
    pthread_t         pth;
@@ -111,49 +362,148 @@ typedef struct
    struct ParSct     *par;
 }PthSct;
 
-typedef struct PipSct
+typedef struct
 {
-   int               idx, NmbVarArg, NmbDep, DepTab[ MaxPipDep ], BegIdx, EndIdx, GrnIdx;
-   void              *prc, *arg, *VarArgTab[ MaxVarArg ];
-   size_t            StkSiz;
-   void              *UsrStk;
-   pthread_attr_t    atr;
-   pthread_t         pth;
-   struct ParSct     *par;
-}PipSct;
+   int               TypIdx2;
+   void              *prc, *arg;
+}StgSct;
 
 typedef struct
 {
-   int               BegIdx, EndIdx, GrnIdx;
+   int               TypIdx1, TypIdx2, JoiFlg;
    void              *prc, *arg;
-   pthread_t         pth;
+}AsySct;
+
+typedef struct
+{
+   int               NmbStg, NmbWrk, NmbBlk, QueBeg, QueEnd, NmbQue, RunCpt, NmbPck;
+   int               *WrkStg, *WrkSta, *WrkBlkBeg, *WrkBlkTab;
+   int               *BlkWrkBeg, *BlkWrkTab, *BlkPen, *QueTab;
+   int64_t           DonCpt, TotCpt;
+   char              *RunBlk;
+   double            acc;
+   StgSct            *StgTab;
+   TypSct            *typ;
+   pthread_mutex_t   mtx;
+   pthread_cond_t    cnd;
+}FusSct;
+
+typedef struct
+{
+   itg               MaxSiz, *ItmTab, *PrvTab, *BufTab;
+   int               mod, BatSiz, PrvMax, IdlCpt, PrkCpt, gen, *NmbPrv;
+   int64_t           PshCpt, PopCpt, PenCpt, DonCpt;
+   void              *prc, *arg;
+   WrkSct            **ClaTab;
+   TypSct            *typ1, *typ2;
+   pthread_mutex_t   mtx;
+   pthread_cond_t    cnd;
+}LstSct;
+
+// WP precedence graph of a deterministic launch: each WP waits for the
+// previous ones, in the type's order, sharing one of its dependency blocks
+typedef struct
+{
+   int               NmbWrk, NmbBlk, *PrdCpt, *SucBeg, *SucTab, *RdyTab;
+   WrkSct            **WrkTab;
+   CacAln int        RdyBeg;
+   CacAln int        RdyEnd;
+}RsvSct;
+
+typedef struct PipSct
+{
+   int               idx, NmbVarArg, NmbDep, NmbWai, DepTab[ MaxPipDep ];
+   void              *prc, *arg, *VarArgTab[ MaxVarArg ];
+   struct PipSct     *nex, *SucLnk[ MaxPipDep ];
    struct ParSct     *par;
-}GrnSct;
+}PipSct;
 
-typedef struct ParSct
+typedef struct CacAln ParSct
 {
-   int               NmbCpu, WrkCpt, NmbPip, PenPip, RunPip, NmbTyp, DynSch;
-   int               req, cmd, *PipWrd, SizMul, NmbVarArg, NmbDep;
-   int               WrkSizSrt, NmbItlBlk, ItlBlkSiz, BufMax, BufCpt, CurCol;
-   int               NmbSmlBlk, NmbDepBlk, NmbColGrn, GrnNxt, GrnDon;
-   size_t            StkSiz, ClrLinSiz;
+   int               NmbCpu, NmbPip, PenPip, RunPip, NmbTyp, DynSch;
+   int               cmd, SizMul, NmbVarArg;
+   uint64_t          *PipWrd;
+   int               WrkSizSrt, NmbItlBlk, ItlBlkSiz, BufMax, CurCol;
+   int               NmbSmlBlk, NmbDepBlk, NmbColGrn, GrnDon;
+   int               SpnWat, MstPrk, WrkStl, PinMod;
+   int               LocSch, DepMod, PipEnd, AutBlk;
+   int               PrfFlg, CurLch, NmbLch, MaxLch, NmbPev, MaxPev, PipWid;
+   int               RedFlg, NmbStg, StgTyp;
+   int               AsyFlg, AsyEnd, AsyJoi, MstJoi, AsyBeg, AsyNmb;
+   int               TemCpt, RetCpt, NmbPxy, PxyTab[ MaxPth ];
+   int64_t           AsyNxt, AsyDon, AsyCur, JoiLch;
+   float             AsyAcc[ MaxAsy ];
+   AsySct            AsyQue[ MaxAsy ];
+   double            PrfOrg;
+   char              *RedTab;
+   void              *RedAdr;
+   size_t            RedSlb, RedMax;
+   LchSct            *LchTab;
+   EvtSct            *PevTab;
+   itg               StlChk;
+   size_t            StkSiz;
    void              *lmb, *VarArgTab[ MaxVarArg ];
-   float             sta[2];
+   void              *PolTab[ MaxPolCls ];
+   int               PolNmb[ MaxPolCls ];
    void              (*prc)(itg, itg, int, void *), *arg;
-   pthread_cond_t    ParCnd, PipCnd;
-   pthread_mutex_t   ParMtx, PipMtx;
-   pthread_t         PipPth;
+   pthread_cond_t    ParCnd, PipCnd, WaiCnd, AsyCnd, AsyDonCnd;
+   pthread_mutex_t   PipMtx, AsyMtx, TemMtx;
+   pthread_t         *PipPth, AsyPth;
+   void              **PipStk;
+   struct PipSct     **SucHed, *RdyHed, *RdyTal;
    PthSct            *PthTab;
+   StgSct            StgTab[ MaxStg ];
+   FusSct            *fus;
+   RsvSct            *rsv;
+   LstSct            *lst, *LstTab[ MaxLst + 1 ];
+   struct ParSct     *PrtPar;
    TypSct            *TypTab, *CurTyp, *DepTyp, *typ1, *typ2;
+   void              *ParAdr, *PthAdr;
+
+   // The counters updated by all threads during a launch are kept apart from
+   // the read-mostly fields above and from each other
+   CacAln int        DonCpt;
+   CacAln int        LfrIdx;
+   CacAln int        LfrRun;
+   CacAln int        GrnNxt;
+   CacAln int        PxyIdx;
+
+   // The dynamic scheduler's state, updated under ParMtx
+   CacAln pthread_mutex_t ParMtx;
+   int               WrkCpt, req, BufCpt, NmbDep;
+   float             sta[2];
    WrkSct            *NexWrk, *BufWrk[ MaxPth / 4 ];
 }ParSct;
 
 typedef struct
 {
-   uint64_t          (*idx)[2];
-   double            box[6], (*crd)[3], (*crd2)[2];
+   int               NmbDim, CrvTyp;
+   uint64_t          (*idx)[2], *CodTab;
+   double            box[6], *CrdTab;
 }ArgSct;
 
+typedef struct
+{
+   char              *adr;
+   size_t            siz;
+}ClrSct;
+
+typedef struct
+{
+   char              *dst, *src, *pat;
+   size_t            NmbItm, ItmSiz, siz, SlcBeg[ MaxPth + 1 ];
+   int               NmbPth, stm;
+   itg               *IdxTab, *SumTab, SumPth[ MaxPth ];
+}MemSct;
+
+typedef struct
+{
+   ParSct            *par;
+   TypSct            *typ1, *typ2;
+   itg               *EleTab;
+   int               EleSiz;
+}DepSct;
+
 typedef struct
 {
    void              *base;
@@ -161,33 +511,166 @@ typedef struct
    int               (*compar)(const void *, const void *);
 }PipArgSct;
 
+typedef struct
+{
+   char              *src, *dst;
+   size_t            nel, width, bnd[ MaxPth + 1 ], (*CntTab)[256];
+   int               NmbRun, stp, sft;
+   int               (*compar)(const void *, const void *);
+}SrtSct;
+
+typedef struct
+{
+   int               opr, stp;
+   size_t            siz, SlbSiz;
+   char              *tab;
+   void              (*cmb)(void *, void *, void *), *arg;
+}RedSct;
+
+typedef struct
+{
+   int               NmbDim, EleSiz;
+   itg               *ref, *TmpRef, *Old2New, *New2Old, *EleTab, *TmpEle;
+   uint64_t          (*idx)[2];
+   double            box[6], BoxTab[ MaxPth ][6], *crd, *TmpCrd;
+}RenSct;
+
 
 /*----------------------------------------------------------------------------*/
 /* Private procedures' prototypes                                             */
 /*----------------------------------------------------------------------------*/
 
-static int     SetBit      (int *, int);
-static int     GetBit      (int *, int);
-static void    ClrBit      (int *, int);
-static int     AndWrd      (int, int *, int *);
-static void    AddWrd      (int, int *, int *);
-static void    SubWrd      (int, int *, int *);
-static void    ClrWrd      (int, int *);
-static void    CpyWrd      (int, int *, int *);
+static int     SetBit      (uint64_t *, int);
+static int     GetBit      (uint64_t *, int);
+static int     AndWrd      (int, uint64_t *, uint64_t *);
+static int     AnnWrd      (int, uint64_t *, uint64_t *, uint64_t *);
+static int     TstAddWrd   (int, uint64_t *, uint64_t *);
+static void    AddWrd      (int, uint64_t *, uint64_t *);
+static void    SubWrd      (int, uint64_t *, uint64_t *);
+static void    ClrWrd      (int, uint64_t *);
+static uint64_t FldWrd     (uint64_t);
+static int     WrkBit      (ParSct *, TypSct *, WrkSct *, int);
+static int     WrkTsa      (TypSct *, WrkSct *, uint64_t *);
+static int     WrkAnn      (TypSct *, WrkSct *, uint64_t *, uint64_t *);
+static void    WrkAdd      (TypSct *, WrkSct *, uint64_t *);
+static void    WrkSub      (TypSct *, WrkSct *, uint64_t *);
+static int     WrkCla      (TypSct *, WrkSct *, uint64_t *);
+static void    WrkRls      (TypSct *, WrkSct *, uint64_t *);
+static int     SetSps      (ParSct *, WrkSct *, int);
+static void    FreSps      (ParSct *, TypSct *);
 int            CmpWrk      (const void *, const void *);
 static void   *PipHdl      (void *);
+static int     IniPip      (ParSct *);
+static void    RdyPip      (ParSct *, PipSct *);
 static void   *PthHdl      (void *);
+static void    RunCmd      (PthSct *);
+static void    RunPxy      (ParSct *);
 static WrkSct *NexWrk      (ParSct *, int);
 void           PipSrt      (PipArgSct *);
 static void    CalVarArgPip(PipSct *, void *);
 static void    CalVarArgPrc(itg, itg, int, ParSct *);
+static void    CalPrc      (ParSct *, itg, itg, int);
+static int     ClaWrd      (int, uint64_t *, uint64_t *);
+static void    RlsWrd      (int, uint64_t *, uint64_t *);
+static WrkSct *LfrNexWrk   (PthSct *);
+static WrkSct *LocNexWrk   (ParSct *, PthSct *);
+static WrkSct *LocLfrWrk   (ParSct *, PthSct *);
+static WrkSct *GetWrk      (TypSct *, itg);
+static void    SetOrd      (TypSct *);
+static void    LfrWrk      (PthSct *);
+static int     SetRsv      (ParSct *, TypSct *, RsvSct *);
+static void    FreRsv      (ParSct *, RsvSct *);
+static void    RsvWrk      (PthSct *);
+static void    StlWrk      (PthSct *);
+static int     PopChk      (PthSct *, int);
+static void    WakPth      (PthSct *);
+static void    WaiCmd      (PthSct *, int *);
+static void    DonPth      (ParSct *);
+static void    LchPth      (ParSct *);
+static float   LchLfr      (ParSct *, TypSct *, int, void *, void *);
+static void    WaiAsy      (ParSct *);
+static int     SetPin      (ParSct *, int);
+static void    ClrPrc      (itg, itg, int, ClrSct *);
+static int     SetSlc      (ParSct *, MemSct *, void *, size_t, size_t);
+static void    GetSlc      (MemSct *, int, size_t *, size_t *);
+static void    RunMem      (ParSct *, MemSct *, void *);
+static void    StmCpy      (char *, char *, size_t);
+static void    FilPrc      (itg, itg, int, MemSct *);
+static void    MovPrc      (itg, itg, int, MemSct *);
+static void    GatPrc      (itg, itg, int, MemSct *);
+static void    SctPrc      (itg, itg, int, MemSct *);
+static void    SumPrc      (itg, itg, int, MemSct *);
+static void    OffPrc      (itg, itg, int, MemSct *);
+static void    DepPrc      (itg, itg, int, DepSct *);
+static void    RunBig      (ParSct *, TypSct *, void *, void *);
+static void    RunPth      (ParSct *, void *, void *);
+static void    SrtPrc      (itg, itg, int, SrtSct *);
+static void    MrgPrc      (itg, itg, int, SrtSct *);
+static void    HisPrc      (itg, itg, int, SrtSct *);
+static void    RdxPrc      (itg, itg, int, SrtSct *);
+static void    CpyPrc      (itg, itg, int, SrtSct *);
+static void    IniSfc      (void);
+static int     BldSfc      (int, int *, int *, int, uint16_t *);
+static uint64_t SprBit     (uint64_t, int);
+static void    SfcBlk      (int, int, double *, double *, int, uint64_t *);
+static void    RenPrc      (itg, itg, int, ArgSct *);
+static void    BatPrc      (itg, itg, int, ArgSct *);
+static void    RunLin      (int64_t, itg, void *, void *);
+static int     SetRenBox   (int64_t, itg, RenSct *);
+static void    BoxPrc      (itg, itg, int, RenSct *);
+static void    VerPrc      (itg, itg, int, RenSct *);
+static void    ElePrc      (itg, itg, int, RenSct *);
+static void    PrmPrc      (itg, itg, int, RenSct *);
+static void    GeoPrc      (itg, itg, int, RenSct *);
+static void    FreGeo      (ParSct *, TypSct *);
+static int     BldLvl      (ParSct *, TypSct *);
+static void    SetLvl      (TypSct *, int);
+static void    ChsLvl      (ParSct *, TypSct *);
+static void    UpdLvl      (TypSct *, double, float);
+static void    FreLvl      (ParSct *, TypSct *);
+static int     LvlBit      (ParSct *, TypSct *, itg, int);
+static int     AddEvt      (EvtSct **, int *, int *, EvtSct *);
+static void    BegLch      (ParSct *, void *, int, int);
+static void    EndLch      (ParSct *, float);
+static void    FrePrf      (ParSct *);
+static void    IniRed      (int, size_t, char *);
+static void    RedPrc      (itg, itg, int, RedSct *);
+static int     IniFus      (ParSct *, FusSct *);
+static void    FreFus      (ParSct *, FusSct *);
+static int     ChkFus      (FusSct *, int);
+static int     EndFus      (FusSct *, int);
+static void    FusWrk      (PthSct *);
+static void   *AsyHdl      (void *);
+static int     PshLst      (LstSct *, itg *, int);
+static int     PopLst      (LstSct *, itg *, int);
+static int     SplPrv      (LstSct *, int);
+static void    LstWrk      (PthSct *);
+static void    WakLst      (LstSct *);
+static void    WaiLst      (LstSct *, int);
 static int64_t IniPar      (int, size_t, void *);
+static ParSct *NewPar      (int, size_t, void *);
+static void    RunTem      (PthSct *);
 static void    SetItlBlk   (ParSct *, TypSct *);
 static int     SetGrp      (ParSct *, TypSct *);
+static int     UpdGrp      (ParSct *, TypSct *);
+static int     AddGrp      (ParSct *, TypSct *, WrkSct *, int);
+static void    FreGrp      (ParSct *, TypSct *);
+static void    DelGrp      (ParSct *, TypSct *);
+static int     ReaTyp      (ParSct *, TypSct *, int);
+static int     ShrTyp      (ParSct *, TypSct *, int);
+static int     GrwDep      (ParSct *, TypSct *, TypSct *);
+static int     MrgWrk      (ParSct *, TypSct *, int);
+static int     SetDepSta   (TypSct *, TypSct *, float [2]);
+static void    SetWrkDep   (ParSct *, TypSct *, TypSct *, WrkSct *, itg, itg,
+                            int, itg *);
 static void   *LPL_malloc  (void *, int64_t);
 static void   *LPL_calloc  (void *, int64_t, int64_t);
+static void   *LPL_aligned_calloc(void *, int64_t, void **);
 static void    LPL_free    (void *, void *);
-static void   *GrnHdl      (void *ptr);
+static void   *PolAlc      (ParSct *, int64_t);
+static void    PolFre      (ParSct *, void *);
+static void    FrePol      (ParSct *);
+static void    ColWrk      (PthSct *);
 
 
 /*----------------------------------------------------------------------------*/
@@ -202,7 +685,7 @@ int64_t InitParallel(int NmbCpu)
 int64_t InitParallelAttr(int NmbCpu, size_t StkSiz, void *lmb)
 {
 #ifdef PTHREAD_STACK_MIN
-   if(StkSiz < PTHREAD_STACK_MIN)
+   if(StkSiz < (size_t)PTHREAD_STACK_MIN)
       StkSiz = PTHREAD_STACK_MIN;
 #endif
    return(IniPar(NmbCpu, StkSiz, lmb));
@@ -227,51 +710,13 @@ static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
    if(NmbCpu > MaxPth)
       NmbCpu = MaxPth;
 
-   // Allocate and build main parallel structure
-   if(!(par = LPL_calloc(lmb, 1, sizeof(ParSct))))
-      return(0);
-
-   // Pass along a potential libMemBlocks structure
-   par->lmb = lmb;
-
-   if(!(par->PthTab = LPL_calloc(par->lmb, NmbCpu, sizeof(PthSct))))
-      return(0);
-
-   if(!(par->TypTab = LPL_calloc(par->lmb, (MaxTyp + 1), sizeof(TypSct))))
-      return(0);
-
-   if(!(par->PipWrd = LPL_calloc(par->lmb, MaxTotPip/32, sizeof(int))))
+   if(!(par = NewPar(NmbCpu, StkSiz, lmb)))
       return(0);
 
-   par->NmbCpu = NmbCpu;
-   par->WrkCpt = par->NmbPip = par->PenPip = par->RunPip = 0;
-   par->SizMul = 2;
-   par->StkSiz = StkSiz;
-   par->NmbItlBlk = 1;
-   par->WrkSizSrt = 1;
-   par->DynSch = 1;
-   par->NmbSmlBlk = DefSmlBlk;
-   par->NmbDepBlk = DefDepBlk;
-
-   // Set the size of WP buffer
-   /*if(NmbCpu >= 4)
-      par->BufMax = NmbCpu / 4;
-   else*/
-      par->BufMax = 1;
-
-   pthread_mutex_init(&par->ParMtx, NULL);
-   pthread_mutex_init(&par->PipMtx, NULL);
-   pthread_cond_init(&par->ParCnd, NULL);
-   pthread_cond_init(&par->PipCnd, NULL);
-
    // Launch pthreads
    for(i=0;i<par->NmbCpu;i++)
    {
       pth = &par->PthTab[i];
-      pth->idx = i;
-      pth->par = par;
-      pthread_mutex_init(&pth->mtx, NULL);
-      pthread_cond_init(&pth->cnd, NULL);
 
       if(StkSiz)
       {
@@ -309,113 +754,328 @@ static int64_t IniPar(int NmbCpu, size_t StkSiz, void *lmb)
 
 
 /*----------------------------------------------------------------------------*/
-/* Stop all threads and free memories                                         */
+/* Allocate and setup a parallel structure and its threads' slots             */
 /*----------------------------------------------------------------------------*/
 
-void StopParallel(int64_t ParIdx)
+static ParSct *NewPar(int NmbCpu, size_t StkSiz, void *lmb)
 {
    int i;
+   void *adr;
+   ParSct *par;
    PthSct *pth;
-   ParSct *par = (ParSct *)ParIdx;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return;
+   // Allocate and build main parallel structure
+   if(!(par = LPL_aligned_calloc(lmb, sizeof(ParSct), &adr)))
+      return(NULL);
 
-   // Send stop to all threads
-   pthread_mutex_lock(&par->ParMtx);
-   par->cmd = EndPth;
-   pthread_mutex_unlock(&par->ParMtx);
+   // Pass along a potential libMemBlocks structure
+   par->lmb = lmb;
+   par->ParAdr = adr;
 
-   // Wait for all threads to complete
-   for(i=0;i<par->NmbCpu;i++)
+   // The extra slot is used by the master when it joins a launch
+   if(!(par->PthTab = LPL_aligned_calloc(par->lmb,
+         (NmbCpu + 1) * sizeof(PthSct), &par->PthAdr)))
    {
-      pth = &par->PthTab[i];
-      pthread_mutex_lock(&pth->mtx);
-      pthread_cond_signal(&pth->cnd);
-      pthread_mutex_unlock(&pth->mtx);
-      pthread_join(pth->pth, NULL);
-
-      if(pth->UsrStk)
-         LPL_free(par->lmb, pth->UsrStk);
+      return(NULL);
    }
 
-   pthread_mutex_destroy(&par->ParMtx);
-   pthread_cond_destroy(&par->ParCnd);
-
-   WaitPipeline(ParIdx);
+   if(!(par->TypTab = LPL_calloc(par->lmb, (MaxTyp + 1), sizeof(TypSct))))
+      return(NULL);
 
-   pthread_mutex_destroy(&par->PipMtx);
-   pthread_cond_destroy(&par->PipCnd);
+   if(!(par->PipWrd = LPL_calloc(par->lmb, MaxTotPip/64, sizeof(uint64_t))))
+      return(NULL);
 
-   // Free memories
-   for(i=1;i<=MaxTyp;i++)
-      if(par->TypTab[i].NmbLin)
-         FreeType(ParIdx, i);
+   par->NmbCpu = NmbCpu;
+   par->WrkCpt = par->NmbPip = par->PenPip = par->RunPip = 0;
+   par->SizMul = 2;
+   par->StkSiz = StkSiz;
+   par->NmbItlBlk = 1;
+   par->WrkSizSrt = 1;
+   par->DynSch = LckSch;
+   par->DepMod = AutDep;
+   par->NmbSmlBlk = DefSmlBlk;
+   par->NmbDepBlk = DefDepBlk;
 
-   LPL_free(par->lmb, par->PthTab);
-   LPL_free(par->lmb, par->TypTab);
-   LPL_free(par->lmb, par->PipWrd);
-   free(par);
-}
+   // Set the size of WP buffer
+   /*if(NmbCpu >= 4)
+      par->BufMax = NmbCpu / 4;
+   else*/
+      par->BufMax = 1;
 
+   pthread_mutex_init(&par->ParMtx, NULL);
+   pthread_mutex_init(&par->PipMtx, NULL);
+   pthread_cond_init(&par->ParCnd, NULL);
+   pthread_cond_init(&par->PipCnd, NULL);
+   pthread_cond_init(&par->WaiCnd, NULL);
+   pthread_mutex_init(&par->AsyMtx, NULL);
+   pthread_cond_init(&par->AsyCnd, NULL);
+   pthread_cond_init(&par->AsyDonCnd, NULL);
+   pthread_mutex_init(&par->TemMtx, NULL);
+   par->PthTab[ NmbCpu ].idx = NmbCpu;
+   par->PthTab[ NmbCpu ].par = par;
 
-/*----------------------------------------------------------------------------*/
-/* Try to detect the number of system's threads                               */
-/*----------------------------------------------------------------------------*/
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      pth = &par->PthTab[i];
+      pth->idx = i;
+      pth->par = par;
+      pthread_mutex_init(&pth->mtx, NULL);
+      pthread_cond_init(&pth->cnd, NULL);
+   }
 
-int GetNumberOfCores()
-{
-#ifdef _WIN32
-   SYSTEM_INFO info;
-   GetSystemInfo(&info);
-   return(info.dwNumberOfProcessors);
-#else
-#ifdef _SC_NPROCESSORS_ONLN
-   return((itg)sysconf(_SC_NPROCESSORS_ONLN));
-#else
-   return(1);
-#endif
-#endif
+   return(par);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Set extra attributes to fine tune the blocks processing order              */
+/* Build a team out of some idle threads of an instance: it gets its own      */
+/* scheduler, types and pipelines and runs its launches independently of      */
+/* the other teams, until it is stopped with StopParallel                     */
+/* The parent keeps running its own launches meanwhile: its remaining threads */
+/* and the master run the lent threads' share of the work                     */
 /*----------------------------------------------------------------------------*/
 
-int SetExtendedAttributes(int64_t ParIdx, ...)
+int64_t InitTeam(int64_t ParIdx, int NmbCpu)
 {
-   int NmbArg = 0, ArgCod, ArgVal;
-   ParSct *par = (ParSct *)ParIdx;
-   va_list ArgLst;
+   int i, j;
+   ParSct *par = (ParSct *)ParIdx, *tem;
 
-   // Attributes cannot be modified the a prallel loop is running
-   if(par->typ1)
+   // Get and check lib parallel instance
+   if(!ParIdx || (NmbCpu < 1))
       return(0);
 
-   // Read the argument list that must be terminated by a zero
-   va_start(ArgLst, ParIdx);
+   // The lent threads must not be busy with an asynchronous launch
+   WaiAsy(par);
 
-   ArgCod = va_arg(ArgLst, int);
+   pthread_mutex_lock(&par->TemMtx);
 
-   switch(ArgCod)
+   if( (NmbCpu > par->NmbCpu - par->TemCpt)
+   ||  !(tem = NewPar(NmbCpu, par->StkSiz, par->lmb)) )
    {
-      // Set the number of interleaved blocks in independant loops
-      case SetInterleavingFactor :
-      {
-         ArgVal = va_arg(ArgLst, int);
+      pthread_mutex_unlock(&par->TemMtx);
+      return(0);
+   }
 
-         if(ArgVal > 0)
-         {
-            par->NmbItlBlk = ArgVal;
-            par->ItlBlkSiz = 0;
-            NmbArg++;
-         }
-      }break;
+   // Inherit the parent's scheduling attributes
+   tem->PrtPar = par;
+   tem->DynSch = par->DynSch;
+   tem->DepMod = par->DepMod;
+   tem->NmbSmlBlk = par->NmbSmlBlk;
+   tem->NmbDepBlk = par->NmbDepBlk;
+   tem->NmbItlBlk = par->NmbItlBlk;
+   tem->ItlBlkSiz = par->ItlBlkSiz;
+   tem->WrkSizSrt = par->WrkSizSrt;
+   tem->SpnWat = par->SpnWat;
+   tem->WrkStl = par->WrkStl;
+   tem->LocSch = par->LocSch;
+   tem->AutBlk = par->AutBlk;
+
+   // Lend the first free threads, they will run the team's handler
+   for(i=j=0; j<NmbCpu; i++)
+      if(!par->PthTab[i].TemPth)
+         par->PthTab[i].TemPth = &tem->PthTab[ j++ ];
+
+   AtmAdd(&par->TemCpt, NmbCpu);
 
-      // Set the interleaved blocks size in independant loops
-      case SetInterleavingSize :
+   for(i=0;i<par->NmbCpu;i++)
+      if(par->PthTab[i].TemPth && (par->PthTab[i].TemPth->par == tem))
+         WakPth(&par->PthTab[i]);
+
+   pthread_mutex_unlock(&par->TemMtx);
+
+   // Wait for all the team's threads to be up and waiting
+   pthread_mutex_lock(&tem->ParMtx);
+
+   while(tem->WrkCpt < tem->NmbCpu)
+      pthread_cond_wait(&tem->ParCnd, &tem->ParMtx);
+
+   pthread_mutex_unlock(&tem->ParMtx);
+
+   return((int64_t)tem);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Stop all threads and free memories                                         */
+/* An instance that still lends threads to a team is left untouched: its      */
+/* teams must be stopped first                                                */
+/*----------------------------------------------------------------------------*/
+
+void StopParallel(int64_t ParIdx)
+{
+   int i;
+   PthSct *pth;
+   ParSct *par = (ParSct *)ParIdx, *prt;
+
+   // Get and check lib parallel instance and its teams, joining the lent
+   // threads would block until their team returned them
+   if(!ParIdx || AtmLod(&par->TemCpt))
+      return;
+
+   // Complete the asynchronous launches and stop their thread
+   if(par->AsyFlg)
+   {
+      WaitParallel(ParIdx, par->AsyNxt);
+      pthread_mutex_lock(&par->AsyMtx);
+      par->AsyEnd = 1;
+      pthread_cond_signal(&par->AsyCnd);
+      pthread_mutex_unlock(&par->AsyMtx);
+      pthread_join(par->AsyPth, NULL);
+   }
+
+   pthread_mutex_destroy(&par->AsyMtx);
+   pthread_cond_destroy(&par->AsyCnd);
+   pthread_cond_destroy(&par->AsyDonCnd);
+
+   // Send stop to all threads
+   par->cmd = EndPth;
+
+   // A team's threads are lent by its parent: wait for them to return,
+   // then hand them back
+   if((prt = par->PrtPar))
+   {
+      for(i=0;i<par->NmbCpu;i++)
+         WakPth(&par->PthTab[i]);
+
+      pthread_mutex_lock(&par->ParMtx);
+
+      while(par->RetCpt < par->NmbCpu)
+         pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+
+      pthread_mutex_unlock(&par->ParMtx);
+      pthread_mutex_lock(&prt->TemMtx);
+
+      for(i=0;i<prt->NmbCpu;i++)
+         if(prt->PthTab[i].TemPth && (prt->PthTab[i].TemPth->par == par))
+            prt->PthTab[i].TemPth = NULL;
+
+      AtmAdd(&prt->TemCpt, -par->NmbCpu);
+      pthread_mutex_unlock(&prt->TemMtx);
+   }
+   else
+   {
+      // Wait for all threads to complete
+      for(i=0;i<par->NmbCpu;i++)
+      {
+         pth = &par->PthTab[i];
+         WakPth(pth);
+         pthread_join(pth->pth, NULL);
+
+         if(pth->UsrStk)
+            LPL_free(par->lmb, pth->UsrStk);
+      }
+   }
+
+   pthread_mutex_destroy(&par->TemMtx);
+   pthread_mutex_destroy(&par->ParMtx);
+   pthread_cond_destroy(&par->ParCnd);
+
+   WaitPipeline(ParIdx);
+
+   // Stop the pipeline threads once there is nothing left to run
+   if(par->PipPth)
+   {
+      pthread_mutex_lock(&par->PipMtx);
+      par->PipEnd = 1;
+      pthread_cond_broadcast(&par->PipCnd);
+      pthread_mutex_unlock(&par->PipMtx);
+
+      for(i=0;i<par->NmbCpu;i++)
+      {
+         pthread_join(par->PipPth[i], NULL);
+
+         if(par->PipStk[i])
+            LPL_free(par->lmb, par->PipStk[i]);
+      }
+
+      LPL_free(par->lmb, par->PipPth);
+      LPL_free(par->lmb, par->PipStk);
+      LPL_free(par->lmb, par->SucHed);
+   }
+
+   pthread_mutex_destroy(&par->PipMtx);
+   pthread_cond_destroy(&par->PipCnd);
+   pthread_cond_destroy(&par->WaiCnd);
+
+   // Free memories
+   FrePrf(par);
+
+   if(par->RedAdr)
+      LPL_free(par->lmb, par->RedAdr);
+
+   for(i=1;i<=MaxTyp;i++)
+      if(par->TypTab[i].NmbLin)
+         FreeType(ParIdx, i);
+
+   for(i=1;i<=MaxLst;i++)
+      FreeWorkList(ParIdx, i);
+
+   FrePol(par);
+   LPL_free(par->lmb, par->PthAdr);
+   LPL_free(par->lmb, par->TypTab);
+   LPL_free(par->lmb, par->PipWrd);
+   LPL_free(par->lmb, par->ParAdr);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Try to detect the number of system's threads                               */
+/*----------------------------------------------------------------------------*/
+
+int GetNumberOfCores()
+{
+#ifdef _WIN32
+   SYSTEM_INFO info;
+   GetSystemInfo(&info);
+   return(info.dwNumberOfProcessors);
+#else
+#ifdef _SC_NPROCESSORS_ONLN
+   return((itg)sysconf(_SC_NPROCESSORS_ONLN));
+#else
+   return(1);
+#endif
+#endif
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set extra attributes to fine tune the blocks processing order              */
+/*----------------------------------------------------------------------------*/
+
+int SetExtendedAttributes(int64_t ParIdx, ...)
+{
+   int i, NmbArg = 0, ArgCod, ArgVal;
+   ParSct *par = (ParSct *)ParIdx;
+   va_list ArgLst;
+
+   WaiAsy(par);
+
+   // Attributes cannot be modified the a prallel loop is running
+   if(par->typ1)
+      return(0);
+
+   // Read the argument list that must be terminated by a zero
+   va_start(ArgLst, ParIdx);
+
+   ArgCod = va_arg(ArgLst, int);
+
+   switch(ArgCod)
+   {
+      // Set the number of interleaved blocks in independant loops
+      case SetInterleavingFactor :
+      {
+         ArgVal = va_arg(ArgLst, int);
+
+         if(ArgVal > 0)
+         {
+            par->NmbItlBlk = ArgVal;
+            par->ItlBlkSiz = 0;
+            NmbArg++;
+         }
+      }break;
+
+      // Set the interleaved blocks size in independant loops
+      case SetInterleavingSize :
       {
          ArgVal = va_arg(ArgLst, int);
 
@@ -453,7 +1113,30 @@ int SetExtendedAttributes(int64_t ParIdx, ...)
       case StaticScheduling :
       {
          // WP sorting is useless in this mode so it is disabled
-         par->WrkSizSrt = par->DynSch = 0;
+         par->WrkSizSrt = 0;
+         par->DynSch = StaSch;
+         NmbArg++;
+      }break;
+
+      // Dynamic scheduling through the master thread's loop (default)
+      case DynamicScheduling :
+      {
+         par->DynSch = LckSch;
+         NmbArg++;
+      }break;
+
+      // Dynamic scheduling where threads atomically claim their own WP
+      case LockFreeScheduling :
+      {
+         par->DynSch = LfrSch;
+         NmbArg++;
+      }break;
+
+      // Dynamic scheduling where WP sharing a dependency block always run
+      // in the same order, making dependency loops bitwise reproducible
+      case DeterministicScheduling :
+      {
+         par->DynSch = RsvSch;
          NmbArg++;
       }break;
 
@@ -478,6 +1161,122 @@ int SetExtendedAttributes(int64_t ParIdx, ...)
             NmbArg++;
          }
       }break;
+
+      // Threads that are done with their big WP steal chunks from the others
+      case EnableWorkStealing :
+      {
+         par->WrkStl = 1;
+         NmbArg++;
+      }break;
+
+      // Each thread runs its own big WP only (default)
+      case DisableWorkStealing :
+      {
+         par->WrkStl = 0;
+         NmbArg++;
+      }break;
+
+      // Bind each thread to a core following a compact or scatter order
+      case SetThreadPinning :
+      {
+         ArgVal = va_arg(ArgLst, int);
+
+         if( (ArgVal >= NoPinning) && (ArgVal <= ScatterPinning)
+         &&  !par->PrtPar && SetPin(par, ArgVal) )
+         {
+            par->PinMod = ArgVal;
+            NmbArg++;
+         }
+      }break;
+
+      // Threads first try the WP next to their previous one in index order
+      case EnableLocalityScheduling :
+      {
+         par->LocSch = 1;
+         NmbArg++;
+      }break;
+
+      // Threads take the first compatible WP from the todo list (default)
+      case DisableLocalityScheduling :
+      {
+         par->LocSch = 0;
+         NmbArg++;
+      }break;
+
+      // Store each WP's dependencies as a dense bitmask
+      case DenseDependencies :
+      {
+         par->DepMod = DnsDep;
+         NmbArg++;
+      }break;
+
+      // Store each WP's dependencies as a sorted list of non-empty words
+      case SparseDependencies :
+      {
+         par->DepMod = SpsDep;
+         NmbArg++;
+      }break;
+
+      // Choose at BeginDependency from the types' sizes: sparse lists when
+      // each WP has many more dependency words than lines (default)
+      case AutomaticDependencies :
+      {
+         par->DepMod = AutDep;
+         NmbArg++;
+      }break;
+
+      // Number of polling iterations before sleeping on a condition, 0 = none
+      // Spinning is pointless when the threads and the master exceed the cores
+      case SetSpinWait :
+      {
+         ArgVal = va_arg(ArgLst, int);
+
+         if(ArgVal >= 0)
+         {
+            par->SpnWat = (par->NmbCpu < GetNumberOfCores()) ? ArgVal : 0;
+            NmbArg++;
+         }
+      }break;
+
+      // Build a hierarchy of coarser small blocks with each dependency
+      // and pick the level of each launch from the measured timings
+      case EnableAutomaticBlocks :
+      {
+         par->AutBlk = 1;
+         NmbArg++;
+      }break;
+
+      // Free the hierarchies and go back to the finest blocks
+      case DisableAutomaticBlocks :
+      {
+         par->AutBlk = 0;
+
+         for(i=1;i<=MaxTyp;i++)
+            FreLvl(par, &par->TypTab[i]);
+
+         NmbArg++;
+      }break;
+
+      // Record the launches, WP and pipes from now on, former records are lost
+      case EnableProfiling :
+      {
+         pthread_mutex_lock(&par->PipMtx);
+         FrePrf(par);
+         par->PrfOrg = GetWallClock();
+         par->CurLch = -1;
+         par->PrfFlg = 1;
+         pthread_mutex_unlock(&par->PipMtx);
+         NmbArg++;
+      }break;
+
+      // Stop recording but keep the records for export
+      case DisableProfiling :
+      {
+         pthread_mutex_lock(&par->PipMtx);
+         par->PrfFlg = 0;
+         pthread_mutex_unlock(&par->PipMtx);
+         NmbArg++;
+      }break;
    }
 
    va_end(ArgLst);
@@ -493,12 +1292,14 @@ int SetExtendedAttributes(int64_t ParIdx, ...)
 float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
                      void *prc, void *PtrArg )
 {
-   int      i;
+   int      i, AutLvl;
    float    acc = 0.;
+   double   tim = 0.;
    PthSct   *pth;
    ParSct   *par = (ParSct *)ParIdx;
    TypSct   *typ1, *typ2 = NULL;
    GrpSct   *grp;
+   RsvSct   rsv;
 
    // Get and check lib parallel instance
    if(!ParIdx)
@@ -511,8 +1312,22 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
       return(-1.);
    }
 
+   WaiAsy(par);
+
    typ1 =  &par->TypTab[ TypIdx1 ];
 
+   if(par->PrfFlg)
+      BegLch(par, prc, TypIdx1, TypIdx2);
+
+   // Pick the block level to run and time it
+   AutLvl = (TypIdx2 > 0) && par->DynSch && (typ1->NmbLvl > 1);
+
+   if(AutLvl)
+   {
+      ChsLvl(par, typ1);
+      tim = GetWallClock();
+   }
+
    // Launch small WP with static scheduling
    if( (TypIdx2 > 0) && !par->DynSch )
    {
@@ -520,15 +1335,11 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
 
       do
       {
-         // Lock acces to global parameters
-         pthread_mutex_lock(&par->ParMtx);
-
          par->cmd = RunDetWrk;
          par->prc = (void (*)(itg, itg, int, void *))prc;
          par->arg = PtrArg;
          par->typ1 = typ1;
          par->typ2 = NULL;
-         par->WrkCpt = 0;
 
          for(i=0;i<par->NmbCpu;i++)
          {
@@ -538,144 +1349,276 @@ float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
             acc += (float)grp->NmbSmlWrk[i];
          }
 
-         for(i=0;i<par->NmbCpu;i++)
-         {
-            pth = &par->PthTab[i];
-            pthread_mutex_lock(&pth->mtx);
-            pthread_cond_signal(&pth->cnd);
-            pthread_mutex_unlock(&pth->mtx);
-         }
-
-         pthread_cond_wait(&par->ParCnd, &par->ParMtx);
-
-         pthread_mutex_unlock(&par->ParMtx);
+         // Wake up all threads and wait for the group's completion
+         LchPth(par);
          grp = grp->nex;
       }while(grp);
 
       acc /= (float)(par->NmbSmlBlk * typ1->NmbGrp) / (float)WrkPerGrp;
    }
-   else if( (TypIdx2 > 0) && par->DynSch )
+   else if( (TypIdx2 > 0) && (par->DynSch == LfrSch) )
    {
-      // Launch small WP with dynamic scheduling
-
-      // Lock acces to global parameters
-      pthread_mutex_lock(&par->ParMtx);
-
-      par->cmd = RunSmlWrk;
+      // Launch small WP with lock-free dynamic scheduling
+      acc = LchLfr(par, typ1, TypIdx2, prc, PtrArg);
+   }
+   else if( (TypIdx2 > 0) && (par->DynSch == RsvSch) )
+   {
+      // Launch small WP in any order but the one of those sharing a block
+      par->cmd = RunRsvWrk;
       par->prc = (void (*)(itg, itg, int, void *))prc;
       par->arg = PtrArg;
       par->typ1 = typ1;
-      par->typ2 = typ2 = &par->TypTab[ TypIdx2 ];
-      par->NexWrk = typ1->SmlWrkTab;
-      par->BufCpt = 0;
-      par->WrkCpt = 0;
+      par->typ2 = &par->TypTab[ TypIdx2 ];
+      par->LfrRun = 0;
       par->sta[0] = par->sta[1] = 0.;
-      par->req = 0;
-      par->NmbDep = 0;
 
-      // Clear running wp
-      for(i=0;i<par->NmbCpu;i++)
-         par->PthTab[i].wrk = NULL;
+      // Close the launch record before giving up
+      if(!SetRsv(par, typ1, &rsv))
+      {
+         par->typ1 = 0;
 
-      ClrWrd(typ1->NmbDepWrd, typ1->RunDepTab);
+         if(AutLvl)
+            SetLvl(typ1, 0);
 
-      // Build a linked list of wp
-      for(i=0;i<par->typ1->NmbSmlWrk;i++)
-      {
-         typ1->SmlWrkTab[i].pre = &typ1->SmlWrkTab[ i-1 ];
-         typ1->SmlWrkTab[i].nex = &typ1->SmlWrkTab[ i+1 ];
+         if(par->PrfFlg)
+            EndLch(par, 0.);
+
+         return(-1.);
       }
 
-      typ1->SmlWrkTab[0].pre = typ1->SmlWrkTab[ typ1->NmbSmlWrk - 1 ].nex = NULL;
+      par->rsv = &rsv;
 
-      // Main loop: wake up threads and wait for completion or blocked threads
-      do
+      // Wake up all threads: they will pop the WP as they get released
+      LchPth(par);
+
+      for(i=0;i<par->NmbCpu;i++)
       {
-         // Search for some idle threads
-         par->req = 0;
+         par->sta[0] += par->PthTab[i].sta[0];
+         par->sta[1] += par->PthTab[i].sta[1];
+      }
 
-         for(i=0;i<par->NmbCpu;i++)
-         {
-            pth = &par->PthTab[i];
+      par->rsv = NULL;
+      FreRsv(par, &rsv);
 
-            if(pth->wrk)
-               continue;
+      acc = par->sta[0] ? (par->sta[1] / par->sta[0]) : 0;
+   }
+   else if( (TypIdx2 > 0) && par->DynSch )
+   {
+      // No threads may be lent or given back to a team while the master
+      // loop hands them WP, and while some are lent, the lock-free scheduling
+      // runs their share in their place
+      pthread_mutex_lock(&par->TemMtx);
 
-            if(!(pth->wrk = NexWrk(par, i)))
-            {
-               par->req = 1;
-               break;
-            }
+      if(AtmLod(&par->TemCpt))
+      {
+         pthread_mutex_unlock(&par->TemMtx);
+         acc = LchLfr(par, typ1, TypIdx2, prc, PtrArg);
+      }
+      else
+      {
+         // Launch small WP with dynamic scheduling
+
+         // Lock acces to global parameters
+         pthread_mutex_lock(&par->ParMtx);
+
+         par->cmd = RunSmlWrk;
+         par->prc = (void (*)(itg, itg, int, void *))prc;
+         par->arg = PtrArg;
+         par->typ1 = typ1;
+         par->typ2 = typ2 = &par->TypTab[ TypIdx2 ];
+         par->NexWrk = typ1->SmlWrkTab;
+         par->BufCpt = 0;
+         par->WrkCpt = 0;
+         par->sta[0] = par->sta[1] = 0.;
+         par->req = 0;
+         par->NmbDep = 0;
 
-            // Wake up the thread and provide it with a WP list
-            pthread_mutex_lock(&pth->mtx);
-            pthread_cond_signal(&pth->cnd);
-            pthread_mutex_unlock(&pth->mtx);
+         // Clear running wp
+         for(i=0;i<par->NmbCpu;i++)
+         {
+            par->PthTab[i].wrk = NULL;
+            par->PthTab[i].LocHit = par->PthTab[i].LocTry = 0;
          }
 
-         // If every WP are done : exit the parallel loop
-         if(par->WrkCpt == typ1->NmbSmlWrk)
-            break;
+         ClrWrd(typ1->NmbDepWrd, typ1->RunDepTab);
 
-         // Otherwise, wait for a blocked thread
-         pthread_cond_wait(&par->ParCnd, &par->ParMtx);
-      }while(1);
+         // Build a linked list of wp, the flag tells whether they are still in it
+         for(i=0;i<par->typ1->NmbSmlWrk;i++)
+         {
+            typ1->SmlWrkTab[i].pre = &typ1->SmlWrkTab[ i-1 ];
+            typ1->SmlWrkTab[i].nex = &typ1->SmlWrkTab[ i+1 ];
+            typ1->SmlWrkTab[i].flg = 0;
+         }
 
-      pthread_mutex_unlock(&par->ParMtx);
+         typ1->SmlWrkTab[0].pre = typ1->SmlWrkTab[ typ1->NmbSmlWrk - 1 ].nex = NULL;
 
-      // Compute the average concurrency factor
-      acc = par->sta[0] ? (par->sta[1] / par->sta[0]) : 0;
-   }
-   else if(!TypIdx2)
-   {
-      // Launch big WP with static scheduling
+         // Main loop: wake up threads and wait for completion or blocked threads
+         do
+         {
+            // Search for some idle threads
+            par->req = 0;
 
-      // Lock acces to global parameters
-      pthread_mutex_lock(&par->ParMtx);
+            for(i=0;i<par->NmbCpu;i++)
+            {
+               pth = &par->PthTab[i];
 
-      par->cmd = RunBigWrk;
+               if(pth->wrk)
+                  continue;
+
+               if(!(pth->wrk = NexWrk(par, i)))
+               {
+                  pth->NmbBlk++;
+                  par->req = 1;
+                  break;
+               }
+
+               // Wake up the thread and provide it with a WP list
+               WakPth(pth);
+            }
+
+            // If every WP are done : exit the parallel loop
+            if(par->WrkCpt == typ1->NmbSmlWrk)
+               break;
+
+            // Otherwise, wait for a blocked thread
+            pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+         }while(1);
+
+         pthread_mutex_unlock(&par->ParMtx);
+         pthread_mutex_unlock(&par->TemMtx);
+
+         // Compute the average concurrency factor
+         acc = par->sta[0] ? (par->sta[1] / par->sta[0]) : 0;
+      }
+   }
+   else if(!TypIdx2 && par->WrkStl)
+   {
+      // Launch big WP with work stealing: each thread starts with its own
+      // static range of lines split into chunks, blocks interleaving is ignored
+      par->cmd = RunStlWrk;
       par->prc = (void (*)(itg, itg, int, void *))prc;
       par->arg = PtrArg;
       par->typ1 = typ1;
       par->typ2 = NULL;
-      par->WrkCpt = 0;
+      par->StlChk = typ1->NmbLin / (par->NmbCpu * StlPerPth);
+
+      if(par->StlChk < 1)
+         par->StlChk = 1;
 
       for(i=0;i<par->NmbCpu;i++)
       {
          pth = &par->PthTab[i];
-         pth->wrk = &typ1->BigWrkTab[i];
+         pth->StlBeg = (itg)(((int64_t)typ1->NmbLin * i) / par->NmbCpu) + 1;
+         pth->StlEnd = (itg)(((int64_t)typ1->NmbLin * (i+1)) / par->NmbCpu);
+         pth->StlWrd = (pth->StlEnd - pth->StlBeg + par->StlChk) / par->StlChk;
       }
 
-      // Update block interleaving according to the current attributes
-      if( (par->NmbItlBlk != 1) || par->ItlBlkSiz)
-         SetItlBlk(par, typ1);
+      LchPth(par);
+
+      // Give the average concurrency factor against the slowest thread
+      acc = GetWorkStealingStats(ParIdx, NULL, NULL);
+      acc = acc ? (float)par->NmbCpu / acc : (float)par->NmbCpu;
+   }
+   else if(!TypIdx2)
+   {
+      // Launch big WP with static scheduling
+      par->cmd = RunBigWrk;
+      par->prc = (void (*)(itg, itg, int, void *))prc;
+      par->arg = PtrArg;
+      par->typ1 = typ1;
+      par->typ2 = NULL;
 
       for(i=0;i<par->NmbCpu;i++)
       {
          pth = &par->PthTab[i];
-         pthread_mutex_lock(&pth->mtx);
-         pthread_cond_signal(&pth->cnd);
-         pthread_mutex_unlock(&pth->mtx);
+         pth->big = &typ1->BigWrkTab[i];
       }
 
-      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+      // Update block interleaving according to the current attributes
+      if( (par->NmbItlBlk != 1) || par->ItlBlkSiz)
+         SetItlBlk(par, typ1);
 
-      pthread_mutex_unlock(&par->ParMtx);
+      LchPth(par);
 
       // Arbitrary set the average concurrency factor
       acc = (float)par->NmbCpu;
    }
    else
+   {
+      if(par->PrfFlg)
+         EndLch(par, 0.);
+
       return(-1.);
+   }
 
    // Clear the main datatyp loop to indicate that no LaunchParallel is running
    par->typ1 = 0;
 
-   // Return the concurrency factor
+   // Return the concurrency factor and bring back the finest WP so that
+   // the dependency and block queries always deal with level 0
+   if(AutLvl)
+   {
+      UpdLvl(typ1, GetWallClock() - tim, acc);
+      SetLvl(typ1, 0);
+   }
+
+   if(par->PrfFlg)
+      EndLch(par, acc);
+
    return(acc);
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Launch small WP with lock-free dynamic scheduling, which is also used      */
+/* while some threads are lent to a team as the master loop of the default    */
+/* scheduler would hand them WP                                               */
+/*----------------------------------------------------------------------------*/
+
+static float LchLfr(ParSct *par, TypSct *typ1, int TypIdx2, void *prc, void *PtrArg)
+{
+   int i;
+
+   par->cmd = RunLfrWrk;
+   par->prc = (void (*)(itg, itg, int, void *))prc;
+   par->arg = PtrArg;
+   par->typ1 = typ1;
+   par->typ2 = &par->TypTab[ TypIdx2 ];
+   par->LfrIdx = 0;
+   par->LfrRun = 0;
+   par->sta[0] = par->sta[1] = 0.;
+
+   // Tag all WP as available and clear the running tags
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+      typ1->SmlWrkTab[i].flg = 0;
+
+   ClrWrd(typ1->NmbDepWrd, typ1->RunDepTab);
+
+   // The master may join an asynchronous launch as an extra thread
+   AtmSto(&par->MstJoi, par->AsyJoi);
+
+   for(i=0;i<par->NmbCpu + par->MstJoi;i++)
+   {
+      par->PthTab[i].wrk = NULL;
+      par->PthTab[i].LocHit = par->PthTab[i].LocTry = 0;
+   }
+
+   // Wake up all threads: they will pick up the WP on their own
+   LchPth(par);
+
+   // Merge the threads' stats and compute the average concurrency factor
+   for(i=0;i<par->NmbCpu + par->MstJoi;i++)
+   {
+      par->sta[0] += par->PthTab[i].sta[0];
+      par->sta[1] += par->PthTab[i].sta[1];
+   }
+
+   AtmSto(&par->MstJoi, 0);
+
+   return(par->sta[0] ? (par->sta[1] / par->sta[0]) : 0);
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Launch a parallel procudure with variable arguments.                       */
 /* Arguments are passed as pointer to void.                                   */
@@ -689,9 +1632,11 @@ float LaunchParallelMultiArg( int64_t ParIdx, int TypIdx1, int TypIdx2,
    va_list ArgLst;
    ParSct *par = (ParSct *)ParIdx;
 
-   if(NmbArg > 20)
+   if(!ParIdx || (NmbArg > 20))
       return(-1.);
 
+   WaiAsy(par);
+
    par->NmbVarArg = NmbArg;
    va_start(ArgLst, NmbArg);
 
@@ -708,1823 +1653,7191 @@ float LaunchParallelMultiArg( int64_t ParIdx, int TypIdx1, int TypIdx2,
 
 
 /*----------------------------------------------------------------------------*/
-/* Pthread handler, waits for job, does it, then signal end                   */
+/* Launch a loop that reduces a RedSiz bytes variable: prc gets a pointer     */
+/* to its thread's cache line aligned scratch as a fifth argument             */
+/* The scratches are initialized to the operator's identity, or cleared for   */
+/* custom ones, and combined pairwise by the threads with CmbPrc(dst, src,    */
+/* PtrArg) or the built-in operator, the result is stored in res              */
 /*----------------------------------------------------------------------------*/
 
-static void *PthHdl(void *ptr)
+float LaunchParallelReduce(int64_t ParIdx, int TypIdx1, int TypIdx2,
+                           void *prc, void *PtrArg, int RedOpr,
+                           size_t RedSiz, void *CmbPrc, void *res)
 {
-   itg i, beg, end;
-   PthSct *pth = (PthSct *)ptr;
-   ParSct *par = pth->par;
-
-   // Tell the scheduler if all threads are ready
-   pthread_mutex_lock(&par->ParMtx);
-   par->WrkCpt++;
-   pthread_cond_signal(&par->ParCnd);
-   pthread_mutex_lock(&pth->mtx);
-   pthread_mutex_unlock(&par->ParMtx);
+   int i;
+   size_t EleSiz, SlbSiz;
+   float acc;
+   char *NewTab;
+   void *NewAdr;
+   RedSct arg;
+   ParSct *par = (ParSct *)ParIdx;
 
-   // Enter main loop until StopParallel is send
-   do
+   // Get and check lib parallel instance and the reduction operator
+   if( !ParIdx || !prc || !res || !RedSiz || par->RedFlg
+   ||  (RedOpr < ReduceSumDouble) || (RedOpr > ReduceCustom)
+   ||  ((RedOpr == ReduceCustom) && !CmbPrc) )
    {
-      // Wait for a wake-up signal from the main loop
-      pthread_cond_wait(&pth->cnd, &pth->mtx);
+      return(-1.);
+   }
 
-      // Update stats
-      par->sta[0]++;
+   if(RedOpr <= ReduceMaxDouble)
+      EleSiz = sizeof(double);
+   else if(RedOpr <= ReduceMaxFloat)
+      EleSiz = sizeof(float);
+   else if(RedOpr <= ReduceMaxItg)
+      EleSiz = sizeof(itg);
+   else
+      EleSiz = 1;
 
-      for(i=0;i<par->NmbCpu;i++)
-         if(par->PthTab[i].wrk)
-            par->sta[1]++;
+   if(RedSiz % EleSiz)
+      return(-1.);
 
-      switch(par->cmd)
-      {
-         // Call user's procedure with big WP
-         case RunBigWrk :
-         {
-            // Loop over the interleaved blocks
-            for(i=0;i<par->NmbItlBlk;i++)
-            {
-               beg = pth->wrk->ItlTab[i][0];
-               end = pth->wrk->ItlTab[i][1];
+   WaiAsy(par);
 
-               if(!beg || !end || (end < beg))
-                  continue;
+   // Each thread's scratch lies on its own cache lines
+   SlbSiz = (RedSiz + CacLin - 1) / CacLin * CacLin;
 
-               // Launch a single big wp and signal completion to the scheduler
-               if(par->NmbVarArg)
-                  CalVarArgPrc(beg, end, pth->idx, par);
-               else
-                  par->prc(beg, end, pth->idx, par->arg);
-            }
+   if(par->NmbCpu * SlbSiz > par->RedMax)
+   {
+      if(!(NewTab = LPL_aligned_calloc(par->lmb, par->NmbCpu * SlbSiz, &NewAdr)))
+         return(-1.);
 
-            pthread_mutex_lock(&par->ParMtx);
-            par->WrkCpt++;
+      if(par->RedAdr)
+         LPL_free(par->lmb, par->RedAdr);
 
-            if(par->WrkCpt >= par->NmbCpu)
-               pthread_cond_signal(&par->ParCnd);
+      par->RedTab = NewTab;
+      par->RedAdr = NewAdr;
+      par->RedMax = par->NmbCpu * SlbSiz;
+   }
 
-            pthread_mutex_unlock(&par->ParMtx);
-         }break;
+   for(i=0;i<par->NmbCpu;i++)
+      IniRed(RedOpr, RedSiz, &par->RedTab[ i * SlbSiz ]);
 
-         // Call user's procedure with small WP using dynamic scheduling
-         case RunSmlWrk :
-         {
-            do
-            {
-               // Run the WP
-               if(par->NmbVarArg)
-                  CalVarArgPrc(pth->wrk->BegIdx, pth->wrk->EndIdx, pth->idx, par);
-               else
-                  par->prc(pth->wrk->BegIdx, pth->wrk->EndIdx, pth->idx, par->arg);
+   // Run the user's loop
+   par->RedSlb = SlbSiz;
+   par->RedFlg = 1;
+   acc = LaunchParallel(ParIdx, TypIdx1, TypIdx2, prc, PtrArg);
+   par->RedFlg = 0;
 
-               // Locked acces to global parameters: 
-               // update WP count, tag WP done and signal the main loop
-               pthread_mutex_lock(&par->ParMtx);
+   if(acc < 0.)
+      return(acc);
 
-               par->WrkCpt++;
+   // Each round combines pairs of scratches stp threads apart
+   arg.opr = RedOpr;
+   arg.siz = RedSiz;
+   arg.SlbSiz = SlbSiz;
+   arg.tab = par->RedTab;
+   arg.cmb = (void (*)(void *, void *, void *))CmbPrc;
+   arg.arg = PtrArg;
 
-               if(!(pth->wrk = NexWrk(par, pth->idx)))
-               {
-                  par->req = 1;
-                  pthread_cond_signal(&par->ParCnd);
-                  pthread_mutex_unlock(&par->ParMtx);
-                  break;
-               }
+   for(arg.stp=1; arg.stp < par->NmbCpu; arg.stp *= 2)
+      RunPth(par, (void *)RedPrc, (void *)&arg);
 
-               if(par->req)
-                  pthread_cond_signal(&par->ParCnd);
+   memcpy(res, par->RedTab, RedSiz);
 
-               pthread_mutex_unlock(&par->ParMtx);
-            }while(1);
-         }break;
+   return(acc);
+}
 
-         // Call user's procedure with small WP using static scheduling
-         case RunDetWrk :
-         {
-            // Loop over the groups' WP
-            for(i=0;i<pth->NmbDetWrk;i++)
-            {
-               beg = pth->DetWrkTab[i]->BegIdx;
-               end = pth->DetWrkTab[i]->EndIdx;
 
-               if(par->NmbVarArg)
-                  CalVarArgPrc(beg, end, pth->idx, par);
-               else
-                  par->prc(beg, end, pth->idx, par->arg);
-            }
+/*----------------------------------------------------------------------------*/
+/* Set a scratch to the identity of the reduction operator                    */
+/*----------------------------------------------------------------------------*/
 
-            pthread_mutex_lock(&par->ParMtx);
-            par->WrkCpt++;
+static void IniRed(int opr, size_t siz, char *tab)
+{
+   size_t i;
+   double *DblTab = (double *)tab;
+   float *FltTab = (float *)tab;
+   itg *ItgTab = (itg *)tab;
 
-            if(par->WrkCpt >= par->NmbCpu)
-               pthread_cond_signal(&par->ParCnd);
+   switch(opr)
+   {
+      case ReduceMinDouble :
+         for(i=0;i<siz/sizeof(double);i++)
+            DblTab[i] = DBL_MAX;
+         break;
 
-            pthread_mutex_unlock(&par->ParMtx);
-         }break;
+      case ReduceMaxDouble :
+         for(i=0;i<siz/sizeof(double);i++)
+            DblTab[i] = -DBL_MAX;
+         break;
 
-         case ClrMem :
-         {
-            // Clear memory and signal completion to the scheduler
-            memset(pth->ClrAdr, 0, par->ClrLinSiz);
+      case ReduceMinFloat :
+         for(i=0;i<siz/sizeof(float);i++)
+            FltTab[i] = FLT_MAX;
+         break;
 
-            pthread_mutex_lock(&par->ParMtx);
-            par->WrkCpt++;
-            pthread_cond_signal(&par->ParCnd);
-            pthread_mutex_unlock(&par->ParMtx);
-         }break;
+      case ReduceMaxFloat :
+         for(i=0;i<siz/sizeof(float);i++)
+            FltTab[i] = -FLT_MAX;
+         break;
 
-         case EndPth :
-         {
-            // Destroy the thread mutex and condition and call for join
-            pthread_mutex_unlock(&pth->mtx);
-            pthread_mutex_destroy(&pth->mtx);
-            pthread_cond_destroy(&pth->cnd);
-            return(NULL);
-         }break;
-      }
-   }while(1);
+      case ReduceMinItg :
+         for(i=0;i<siz/sizeof(itg);i++)
+            ItgTab[i] = MaxItg;
+         break;
 
-   return(NULL);
+      case ReduceMaxItg :
+         for(i=0;i<siz/sizeof(itg);i++)
+            ItgTab[i] = MinItg;
+         break;
+
+      default :
+         memset(tab, 0, siz);
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Get the next WP to be computed                                             */
+/* Combine the scratch of thread PthIdx + stp into thread PthIdx's one        */
 /*----------------------------------------------------------------------------*/
 
-static WrkSct *NexWrk(ParSct *par, int PthIdx)
+static void RedPrc(itg BegIdx, itg EndIdx, int PthIdx, RedSct *arg)
 {
-   PthSct *pth = &par->PthTab[ PthIdx ];
-   WrkSct *wrk;
+   int lft = 2 * PthIdx * arg->stp, rgt = lft + arg->stp;
+   size_t i;
+   double *DblDst, *DblSrc;
+   float *FltDst, *FltSrc;
+   itg *ItgDst, *ItgSrc;
+   (void)(BegIdx);
+
+   if(rgt > EndIdx)
+      return;
 
-   // Remove previous work's tags
-   if(pth->wrk)
-      SubWrd(par->typ1->NmbDepWrd, pth->wrk->DepWrdTab, par->typ1->RunDepTab);
+   DblDst = (double *)&arg->tab[ lft * arg->SlbSiz ];
+   DblSrc = (double *)&arg->tab[ rgt * arg->SlbSiz ];
+   FltDst = (float *)DblDst;
+   FltSrc = (float *)DblSrc;
+   ItgDst = (itg *)DblDst;
+   ItgSrc = (itg *)DblSrc;
 
-   // If the wp's buffer is empty search for some new compatible wp to fill in
-   if(!par->BufCpt)
+   switch(arg->opr)
    {
-      wrk = par->NexWrk;
+      case ReduceSumDouble :
+         for(i=0;i<arg->siz/sizeof(double);i++)
+            DblDst[i] += DblSrc[i];
+         break;
 
-      while(wrk)
-      {
-         // Check for dependencies
-         if(!AndWrd(par->typ1->NmbDepWrd, wrk->DepWrdTab, par->typ1->RunDepTab))
-         {
-            par->BufWrk[ par->BufCpt++ ] = wrk;
+      case ReduceMinDouble :
+         for(i=0;i<arg->siz/sizeof(double);i++)
+            DblDst[i] = (DblSrc[i] < DblDst[i]) ? DblSrc[i] : DblDst[i];
+         break;
 
-            // Unlink wp
-            if(wrk->pre)
-               wrk->pre->nex = wrk->nex;
-            else
-               par->NexWrk = wrk->nex;
+      case ReduceMaxDouble :
+         for(i=0;i<arg->siz/sizeof(double);i++)
+            DblDst[i] = (DblSrc[i] > DblDst[i]) ? DblSrc[i] : DblDst[i];
+         break;
 
-            if(wrk->nex)
-               wrk->nex->pre = wrk->pre;
+      case ReduceSumFloat :
+         for(i=0;i<arg->siz/sizeof(float);i++)
+            FltDst[i] += FltSrc[i];
+         break;
 
-            // Add new work's tags
-            AddWrd(par->typ1->NmbDepWrd, wrk->DepWrdTab, par->typ1->RunDepTab);
+      case ReduceMinFloat :
+         for(i=0;i<arg->siz/sizeof(float);i++)
+            FltDst[i] = (FltSrc[i] < FltDst[i]) ? FltSrc[i] : FltDst[i];
+         break;
 
-            if(par->BufCpt == par->BufMax)
-               break;
-         }
+      case ReduceMaxFloat :
+         for(i=0;i<arg->siz/sizeof(float);i++)
+            FltDst[i] = (FltSrc[i] > FltDst[i]) ? FltSrc[i] : FltDst[i];
+         break;
 
-         wrk = wrk->nex;
-      }
-   }
+      case ReduceSumItg :
+         for(i=0;i<arg->siz/sizeof(itg);i++)
+            ItgDst[i] += ItgSrc[i];
+         break;
 
-   // Return the next available wp in buffer and unlink it from the todo list
-   return(par->BufCpt ? par->BufWrk[ --par->BufCpt ] : NULL);
+      case ReduceMinItg :
+         for(i=0;i<arg->siz/sizeof(itg);i++)
+            ItgDst[i] = (ItgSrc[i] < ItgDst[i]) ? ItgSrc[i] : ItgDst[i];
+         break;
+
+      case ReduceMaxItg :
+         for(i=0;i<arg->siz/sizeof(itg);i++)
+            ItgDst[i] = (ItgSrc[i] > ItgDst[i]) ? ItgSrc[i] : ItgDst[i];
+         break;
+
+      default :
+         arg->cmb(DblDst, DblSrc, arg->arg);
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Allocate a new kind of elements and set work-packages                      */
+/* Queue a loop to be run by LaunchQueuedLoops, all queued loops must share   */
+/* the same TypIdx1 and the loops with dependencies must use the TypIdx2     */
+/* typ1's dependencies were built against                                     */
+/* Returns the number of queued loops or 0 on failure                         */
 /*----------------------------------------------------------------------------*/
 
-int NewType(int64_t ParIdx, itg NmbLin)
+int QueueParallelLoop(  int64_t ParIdx, int TypIdx1, int TypIdx2,
+                        void *prc, void *PtrArg )
 {
-   int      TypIdx = 0;
-   itg      i, idx, BigWrkSiz, NmbBigWrk;
-   TypSct   *typ;
-   ParSct   *par = (ParSct *)ParIdx;
+   StgSct *stg;
+   ParSct *par = (ParSct *)ParIdx;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
+   // Get and check lib parallel instance, the types and the queue's size
+   if( !ParIdx || !prc || (par->NmbStg >= MaxStg)
+   ||  (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 0)
+   ||  (TypIdx2 > MaxTyp) || (TypIdx1 == TypIdx2)
+   ||  !par->TypTab[ TypIdx1 ].NmbLin
+   ||  (par->NmbStg && (par->StgTyp != TypIdx1)) )
+   {
       return(0);
+   }
 
-   if(NmbLin <= 0)
-      return(0);
+   WaiAsy(par);
 
-   // Search for a free type structure
-   for(i=1;i<=MaxTyp;i++)
-      if(!par->TypTab[i].NmbLin)
+   par->StgTyp = TypIdx1;
+   stg = &par->StgTab[ par->NmbStg++ ];
+   stg->TypIdx2 = TypIdx2;
+   stg->prc = prc;
+   stg->arg = PtrArg;
+
+   return(par->NmbStg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run all queued loops in a single launch and empty the queue                */
+/* A WP of loop N+1 starts as soon as the same WP is done with loop N, and    */
+/* for loops with dependencies, once all WP sharing a dependency block with   */
+/* it are done with loop N as well, instead of waiting for the whole loop N   */
+/* Returns the average number of concurrently running WP, or 0 on failure     */
+/*----------------------------------------------------------------------------*/
+
+float LaunchQueuedLoops(int64_t ParIdx)
+{
+   int i;
+   FusSct fus;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance and the queue
+   if(!ParIdx || !par->NmbStg)
+      return(0.);
+
+   WaiAsy(par);
+
+   memset(&fus, 0, sizeof(FusSct));
+   fus.NmbStg = par->NmbStg;
+   fus.StgTab = par->StgTab;
+   fus.typ = &par->TypTab[ par->StgTyp ];
+   par->NmbStg = 0;
+
+   if(!IniFus(par, &fus))
+      return(0.);
+
+   if(par->PrfFlg)
+      BegLch(par, fus.StgTab[0].prc, par->StgTyp, 0);
+
+   // The first stage of all WP may start, except for dependency conflicts
+   for(i=0;i<fus.NmbWrk;i++)
+      if(ChkFus(&fus, i))
       {
-         TypIdx = i;
-         break;
+         fus.QueTab[ fus.QueEnd ] = i;
+         fus.QueEnd = (fus.QueEnd + 1) % fus.NmbWrk;
+         fus.NmbQue++;
       }
 
-   if(!TypIdx)
-      return(0);
+   pthread_mutex_init(&fus.mtx, NULL);
+   pthread_cond_init(&fus.cnd, NULL);
 
-   typ = &par->TypTab[ TypIdx ];
-   typ->NmbLin = NmbLin;
-   typ->MaxNmbLin = NmbLin * par->SizMul;
-   typ->NexGrp = NULL;
+   par->cmd = RunFusWrk;
+   par->fus = &fus;
+   par->typ1 = fus.typ;
+   par->typ2 = NULL;
 
-   // Compute the size of small work-packages
-   if(NmbLin >= par->NmbSmlBlk * par->NmbCpu)
-   {
-      typ->SmlWrkSiz = NmbLin / (par->NmbSmlBlk * par->NmbCpu);
-      typ->NmbSmlWrk = NmbLin / typ->SmlWrkSiz;
+   // Wake up all threads and wait for the completion of all stages
+   LchPth(par);
 
-      if(NmbLin != typ->NmbSmlWrk * typ->SmlWrkSiz)
-         typ->NmbSmlWrk++;
-   }
-   else
-   {
-      typ->SmlWrkSiz = NmbLin;
-      typ->NmbSmlWrk = 1;
-   }
+   par->typ1 = NULL;
+   par->fus = NULL;
+   pthread_mutex_destroy(&fus.mtx);
+   pthread_cond_destroy(&fus.cnd);
+   FreFus(par, &fus);
 
-   if(!(typ->SmlWrkTab = LPL_calloc(par->lmb, typ->NmbSmlWrk * par->SizMul , sizeof(WrkSct))))
-      return(0);
+   if(par->PrfFlg)
+      EndLch(par, (float)(fus.NmbPck ? fus.acc / fus.NmbPck : 0.));
 
-   // Set small work-packages
-   idx = 0;
+   return((float)(fus.NmbPck ? fus.acc / fus.NmbPck : 0.));
+}
 
-   for(i=0;i<typ->NmbSmlWrk;i++)
+
+/*----------------------------------------------------------------------------*/
+/* Allocate the scheduling tables and list the dependency blocks of each WP,  */
+/* and the WP referring to each block                                         */
+/*----------------------------------------------------------------------------*/
+
+static int IniFus(ParSct *par, FusSct *fus)
+{
+   int i, j, k, b, NmbRef = 0;
+   uint64_t wrd;
+   TypSct *typ = fus->typ;
+   WrkSct *wrk;
+
+   fus->NmbWrk = typ->NmbSmlWrk;
+   fus->NmbBlk = typ->NmbDepWrd * 64;
+   fus->TotCpt = (int64_t)fus->NmbWrk * fus->NmbStg;
+
+   if( !(fus->WrkStg = LPL_calloc(par->lmb, fus->NmbWrk, sizeof(int)))
+   ||  !(fus->WrkSta = LPL_calloc(par->lmb, fus->NmbWrk, sizeof(int)))
+   ||  !(fus->QueTab = LPL_malloc(par->lmb, fus->NmbWrk * sizeof(int)))
+   ||  !(fus->WrkBlkBeg = LPL_calloc(par->lmb, fus->NmbWrk + 1, sizeof(int)))
+   ||  !(fus->BlkWrkBeg = LPL_calloc(par->lmb, fus->NmbBlk + 1, sizeof(int)))
+   ||  !(fus->RunBlk = LPL_calloc(par->lmb, fus->NmbBlk + 1, sizeof(char)))
+   ||  !(fus->BlkPen = LPL_malloc(par->lmb, (fus->NmbStg * fus->NmbBlk + 1) * sizeof(int))) )
    {
-      typ->SmlWrkTab[i].BegIdx = idx + 1;
-      typ->SmlWrkTab[i].EndIdx = idx + typ->SmlWrkSiz;
-      idx += typ->SmlWrkSiz;
+      FreFus(par, fus);
+      return(0);
    }
 
-   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].EndIdx = NmbLin;
+   // Count the blocks of each WP and the WP of each block (compressed rows)
+   for(k=0;k<2;k++)
+   {
+      for(i=0;i<fus->NmbWrk;i++)
+      {
+         wrk = &typ->SmlWrkTab[i];
 
-   // Compute the size of big work-packages
-   if(!(typ->BigWrkTab = LPL_calloc(par->lmb, par->NmbCpu * par->SizMul , sizeof(WrkSct))))
-      return(0);
+         for(j=0; j < (typ->SpsFlg ? wrk->NmbSps : (wrk->DepWrdTab ? typ->NmbDepWrd : 0)); j++)
+         {
+            wrd = typ->SpsFlg ? wrk->SpsMsk[j] : wrk->DepWrdTab[j];
 
-   // Compute the size of big work-packages
-	if(NmbLin >= par->NmbCpu)
-	{
-		BigWrkSiz = NmbLin / par->NmbCpu;
-		NmbBigWrk = par->NmbCpu;
-	}
-	else
-	{
-		BigWrkSiz = NmbLin;
-		NmbBigWrk = 1;
-	}
+            while(wrd)
+            {
+               b = 64 * (typ->SpsFlg ? wrk->SpsIdx[j] : j) + BitCtz(wrd);
+               wrd &= wrd - 1;
 
-	// Set big work-packages
-	idx = 0;
+               if(!k)
+               {
+                  fus->WrkBlkBeg[ i+1 ]++;
+                  fus->BlkWrkBeg[ b+1 ]++;
+                  NmbRef++;
+               }
+               else
+               {
+                  fus->WrkBlkTab[ fus->WrkBlkBeg[i]++ ] = b;
+                  fus->BlkWrkTab[ fus->BlkWrkBeg[b]++ ] = i;
+               }
+            }
+         }
+      }
 
-	for(i=0;i<NmbBigWrk;i++)
-	{
-		typ->BigWrkTab[i].ItlTab[0][0] = idx + 1;
-		typ->BigWrkTab[i].ItlTab[0][1] = idx + BigWrkSiz;
-		idx += BigWrkSiz;
-	}
+      if(!k)
+      {
+         for(i=0;i<fus->NmbWrk;i++)
+            fus->WrkBlkBeg[ i+1 ] += fus->WrkBlkBeg[i];
 
-	typ->BigWrkTab[ NmbBigWrk - 1 ].ItlTab[0][1] = NmbLin;
+         for(i=0;i<fus->NmbBlk;i++)
+            fus->BlkWrkBeg[ i+1 ] += fus->BlkWrkBeg[i];
 
-   return(TypIdx);
+         if( !(fus->WrkBlkTab = LPL_malloc(par->lmb, (NmbRef + 1) * sizeof(int)))
+         ||  !(fus->BlkWrkTab = LPL_malloc(par->lmb, (NmbRef + 1) * sizeof(int))) )
+         {
+            FreFus(par, fus);
+            return(0);
+         }
+      }
+   }
+
+   // The filling pass shifted the row starts by one row
+   for(i=fus->NmbWrk;i>0;i--)
+      fus->WrkBlkBeg[i] = fus->WrkBlkBeg[ i-1 ];
+
+   for(i=fus->NmbBlk;i>0;i--)
+      fus->BlkWrkBeg[i] = fus->BlkWrkBeg[ i-1 ];
+
+   fus->WrkBlkBeg[0] = fus->BlkWrkBeg[0] = 0;
+
+   // Each block waits for all its WP at each stage
+   for(i=0;i<fus->NmbStg;i++)
+      for(b=0;b<fus->NmbBlk;b++)
+         fus->BlkPen[ i * fus->NmbBlk + b ] = fus->BlkWrkBeg[ b+1 ] - fus->BlkWrkBeg[b];
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Resize a data type up to a two fold increase                               */
+/* Free the scheduling tables                                                 */
 /*----------------------------------------------------------------------------*/
 
-int ResizeType(int64_t ParIdx, int TypIdx, itg NmbLin)
+static void FreFus(ParSct *par, FusSct *fus)
 {
-   itg      i, idx, BigWrkSiz, NmbBigWrk;
-   TypSct   *typ;
-   ParSct   *par = (ParSct *)ParIdx;
+   if(fus->WrkStg)
+      LPL_free(par->lmb, fus->WrkStg);
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
+   if(fus->WrkSta)
+      LPL_free(par->lmb, fus->WrkSta);
 
-   // Check bounds and free mem
-   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
-      return(0);
+   if(fus->QueTab)
+      LPL_free(par->lmb, fus->QueTab);
 
-   typ = &par->TypTab[ TypIdx ];
+   if(fus->WrkBlkBeg)
+      LPL_free(par->lmb, fus->WrkBlkBeg);
 
-   if( (NmbLin < typ->NmbLin) || (NmbLin > typ->MaxNmbLin) )
-      return(0);
+   if(fus->WrkBlkTab)
+      LPL_free(par->lmb, fus->WrkBlkTab);
 
-   // Set small work-packages
-   i = typ->NmbSmlWrk;
-   idx = typ->NmbLin;
-   typ->NmbLin = NmbLin;
+   if(fus->BlkWrkBeg)
+      LPL_free(par->lmb, fus->BlkWrkBeg);
 
-   while(idx < NmbLin)
-   {
-      typ->SmlWrkTab[i].BegIdx = idx + 1;
-      typ->SmlWrkTab[i].EndIdx = idx + typ->SmlWrkSiz;
-      i++;
-      idx += typ->SmlWrkSiz;
-      typ->NmbSmlWrk++;
-   }
+   if(fus->BlkWrkTab)
+      LPL_free(par->lmb, fus->BlkWrkTab);
 
-   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].EndIdx = NmbLin;
+   if(fus->RunBlk)
+      LPL_free(par->lmb, fus->RunBlk);
 
-   // Compute the size of big work-packages
-	if(NmbLin >= par->NmbCpu)
-	{
-		BigWrkSiz = NmbLin / par->NmbCpu;
-		NmbBigWrk = par->NmbCpu;
-	}
-	else
-	{
-		BigWrkSiz = NmbLin;
-		NmbBigWrk = 1;
-	}
+   if(fus->BlkPen)
+      LPL_free(par->lmb, fus->BlkPen);
+}
 
-	// Set big work-packages
-	idx = 0;
 
-	for(i=0;i<NmbBigWrk;i++)
-	{
-		typ->BigWrkTab[i].ItlTab[0][0] = idx + 1;
-		typ->BigWrkTab[i].ItlTab[0][1] = idx + BigWrkSiz;
-		idx += BigWrkSiz;
-	}
+/*----------------------------------------------------------------------------*/
+/* Check whether WP w may run its next stage and claim its blocks if so       */
+/* Must be called with the fused launch's mutex locked                        */
+/*----------------------------------------------------------------------------*/
 
-	typ->BigWrkTab[ NmbBigWrk - 1 ].ItlTab[0][1] = NmbLin;
+static int ChkFus(FusSct *fus, int w)
+{
+   int i, stg = fus->WrkStg[w];
 
-   return(TypIdx);
+   if( (stg >= fus->NmbStg) || fus->WrkSta[w] )
+      return(0);
+
+   if(fus->StgTab[ stg ].TypIdx2 > 0)
+   {
+      // All WP sharing a block must be done with the previous stage
+      // and none of them may be running a stage with dependencies
+      for(i=fus->WrkBlkBeg[w]; i<fus->WrkBlkBeg[ w+1 ]; i++)
+         if( fus->RunBlk[ fus->WrkBlkTab[i] ]
+         ||  (stg && fus->BlkPen[ (stg-1) * fus->NmbBlk + fus->WrkBlkTab[i] ]) )
+         {
+            return(0);
+         }
+
+      for(i=fus->WrkBlkBeg[w]; i<fus->WrkBlkBeg[ w+1 ]; i++)
+         fus->RunBlk[ fus->WrkBlkTab[i] ] = 1;
+   }
+
+   fus->WrkSta[w] = 1;
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Set big work blocks interleaving                                           */
+/* Release a WP's stage and queue the WP of its blocks that became ready      */
+/* Returns the WP's own next stage if it may run right away, -1 otherwise     */
+/* Must be called with the fused launch's mutex locked                        */
 /*----------------------------------------------------------------------------*/
 
-static void SetItlBlk(ParSct *par, TypSct *typ)
+static int EndFus(FusSct *fus, int w)
 {
-   itg      i, j, BegIdx, EndIdx, CpuIdx = 0, PagIdx[ MaxPth ] = {0};
-   double   ItlSiz, ItlIdx = 0.;
+   int i, j, b, nxt, stg = fus->WrkStg[w];
 
-   // Set big WP interleaved indices and block sizes if requested
-   if(par->NmbItlBlk)
-      ItlSiz = (double)typ->NmbLin / (double)(par->NmbItlBlk * par->NmbCpu);
-   else if(par->ItlBlkSiz)
+   for(i=fus->WrkBlkBeg[w]; i<fus->WrkBlkBeg[ w+1 ]; i++)
    {
-      par->NmbItlBlk = typ->NmbLin / (par->ItlBlkSiz * par->NmbCpu);
-      ItlSiz = (double)par->ItlBlkSiz;
-   }
+      b = fus->WrkBlkTab[i];
+      fus->BlkPen[ stg * fus->NmbBlk + b ]--;
 
-   // In case the block or lines numbers is too small, deactivate interleaving
-   if(!par->NmbItlBlk || !ItlSiz)
-   {
-      par->NmbItlBlk = 1;
-      ItlSiz = (double)typ->NmbLin / (double)(par->NmbCpu);
+      if(fus->StgTab[ stg ].TypIdx2 > 0)
+         fus->RunBlk[b] = 0;
    }
 
-   for(i=0;i<par->NmbCpu;i++)
+   fus->WrkStg[w]++;
+   fus->WrkSta[w] = 0;
+   fus->DonCpt++;
+
+   // Keep the WP with its thread for the next stage, its data is in cache
+   nxt = ChkFus(fus, w) ? w : -1;
+
+   for(i=fus->WrkBlkBeg[w]; i<fus->WrkBlkBeg[ w+1 ]; i++)
    {
-      for(j=0;j<par->NmbItlBlk;j++)
-      {
-         BegIdx = (itg)(ItlIdx + 1.);
-         EndIdx = (itg)(ItlIdx + ItlSiz);
-         ItlIdx += ItlSiz;
+      b = fus->WrkBlkTab[i];
 
-         if(BegIdx <= EndIdx)
+      for(j=fus->BlkWrkBeg[b]; j<fus->BlkWrkBeg[ b+1 ]; j++)
+         if( (fus->BlkWrkTab[j] != w) && ChkFus(fus, fus->BlkWrkTab[j]) )
          {
-            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][0] = BegIdx;
-            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][1] = EndIdx;
-            PagIdx[ CpuIdx ]++;
-            CpuIdx++;
-            CpuIdx = CpuIdx % par->NmbCpu;
+            fus->QueTab[ fus->QueEnd ] = fus->BlkWrkTab[j];
+            fus->QueEnd = (fus->QueEnd + 1) % fus->NmbWrk;
+            fus->NmbQue++;
          }
-      }
    }
 
-   typ->BigWrkTab[ par->NmbCpu - 1 ].ItlTab[ par->NmbItlBlk - 1 ][1] = typ->NmbLin;
+   return(nxt);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Add this kind of element to the free-list                                  */
+/* Pick up the ready WP, run their current stage and release them             */
 /*----------------------------------------------------------------------------*/
 
-void FreeType(int64_t ParIdx, int TypIdx)
+static void FusWrk(PthSct *pth)
 {
-   TypSct *typ;
-   ParSct *par = (ParSct *)ParIdx;
-   GrpSct *grp, *NexGrp;
+   int w = -1, stg, OldQue;
+   ParSct *par = pth->par;
+   FusSct *fus = par->fus;
+   WrkSct *wrk;
+   StgSct *cur;
+   EvtSct evt;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return;
+   pthread_mutex_lock(&fus->mtx);
 
-   // Check bounds and free mem
-   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
-      return;
+   for(;;)
+   {
+      if(w < 0)
+      {
+         while(!fus->NmbQue && (fus->DonCpt < fus->TotCpt))
+            pthread_cond_wait(&fus->cnd, &fus->mtx);
 
-   typ = &par->TypTab[ TypIdx ];
+         if(fus->DonCpt >= fus->TotCpt)
+            break;
 
-   if(typ->SmlWrkTab)
-      LPL_free(par->lmb, typ->SmlWrkTab);
+         w = fus->QueTab[ fus->QueBeg ];
+         fus->QueBeg = (fus->QueBeg + 1) % fus->NmbWrk;
+         fus->NmbQue--;
+      }
 
-   if(typ->BigWrkTab)
-      LPL_free(par->lmb, typ->BigWrkTab);
+      stg = fus->WrkStg[w];
+      fus->RunCpt++;
+      fus->acc += fus->RunCpt;
+      fus->NmbPck++;
+      pthread_mutex_unlock(&fus->mtx);
 
-   if(typ->RunDepTab)
-      LPL_free(par->lmb, typ->RunDepTab);
+      // Run the stage's procedure on the WP
+      wrk = &fus->typ->SmlWrkTab[w];
+      cur = &fus->StgTab[ stg ];
 
-   if(typ->DepWrdMat)
-      LPL_free(par->lmb, typ->DepWrdMat);
+      if(par->PrfFlg)
+         evt.beg = GetWallClock();
 
-   NexGrp = typ->NexGrp;
+      ((void (*)(itg, itg, int, void *))cur->prc)(wrk->BegIdx, wrk->EndIdx, pth->idx, cur->arg);
 
-   while((grp = NexGrp))
-   {
-      NexGrp = grp->nex;
-      LPL_free(par->lmb, grp);
+      if(par->PrfFlg)
+      {
+         evt.end = GetWallClock();
+         evt.BegIdx = wrk->BegIdx;
+         evt.EndIdx = wrk->EndIdx;
+         evt.lch = par->CurLch;
+         evt.tid = pth->idx;
+         AddEvt(&pth->EvtTab, &pth->NmbEvt, &pth->MaxEvt, &evt);
+      }
+
+      pthread_mutex_lock(&fus->mtx);
+      fus->RunCpt--;
+      OldQue = fus->NmbQue;
+      w = EndFus(fus, w);
+
+      // Wake the idle threads if some WP were queued or if all is done
+      if( (fus->NmbQue > OldQue) || (fus->DonCpt >= fus->TotCpt) )
+         pthread_cond_broadcast(&fus->cnd);
    }
 
-   memset(typ, 0, sizeof(TypSct));
+   pthread_mutex_unlock(&fus->mtx);
+   DonPth(par);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Allocate a dependency matrix linking both types                            */
+/* Queue a LaunchParallel to be run by a helper thread and return at once     */
+/* with a handle to be given to TestParallel or WaitParallel                  */
+/* If JoiFlg is set and lock-free scheduling is used, the master thread runs  */
+/* WP as thread NmbCpu when it calls TestParallel or WaitParallel, thus prc's */
+/* PthIdx may range up to NmbCpu and the launch completes once the master     */
+/* called one of them                                                         */
+/* The calls driving the threads or changing the types, dependencies, work    */
+/* lists or attributes wait for the pending launches first                    */
+/* Returns 0 on failure                                                       */
 /*----------------------------------------------------------------------------*/
 
-int BeginDependency(int64_t ParIdx, int TypIdx1, int TypIdx2)
+int64_t LaunchParallelAsync(  int64_t ParIdx, int TypIdx1, int TypIdx2,
+                              void *prc, void *PtrArg, int JoiFlg )
 {
-   int i;
-   TypSct *typ1, *typ2;
+   int64_t hdl;
+   AsySct *req;
    ParSct *par = (ParSct *)ParIdx;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
-
-   // Check bounds
-   par->CurTyp = typ1 = &par->TypTab[ TypIdx1 ];
-   par->DepTyp = typ2 = &par->TypTab[ TypIdx2 ];
-
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin || !typ2->NmbLin)
+   // Get and check lib parallel instance and bounds
+   if( !ParIdx || !prc || (TypIdx1 < 1) || (TypIdx1 > MaxTyp)
+   ||  (TypIdx2 > MaxTyp) || (TypIdx1 == TypIdx2) )
    {
       return(0);
    }
 
-   // Compute dependency table's size
-   if( (typ2->NmbLin >= par->NmbDepBlk * par->NmbCpu)
-   &&  (typ2->NmbLin >= typ1->DepWrkSiz * 32) )
-   {
-      typ1->DepWrkSiz = typ2->NmbLin / (par->NmbDepBlk * par->NmbCpu);
-      typ1->NmbDepWrd = typ2->NmbLin / (typ1->DepWrkSiz * 32);
+   pthread_mutex_lock(&par->AsyMtx);
 
-      if(typ2->NmbLin != typ1->NmbDepWrd * typ1->DepWrkSiz * 32)
-         typ1->NmbDepWrd++;
-   }
-   else
+   // Start the helper thread on first use
+   if(!par->AsyFlg)
    {
-      typ1->DepWrkSiz = typ2->NmbLin;
-      typ1->NmbDepWrd = 1;
-   }
+      if(pthread_create(&par->AsyPth, NULL, AsyHdl, (void *)par))
+      {
+         pthread_mutex_unlock(&par->AsyMtx);
+         return(0);
+      }
 
-   // Allocate a global dependency table
-   if(!(typ1->DepWrdMat =
-      LPL_calloc(par->lmb, typ1->NmbSmlWrk * typ1->NmbDepWrd * par->SizMul, sizeof(int))))
-   {
-      return(0);
+      par->AsyFlg = 1;
    }
 
-   // Then spread sub-tables among WP
-   for(i=0;i<typ1->NmbSmlWrk;i++)
+   // Launches' results are kept in a ring buffer
+   if(par->AsyNxt - par->AsyDon >= MaxAsy)
    {
-      typ1->SmlWrkTab[i].NmbDep = 0;
-      typ1->SmlWrkTab[i].DepWrdTab =
-         &typ1->DepWrdMat[ i * typ1->NmbDepWrd * par->SizMul ];
-   }
-
-   // Allocate a running tags table
-   if(!(typ1->RunDepTab = LPL_calloc(par->lmb, typ1->NmbDepWrd * par->SizMul, sizeof(int))))
+      pthread_mutex_unlock(&par->AsyMtx);
       return(0);
+   }
 
-   return(typ1->NmbDepWrd);
+   req = &par->AsyQue[ (par->AsyBeg + par->AsyNmb) % MaxAsy ];
+   req->TypIdx1 = TypIdx1;
+   req->TypIdx2 = TypIdx2;
+   req->prc = prc;
+   req->arg = PtrArg;
+   req->JoiFlg = JoiFlg ? 1 : 0;
+   par->AsyNmb++;
+   hdl = ++par->AsyNxt;
+   pthread_cond_signal(&par->AsyCnd);
+   pthread_mutex_unlock(&par->AsyMtx);
+
+   return(hdl);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Type1 element idx1 depends on type2 element idx2                           */
+/* Return 1 if the asynchronous launch hdl is completed, without waiting for  */
+/* the helper thread: if the running launch asked the master to join, its     */
+/* share of WP is run first, so that polling eventually succeeds              */
 /*----------------------------------------------------------------------------*/
 
-int AddDependency(int64_t ParIdx, itg idx1, itg idx2)
+int TestParallel(int64_t ParIdx, int64_t hdl)
 {
-   WrkSct *wrk;
+   int flg;
    ParSct *par = (ParSct *)ParIdx;
 
    // Get and check lib parallel instance
-   if( !par || !par->CurTyp || !par->CurTyp->SmlWrkSiz
-   ||  !par->CurTyp->DepWrkSiz || !par->DepTyp || (idx1 < 1)
-   ||  (idx1 > par->CurTyp->NmbLin) || (idx2 < 1)
-   ||  (idx2 > par->DepTyp->NmbLin) )
-   {
+   if(!ParIdx)
       return(0);
-   }
 
-   // Set and count dependency bit
-   wrk = &par->CurTyp->SmlWrkTab[ (idx1-1) / par->CurTyp->SmlWrkSiz ];
+   pthread_mutex_lock(&par->AsyMtx);
 
-   if(!SetBit(wrk->DepWrdTab, (idx2-1) / par->CurTyp->DepWrkSiz ))
-      wrk->NmbDep++;
+   // A launch the master has to join cannot complete without it:
+   // run the master's share of WP before testing
+   if( (par->AsyDon < hdl) && par->JoiLch )
+   {
+      par->JoiLch = 0;
+      pthread_mutex_unlock(&par->AsyMtx);
+      LfrWrk(&par->PthTab[ par->NmbCpu ]);
+      pthread_mutex_lock(&par->AsyMtx);
+   }
 
-   return(wrk->NmbDep);
+   flg = (par->AsyDon >= hdl);
+   pthread_mutex_unlock(&par->AsyMtx);
+
+   return(flg);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Set all to all dependencies without any pre-checking                       */
+/* Wait for the asynchronous launch hdl and all former ones                   */
+/* The master joins the running launches that asked for it                    */
+/* Returns hdl's acceleration factor, or 0 if it is older than the last       */
+/* MaxAsy launches                                                            */
 /*----------------------------------------------------------------------------*/
 
-void AddDependencyFast( int64_t ParIdx, int NmbTyp1, itg *TabIdx1,
-                        int NmbTyp2, itg *TabIdx2 )
+float WaitParallel(int64_t ParIdx, int64_t hdl)
 {
-   int i, j;
+   float acc = 0.;
    ParSct *par = (ParSct *)ParIdx;
-   WrkSct *wrk;
 
-   for(i=0;i<NmbTyp1;i++)
-   {
-      wrk = &par->CurTyp->SmlWrkTab[ (TabIdx1[i] - 1) / par->CurTyp->SmlWrkSiz ];
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0.);
 
-      for(j=0;j<NmbTyp2;j++)
-         if( !SetBit(wrk->DepWrdTab, (TabIdx2[j] - 1) / par->CurTyp->DepWrkSiz ) )
-            wrk->NmbDep++;
-   }
-}
+   pthread_mutex_lock(&par->AsyMtx);
 
+   if(hdl > par->AsyNxt)
+      hdl = par->AsyNxt;
 
-/*----------------------------------------------------------------------------*/
-/* Type1 element idx1 depends on type2 element idx2                           */
-/*----------------------------------------------------------------------------*/
+   while(par->AsyDon < hdl)
+   {
+      if(par->JoiLch)
+      {
+         par->JoiLch = 0;
+         pthread_mutex_unlock(&par->AsyMtx);
+         LfrWrk(&par->PthTab[ par->NmbCpu ]);
+         pthread_mutex_lock(&par->AsyMtx);
+         continue;
+      }
 
-int UpdateDependency(int64_t ParIdx, int TypIdx1, int TypIdx2,
-                     itg idx1, itg idx2 )
-{
-   WrkSct *wrk;
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1, *typ2;
+      pthread_cond_wait(&par->AsyDonCnd, &par->AsyMtx);
+   }
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
+   if( (hdl > 0) && (par->AsyDon - hdl < MaxAsy) )
+      acc = par->AsyAcc[ hdl % MaxAsy ];
 
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
+   pthread_mutex_unlock(&par->AsyMtx);
 
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin || !typ2->NmbLin
-   ||  !typ1->SmlWrkSiz || !typ1->DepWrkSiz || (idx1 < 1)
-   ||  (idx1 > typ1->MaxNmbLin) || (idx2 < 1) || (idx2 > typ2->MaxNmbLin) )
-   {
-      return(0);
-   }
+   return(acc);
+}
 
-   // Set and count dependency bit
-   wrk = &typ1->SmlWrkTab[ (idx1-1) / typ1->SmlWrkSiz ];
 
-   if(!SetBit(wrk->DepWrdTab, (idx2-1) / typ1->DepWrkSiz ))
-      wrk->NmbDep++;
+/*----------------------------------------------------------------------------*/
+/* Wait for the pending asynchronous launches before the master drives the    */
+/* threads or changes the types, dependencies, work lists or attributes they  */
+/* may use, the helper thread never waits                                     */
+/*----------------------------------------------------------------------------*/
 
-   return(wrk->NmbDep);
+static void WaiAsy(ParSct *par)
+{
+   if(par && par->AsyFlg && !pthread_equal(pthread_self(), par->AsyPth))
+      WaitParallel((int64_t)par, par->AsyNxt);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Same as above, without any pre-checking of data                            */
+/* Helper thread running the queued asynchronous launches in order            */
 /*----------------------------------------------------------------------------*/
 
-void UpdateDependencyFast( int64_t ParIdx,  int TypIdx1, int NmbTyp1,
-                           itg *TabIdx1, int TypIdx2, int NmbTyp2,
-                           itg *TabIdx2 )
+static void *AsyHdl(void *ptr)
 {
-   int i, j;
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1 = &par->TypTab[ TypIdx1 ];
-   WrkSct *wrk;
-   (void)(TypIdx2);
+   float acc;
+   AsySct req;
+   ParSct *par = (ParSct *)ptr;
 
-   for(i=0;i<NmbTyp1;i++)
+   pthread_mutex_lock(&par->AsyMtx);
+
+   for(;;)
    {
-      wrk = &typ1->SmlWrkTab[ (TabIdx1[i] - 1) / typ1->SmlWrkSiz ];
+      while(!par->AsyNmb && !par->AsyEnd)
+         pthread_cond_wait(&par->AsyCnd, &par->AsyMtx);
 
-      for(j=0;j<NmbTyp2;j++)
-         if( !SetBit(wrk->DepWrdTab, (TabIdx2[j] - 1) / typ1->DepWrkSiz ) )
-            wrk->NmbDep++;
+      if(!par->AsyNmb)
+         break;
+
+      req = par->AsyQue[ par->AsyBeg ];
+      par->AsyBeg = (par->AsyBeg + 1) % MaxAsy;
+      par->AsyNmb--;
+      par->AsyCur = par->AsyDon + 1;
+      pthread_mutex_unlock(&par->AsyMtx);
+
+      // Only the lock-free scheduler lets the master join
+      par->AsyJoi = req.JoiFlg && (req.TypIdx2 > 0) && (par->DynSch == LfrSch);
+      acc = LaunchParallel((int64_t)par, req.TypIdx1, req.TypIdx2, req.prc, req.arg);
+      par->AsyJoi = 0;
+
+      pthread_mutex_lock(&par->AsyMtx);
+      par->AsyAcc[ par->AsyCur % MaxAsy ] = acc;
+      par->AsyDon = par->AsyCur;
+      pthread_cond_broadcast(&par->AsyDonCnd);
    }
+
+   pthread_mutex_unlock(&par->AsyMtx);
+
+   return(NULL);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Sort wp depending on their number of dependencies                          */
+/* Allocate a worklist that may store up to MaxSiz items and whose items are  */
+/* given to the user's procedure by batches of BatSiz                         */
+/* FIFO lists are processed in push order, LIFO lists are processed newest    */
+/* first by the thread that pushed the items, the older ones being shared     */
+/* with the idle threads                                                      */
+/* Returns the list index or 0 on failure                                     */
 /*----------------------------------------------------------------------------*/
 
-int EndDependency(int64_t ParIdx, float DepSta[2])
+int NewWorkList(int64_t ParIdx, itg MaxSiz, int BatSiz, int LstMod)
 {
-   int      i, NmbDepBit, TotNmbDep = 0;
-   ParSct   *par = (ParSct *)ParIdx;
-   TypSct   *typ1, *typ2;
+   int LstIdx;
+   LstSct *lst;
+   ParSct *par = (ParSct *)ParIdx;
 
-   // Get and check lib parallel instance
-   if( !ParIdx || !DepSta )
+   // Get and check lib parallel instance and parameters
+   if( !ParIdx || (MaxSiz < 1)
+   ||  ((LstMod != FifoWorkList) && (LstMod != LifoWorkList)) )
+   {
       return(0);
+   }
 
-   // Compute average number of collisions
-   DepSta[1] = 0.;
-   typ1 = par->CurTyp;
-   typ2 = par->DepTyp;
-
-   if(!typ1 || !typ2 || !typ1->DepWrkSiz)
-      return(0);
+   WaiAsy(par);
 
-   for(i=0;i<typ1->NmbSmlWrk;i++)
-   {
-      TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
-      typ1->SmlWrkTab[i].rnd = rand();
+   if(BatSiz < 1)
+      BatSiz = DefBatSiz;
 
-      if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
-         DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
-   }
+   // Search for a free list
+   for(LstIdx=1; LstIdx<=MaxLst; LstIdx++)
+      if(!par->LstTab[ LstIdx ])
+         break;
 
-   if(!TotNmbDep)
+   if(LstIdx > MaxLst)
       return(0);
 
-   DepSta[0] = (float)TotNmbDep;
+   if(!(lst = LPL_calloc(par->lmb, 1, sizeof(LstSct))))
+      return(0);
 
-   // Compute stats
-   if(typ2->NmbLin >= typ1->DepWrkSiz)
+   lst->MaxSiz = MaxSiz;
+   lst->BatSiz = BatSiz;
+   lst->PrvMax = 4 * BatSiz;
+   lst->mod = LstMod;
+   pthread_mutex_init(&lst->mtx, NULL);
+   pthread_cond_init(&lst->cnd, NULL);
+
+   // Shared ring, per thread private stacks, batches and claimed WP tables
+   if( !(lst->ItmTab = LPL_calloc(par->lmb, MaxSiz, sizeof(itg)))
+   ||  !(lst->PrvTab = LPL_calloc(par->lmb, (int64_t)par->NmbCpu * lst->PrvMax, sizeof(itg)))
+   ||  !(lst->BufTab = LPL_calloc(par->lmb, (int64_t)par->NmbCpu * BatSiz, sizeof(itg)))
+   ||  !(lst->ClaTab = LPL_calloc(par->lmb, (int64_t)par->NmbCpu * BatSiz, sizeof(WrkSct *)))
+   ||  !(lst->NmbPrv = LPL_calloc(par->lmb, par->NmbCpu, sizeof(int))) )
    {
-      NmbDepBit = typ2->NmbLin / typ1->DepWrkSiz;
-
-      if(typ2->NmbLin - NmbDepBit * typ1->DepWrkSiz)
-         NmbDepBit++;
-   }
-   else
-      NmbDepBit = 1;
-
-   if(!NmbDepBit)
+      par->LstTab[ LstIdx ] = lst;
+      FreeWorkList(ParIdx, LstIdx);
       return(0);
+   }
 
-   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
-   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
-
-   // Sort WP from highest collision number to the lowest
-   if(par->WrkSizSrt && par->DynSch)
-      qsort(typ1->SmlWrkTab, typ1->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
-
-   // If the dynamic scheduling is disabled, set static WP
-   if(!par->DynSch && !SetGrp(par, typ1))
-      return(0);
+   par->LstTab[ LstIdx ] = lst;
 
-   return(1);
+   return(LstIdx);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Sort wp depending on their number of dependencies                          */
+/* Free a worklist and its items                                              */
 /*----------------------------------------------------------------------------*/
 
-void GetDependencyStats(int64_t ParIdx, int TypIdx1,
-                        int TypIdx2, float DepSta[2])
+void FreeWorkList(int64_t ParIdx, int LstIdx)
 {
-   int i, NmbDepBit, TotNmbDep = 0;
+   LstSct *lst;
    ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1, *typ2;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return;
 
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
-
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
-   ||  !typ2->NmbLin )
+   // Get and check lib parallel instance and list
+   if( !ParIdx || (LstIdx < 1) || (LstIdx > MaxLst)
+   ||  !(lst = par->LstTab[ LstIdx ]) )
    {
       return;
    }
 
-   // Compute average number of collisions
-   DepSta[1] = 0.;
+   WaiAsy(par);
 
-   for(i=0;i<typ1->NmbSmlWrk;i++)
-   {
-      TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
+   if(lst->ItmTab)
+      LPL_free(par->lmb, lst->ItmTab);
 
-      if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
-         DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
-   }
+   if(lst->PrvTab)
+      LPL_free(par->lmb, lst->PrvTab);
 
-   DepSta[0] = (float)TotNmbDep;
+   if(lst->BufTab)
+      LPL_free(par->lmb, lst->BufTab);
 
-   // Compute stats
-   if(typ2->NmbLin >= typ1->DepWrkSiz)
-   {
-      NmbDepBit = typ2->NmbLin / typ1->DepWrkSiz;
+   if(lst->ClaTab)
+      LPL_free(par->lmb, lst->ClaTab);
 
-      if(typ2->NmbLin - NmbDepBit * typ1->DepWrkSiz)
-         NmbDepBit++;
-   }
-   else
-      NmbDepBit = 1;
+   if(lst->NmbPrv)
+      LPL_free(par->lmb, lst->NmbPrv);
 
-   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
-   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
+   pthread_mutex_destroy(&lst->mtx);
+   pthread_cond_destroy(&lst->cnd);
+   LPL_free(par->lmb, lst);
+   par->LstTab[ LstIdx ] = NULL;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Halve the number of small blocks by compining pairs of consecutive blocks  */
+/* Push an item to a worklist, before or during its launch                    */
+/* PthIdx is the calling thread's index within a launch's procedure, or -1:   */
+/* pushes are lock-free and the items pushed during a launch are processed    */
+/* by the same launch                                                         */
+/* Returns 0 if the list is full                                              */
 /*----------------------------------------------------------------------------*/
 
-int HalveSmallBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+int PushWorkList(int64_t ParIdx, int LstIdx, int PthIdx, itg ItmIdx)
 {
-   int i, j;
+   int *NmbPrv;
+   itg *PrvTab;
+   LstSct *lst;
    ParSct *par = (ParSct *)ParIdx;
-   WrkSct *EvnWrk, *OddWrk, *NewWrk;
-   TypSct *typ1, *typ2;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
-
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
-
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
-   ||  !typ2->NmbLin )
+   // Get and check lib parallel instance, list and item
+   if( !ParIdx || (LstIdx < 1) || (LstIdx > MaxLst)
+   ||  !(lst = par->LstTab[ LstIdx ]) || (ItmIdx < 1) )
    {
       return(0);
    }
 
-   // Do not halve the number of blocks if there is only one left
-   // nor if the small blocks have been sorted
-   if(typ1->NmbSmlWrk < 2 || par->WrkSizSrt)
-      return(0);
-
-   // For each new block, compute the logical OR between two consecutive old blocks
-   // The new data is copied on top of former one
-   for(i=0;i<typ1->NmbSmlWrk;i+=2)
+   // A running thread keeps its LIFO items in its own stack
+   if( (lst->mod == LifoWorkList) && (par->lst == lst)
+   &&  (PthIdx >= 0) && (PthIdx < par->NmbCpu) )
    {
-      EvnWrk = &typ1->SmlWrkTab[ i     ];
-      OddWrk = &typ1->SmlWrkTab[ i + 1 ];
-      NewWrk = &typ1->SmlWrkTab[ i / 2 ];
-      NewWrk->BegIdx = EvnWrk->BegIdx;
-      NewWrk->EndIdx = OddWrk->EndIdx;
+      NmbPrv = &lst->NmbPrv[ PthIdx ];
+      PrvTab = &lst->PrvTab[ PthIdx * lst->PrvMax ];
 
-      for(j=0;j<typ1->NmbDepWrd;j++)
-         if(i+1 < typ1->NmbSmlWrk)
-            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j] | OddWrk->DepWrdTab[j];
-         else
-            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j];
-   }
+      if( (*NmbPrv == lst->PrvMax) && !SplPrv(lst, PthIdx) )
+         return(0);
 
-   // Halve the number of blocks and add one if the number was odd
-   typ1->SmlWrkSiz *= typ1->NmbSmlWrk;
+      PrvTab[ (*NmbPrv)++ ] = ItmIdx;
+      AtmAdd(&lst->PenCpt, 1);
 
-   if(typ1->NmbSmlWrk & 1)
-      typ1->NmbSmlWrk = typ1->NmbSmlWrk / 2 + 1;
-   else
-      typ1->NmbSmlWrk /= 2;
+      return(1);
+   }
 
-   typ1->SmlWrkSiz /= typ1->NmbSmlWrk;
+   // The pending count goes up before the item may be popped and processed
+   AtmAdd(&lst->PenCpt, 1);
 
-   return(typ1->NmbSmlWrk);
+   if(!PshLst(lst, &ItmIdx, 1))
+   {
+      AtmAdd(&lst->PenCpt, -1);
+      return(0);
+   }
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Halve the number of dependency words by ORing consecutive pairs of bits    */
+/* Process all the items of a worklist, including those pushed meanwhile      */
+/* prc(NmbItm, ItmTab, PthIdx, PtrArg) gets a batch of items                  */
+/* With TypIdx2, items are TypIdx1 lines whose WP dependencies against        */
+/* TypIdx2 are checked as in LaunchParallel: items conflicting with a running */
+/* batch are delayed and items beyond TypIdx1's lines are dropped             */
+/* Returns the number of processed items or -1 on failure                     */
 /*----------------------------------------------------------------------------*/
 
-int HalveDependencyBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+itg LaunchWorkList(  int64_t ParIdx, int LstIdx, int TypIdx1, int TypIdx2,
+                     void *prc, void *PtrArg )
 {
-   int i, j;
-   WrkSct *wrk;
+   int i;
+   LstSct *lst;
+   TypSct *typ1 = NULL, *typ2 = NULL;
    ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ1, *typ2;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
 
-   // Check bounds
-   typ1 = &par->TypTab[ TypIdx1 ];
-   typ2 = &par->TypTab[ TypIdx2 ];
-
-   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
-   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
-   ||  !typ2->NmbLin )
+   // Get and check lib parallel instance, list and bounds
+   if( !ParIdx || !prc || (LstIdx < 1) || (LstIdx > MaxLst)
+   ||  !(lst = par->LstTab[ LstIdx ]) || (TypIdx1 < 0) || (TypIdx1 > MaxTyp)
+   ||  (TypIdx2 < 0) || (TypIdx2 > MaxTyp) )
    {
-      return(0);
+      return(-1);
    }
 
-   // Do not halve the number of blocks if there is only one left
-   if(typ1->NmbDepWrd < 2)
-      return(0);
+   WaiAsy(par);
 
-   for(i=0;i<typ1->NmbSmlWrk;i++)
+   if(TypIdx1)
+      typ1 = &par->TypTab[ TypIdx1 ];
+
+   // Dependencies need the items' type to have been linked to TypIdx2
+   if(TypIdx2)
    {
-      wrk = &typ1->SmlWrkTab[i];
+      if(!typ1 || (TypIdx1 == TypIdx2) || !typ1->RunDepTab)
+         return(-1);
 
-      for(j=0;j<typ1->NmbDepWrd;j+=2)
-         if(GetBit(wrk->DepWrdTab, j) || GetBit(wrk->DepWrdTab, j+1))
-            SetBit(wrk->DepWrdTab, j/2);
-         else
-            ClrBit(wrk->DepWrdTab, j/2);
+      typ2 = &par->TypTab[ TypIdx2 ];
+      ClrWrd(typ1->NmbDepWrd, typ1->RunDepTab);
    }
 
-   typ1->DepWrkSiz *= typ1->NmbDepWrd;
-
-   if(typ1->NmbDepWrd & 1)
-      typ1->NmbDepWrd = typ1->NmbDepWrd / 2 + 1;
-   else
-      typ1->NmbDepWrd /= 2;
+   if(par->PrfFlg)
+      BegLch(par, prc, TypIdx1, TypIdx2);
 
-   typ1->DepWrkSiz /= typ1->NmbDepWrd;
+   lst->prc = prc;
+   lst->arg = PtrArg;
+   lst->typ1 = typ1;
+   lst->typ2 = typ2;
+   lst->DonCpt = lst->IdlCpt = 0;
 
-   return(typ1->NmbDepWrd * 32);
-}
+   for(i=0;i<par->NmbCpu;i++)
+      lst->NmbPrv[i] = 0;
 
+   par->cmd = RunLstWrk;
+   par->lst = lst;
+   par->typ1 = typ1;
+   par->typ2 = typ2;
 
-/*----------------------------------------------------------------------------*/
-/* Return the block ID containing the given element ID                        */
-/*----------------------------------------------------------------------------*/
+   // Wake up all threads and wait for the list to be exhausted
+   LchPth(par);
 
-int GetBlkIdx(int64_t ParIdx, int typ, int idx)
-{
-   ParSct *par = (ParSct *)ParIdx;
+   par->lst = NULL;
+   par->typ1 = par->typ2 = NULL;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(-1);
+   if(par->PrfFlg)
+      EndLch(par, 0.);
 
-   return( (idx - 1) / par->TypTab[ typ ].SmlWrkSiz );
+   return((itg)lst->DonCpt);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Check whether two blocks are dependant or not from each others             */
+/* Append items to the shared ring, returns 0 if there is not enough room     */
 /*----------------------------------------------------------------------------*/
 
-int ChkBlkDep(int64_t ParIdx, int TypIdx, int blk1, int blk2)
+static int PshLst(LstSct *lst, itg *ItmTab, int NmbItm)
 {
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ;
+   int i;
+   itg *slt;
+   int64_t beg = AtmLod(&lst->PshCpt);
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(-1);
+   // Reserve the slots while the ring has room for them
+   do
+   {
+      if(beg + NmbItm - AtmLod(&lst->PopCpt) > lst->MaxSiz)
+         return(0);
+   }while(!AtmCas(&lst->PshCpt, &beg, beg + NmbItm));
 
-   typ = &par->TypTab[ TypIdx ];
+   // A slot is free once the thread that popped its previous item read it
+   for(i=0;i<NmbItm;i++)
+   {
+      slt = &lst->ItmTab[ (beg + i) % lst->MaxSiz ];
 
-   return(AndWrd( typ->NmbDepWrd,
-                  typ->SmlWrkTab[ blk1 ].DepWrdTab,
-                  typ->SmlWrkTab[ blk2 ].DepWrdTab ));
-}
+      while(AtmLod(slt))
+         CpuPau();
 
+      AtmSto(slt, ItmTab[i]);
+   }
 
-/*----------------------------------------------------------------------------*/
-/* Test and set a bit in a multibyte word                                     */
-/*----------------------------------------------------------------------------*/
+   WakLst(lst);
 
-static int SetBit(int *tab, int idx)
-{
-   int res = ( tab[ idx >> 5 ] & (1UL << (idx & 31)) );
-   tab[ idx >> 5 ] |= 1UL << (idx & 31);
-   return(res);
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Test a bit in a multibyte word                                             */
+/* Pop up to MaxItm items from the shared ring, returns their number          */
 /*----------------------------------------------------------------------------*/
 
-static int GetBit(int *tab, int idx)
+static int PopLst(LstSct *lst, itg *ItmTab, int MaxItm)
 {
-   return( tab[ idx >> 5 ] & (1UL << (idx & 31)) );
+   int i, NmbItm;
+   itg *slt;
+   int64_t avl, beg = AtmLod(&lst->PopCpt);
+
+   do
+   {
+      avl = AtmLod(&lst->PshCpt) - beg;
+
+      if(avl <= 0)
+         return(0);
+
+      NmbItm = (avl < MaxItm) ? (int)avl : MaxItm;
+   }while(!AtmCas(&lst->PopCpt, &beg, beg + NmbItm));
+
+   // Wait for the pushing threads to have written the items, then free the slots
+   for(i=0;i<NmbItm;i++)
+   {
+      slt = &lst->ItmTab[ (beg + i) % lst->MaxSiz ];
+
+      while(!(ItmTab[i] = AtmLod(slt)))
+         CpuPau();
+
+      AtmSto(slt, 0);
+   }
+
+   return(NmbItm);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Move the oldest half of a thread's private items to the shared ring        */
+/*----------------------------------------------------------------------------*/
+
+static int SplPrv(LstSct *lst, int PthIdx)
+{
+   int i, NmbSpl, *NmbPrv = &lst->NmbPrv[ PthIdx ];
+   itg *PrvTab = &lst->PrvTab[ PthIdx * lst->PrvMax ];
+
+   NmbSpl = (*NmbPrv + 1) / 2;
+
+   if(!NmbSpl || !PshLst(lst, PrvTab, NmbSpl))
+      return(0);
+
+   for(i=NmbSpl; i<*NmbPrv; i++)
+      PrvTab[ i - NmbSpl ] = PrvTab[i];
+
+   *NmbPrv -= NmbSpl;
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Fill a batch with the thread's newest items, then with the shared ones,    */
+/* claim their WP and call the user's procedure until no items are pending    */
+/*----------------------------------------------------------------------------*/
+
+static void LstWrk(PthSct *pth)
+{
+   int i, j, NmbBuf = 0, NmbRun, NmbCla, idl = 0, gen;
+   itg tmp;
+   ParSct *par = pth->par;
+   LstSct *lst = par->lst;
+   TypSct *typ1 = lst->typ1;
+   int BatSiz = lst->BatSiz, *NmbPrv = &lst->NmbPrv[ pth->idx ];
+   itg *PrvTab = &lst->PrvTab[ pth->idx * lst->PrvMax ];
+   itg *BufTab = &lst->BufTab[ pth->idx * BatSiz ];
+   WrkSct *wrk, **ClaTab = &lst->ClaTab[ pth->idx * BatSiz ];
+   EvtSct evt;
+
+   for(;;)
+   {
+      // Read the list's generation before looking for items not to miss a push
+      gen = AtmLod(&lst->gen);
+
+      while( (NmbBuf < BatSiz) && *NmbPrv )
+         BufTab[ NmbBuf++ ] = PrvTab[ --(*NmbPrv) ];
+
+      if(NmbBuf < BatSiz)
+         NmbBuf += PopLst(lst, &BufTab[ NmbBuf ], BatSiz - NmbBuf);
+
+      // Nothing to do: wait for the other threads to push new items or end
+      if(!NmbBuf)
+      {
+         if(!AtmLod(&lst->PenCpt))
+            break;
+
+         if(!idl)
+         {
+            idl = 1;
+            AtmAdd(&lst->IdlCpt, 1);
+         }
+
+         // Spin for a while, then sleep until an item is pushed or all are done
+         if(idl <= par->SpnWat)
+         {
+            idl++;
+            CpuPau();
+         }
+         else
+            WaiLst(lst, gen);
+
+         continue;
+      }
+
+      if(idl)
+      {
+         idl = 0;
+         AtmAdd(&lst->IdlCpt, -1);
+      }
+
+      NmbRun = NmbBuf;
+      NmbCla = 0;
+
+      // Move the items whose WP could be claimed to the front of the batch
+      if(lst->typ2)
+      {
+         NmbRun = 0;
+
+         for(i=0;i<NmbBuf;i++)
+         {
+            if( (BufTab[i] < 1) || (BufTab[i] > typ1->NmbLin) )
+            {
+               BufTab[i--] = BufTab[ --NmbBuf ];
+
+               if(!AtmAdd(&lst->PenCpt, -1))
+                  WakLst(lst);
+
+               continue;
+            }
+
+            wrk = GetWrk(typ1, BufTab[i]);
+
+            for(j=0;j<NmbCla;j++)
+               if(ClaTab[j] == wrk)
+                  break;
+
+            if(j == NmbCla)
+            {
+               if(!WrkCla(typ1, wrk, typ1->RunDepTab))
+                  continue;
+
+               ClaTab[ NmbCla++ ] = wrk;
+            }
+
+            tmp = BufTab[ NmbRun ];
+            BufTab[ NmbRun++ ] = BufTab[i];
+            BufTab[i] = tmp;
+         }
+
+         if(!NmbRun)
+         {
+            pth->NmbBlk++;
+            CpuPau();
+            continue;
+         }
+      }
+
+      if(par->PrfFlg)
+         evt.beg = GetWallClock();
+
+      ((void (*)(itg, itg *, int, void *))lst->prc)(NmbRun, BufTab, pth->idx, lst->arg);
+
+      if(par->PrfFlg)
+      {
+         evt.end = GetWallClock();
+         evt.BegIdx = BufTab[0];
+         evt.EndIdx = BufTab[ NmbRun - 1 ];
+         evt.lch = par->CurLch;
+         evt.tid = pth->idx;
+         AddEvt(&pth->EvtTab, &pth->NmbEvt, &pth->MaxEvt, &evt);
+      }
+
+      for(j=0;j<NmbCla;j++)
+         WrkRls(typ1, ClaTab[j], typ1->RunDepTab);
+
+      // Items pushed by the procedure were counted before these ones are removed
+      AtmAdd(&lst->DonCpt, NmbRun);
+
+      // The sleeping threads must see that the list is exhausted
+      if(!AtmAdd(&lst->PenCpt, -NmbRun))
+         WakLst(lst);
+
+      // Keep the delayed items for the next batch
+      for(i=NmbRun; i<NmbBuf; i++)
+         BufTab[ i - NmbRun ] = BufTab[i];
+
+      NmbBuf -= NmbRun;
+
+      // Share some of the private items with the idle threads
+      if( (*NmbPrv > 1) && AtmLod(&lst->IdlCpt) )
+         SplPrv(lst, pth->idx);
+   }
+
+   if(idl)
+      AtmAdd(&lst->IdlCpt, -1);
+
+   DonPth(par);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Bump a list's generation and wake up its sleeping threads                  */
+/*----------------------------------------------------------------------------*/
+
+static void WakLst(LstSct *lst)
+{
+   AtmAdd(&lst->gen, 1);
+
+   if(AtmLod(&lst->PrkCpt))
+   {
+      pthread_mutex_lock(&lst->mtx);
+      pthread_cond_broadcast(&lst->cnd);
+      pthread_mutex_unlock(&lst->mtx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sleep until a list's generation moves on from gen or no items are          */
+/* pending, like WaiCmd does with a thread's commands                         */
+/*----------------------------------------------------------------------------*/
+
+static void WaiLst(LstSct *lst, int gen)
+{
+   // The parking count must be raised before checking the generation again
+   pthread_mutex_lock(&lst->mtx);
+   AtmAdd(&lst->PrkCpt, 1);
+
+   while( (AtmLod(&lst->gen) == gen) && AtmLod(&lst->PenCpt) )
+      pthread_cond_wait(&lst->cnd, &lst->mtx);
+
+   AtmAdd(&lst->PrkCpt, -1);
+   pthread_mutex_unlock(&lst->mtx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Pthread handler, waits for job, does it, then signal end                   */
+/*----------------------------------------------------------------------------*/
+
+static void *PthHdl(void *ptr)
+{
+   int gen = 0;
+   PthSct *pth = (PthSct *)ptr;
+   ParSct *par = pth->par;
+
+   // Tell the scheduler if all threads are ready
+   pthread_mutex_lock(&par->ParMtx);
+   par->WrkCpt++;
+   pthread_cond_signal(&par->ParCnd);
+   pthread_mutex_unlock(&par->ParMtx);
+
+   // Enter main loop until StopParallel is send
+   do
+   {
+      // Wait for a wake-up signal from the main loop
+      WaiCmd(pth, &gen);
+
+      // This thread is lent to a team: serve it until the team is stopped
+      if(pth->TemPth)
+      {
+         RunTem(pth);
+         continue;
+      }
+
+      // Destroy the thread mutex and condition and call for join
+      if(par->cmd == EndPth)
+      {
+         pthread_mutex_destroy(&pth->mtx);
+         pthread_cond_destroy(&pth->cnd);
+         return(NULL);
+      }
+
+      RunCmd(pth);
+
+      // Run the shares of the threads lent to a team
+      RunPxy(par);
+   }while(1);
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the current command as a given thread                                  */
+/*----------------------------------------------------------------------------*/
+
+static void RunCmd(PthSct *pth)
+{
+   itg i, beg, end;
+   ParSct *par = pth->par;
+
+   switch(par->cmd)
+   {
+      // Call user's procedure with big WP
+      case RunBigWrk :
+      {
+         // Loop over the interleaved blocks
+         for(i=0;i<par->NmbItlBlk;i++)
+         {
+            beg = pth->big->ItlTab[i][0];
+            end = pth->big->ItlTab[i][1];
+
+            if(!beg || !end || (end < beg))
+               continue;
+
+            // Launch a single big wp and signal completion to the scheduler
+            CalPrc(par, beg, end, pth->idx);
+         }
+
+         DonPth(par);
+      }break;
+
+      // Call user's procedure with big WP and steal work when done
+      case RunStlWrk :
+      {
+         StlWrk(pth);
+      }break;
+
+      // Call user's procedure with small WP using dynamic scheduling
+      case RunSmlWrk :
+      {
+         // Update stats
+         par->sta[0]++;
+
+         for(i=0;i<par->NmbCpu;i++)
+            if(par->PthTab[i].wrk)
+               par->sta[1]++;
+
+         do
+         {
+            // Run the WP
+            CalPrc(par, pth->wrk->BegIdx, pth->wrk->EndIdx, pth->idx);
+
+            // Locked acces to global parameters: 
+            // update WP count, tag WP done and signal the main loop
+            pthread_mutex_lock(&par->ParMtx);
+
+            par->WrkCpt++;
+
+            if(!(pth->wrk = NexWrk(par, pth->idx)))
+            {
+               // Count the requests denied by the dependencies
+               if(par->WrkCpt < par->typ1->NmbSmlWrk)
+                  pth->NmbBlk++;
+
+               par->req = 1;
+               pthread_cond_signal(&par->ParCnd);
+               pthread_mutex_unlock(&par->ParMtx);
+               break;
+            }
+
+            if(par->req)
+               pthread_cond_signal(&par->ParCnd);
+
+            pthread_mutex_unlock(&par->ParMtx);
+         }while(1);
+      }break;
+
+      // Call user's procedure with small WP using static scheduling
+      case RunDetWrk :
+      {
+         // Loop over the groups' WP
+         for(i=0;i<pth->NmbDetWrk;i++)
+         {
+            beg = pth->DetWrkTab[i]->BegIdx;
+            end = pth->DetWrkTab[i]->EndIdx;
+            CalPrc(par, beg, end, pth->idx);
+         }
+
+         DonPth(par);
+      }break;
+
+      // Call user's procedure with small WP claimed by each thread
+      case RunLfrWrk :
+      {
+         LfrWrk(pth);
+      }break;
+
+      // Call user's procedure with small WP released in a fixed order
+      case RunRsvWrk :
+      {
+         RsvWrk(pth);
+      }break;
+
+      // Call user's procedure with the grains of the current color
+      case RunColWrk :
+      {
+         ColWrk(pth);
+      }break;
+
+      // Run the queued loops' WP as soon as their stages allow it
+      case RunFusWrk :
+      {
+         FusWrk(pth);
+      }break;
+
+      // Pop batches of items from a worklist until it is exhausted
+      case RunLstWrk :
+      {
+         LstWrk(pth);
+      }break;
+
+      // Call an internal procedure once per thread
+      case RunPthWrk :
+      {
+         par->prc(0, par->NmbCpu - 1, pth->idx, par->arg);
+         DonPth(par);
+      }break;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Claim the threads lent to a team one at a time and run their share of the */
+/* launch in their place, with their index, until none are left               */
+/*----------------------------------------------------------------------------*/
+
+static void RunPxy(ParSct *par)
+{
+   int idx;
+
+   while( ((idx = AtmLod(&par->PxyIdx)) < AtmLod(&par->NmbPxy))
+   &&     AtmCas(&par->PxyIdx, &idx, idx + 1) )
+   {
+      RunCmd(&par->PthTab[ par->PxyTab[ idx ] ]);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run a team's thread handler on a lent thread and signal its return         */
+/*----------------------------------------------------------------------------*/
+
+static void RunTem(PthSct *pth)
+{
+   ParSct *tem = pth->TemPth->par;
+
+   PthHdl((void *)pth->TemPth);
+
+   pthread_mutex_lock(&tem->ParMtx);
+   tem->RetCpt++;
+   pthread_cond_signal(&tem->ParCnd);
+   pthread_mutex_unlock(&tem->ParMtx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run the thread's own chunks, then steal some from the other threads        */
+/*----------------------------------------------------------------------------*/
+
+static void StlWrk(PthSct *pth)
+{
+   int i, chk, vic;
+   itg beg, end;
+   double tim;
+   ParSct *par = pth->par;
+
+   pth->StlLin = pth->StlCpt = 0;
+   pth->StlTim = 0.;
+   vic = pth->idx;
+
+   do
+   {
+      // Pop from the front of the own range or steal from the back of a victim
+      if((chk = PopChk(pth, 0)) < 0)
+      {
+         for(i=1;i<par->NmbCpu;i++)
+         {
+            vic = (pth->idx + i) % par->NmbCpu;
+
+            if((chk = PopChk(&par->PthTab[ vic ], 1)) >= 0)
+               break;
+         }
+
+         if(chk < 0)
+            break;
+
+         pth->StlCpt++;
+      }
+      else
+         vic = pth->idx;
+
+      beg = par->PthTab[ vic ].StlBeg + (itg)chk * par->StlChk;
+      end = beg + par->StlChk - 1;
+
+      if(end > par->PthTab[ vic ].StlEnd)
+         end = par->PthTab[ vic ].StlEnd;
+
+      tim = GetWallClock();
+      CalPrc(par, beg, end, pth->idx);
+      pth->StlTim += GetWallClock() - tim;
+      pth->StlLin += end - beg + 1;
+   }while(1);
+
+   DonPth(par);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Take a chunk index from a thread's deque: the head and tail indices are    */
+/* packed in a single word so that the owner and the thieves share one CAS    */
+/*----------------------------------------------------------------------------*/
+
+static int PopChk(PthSct *pth, int StlFlg)
+{
+   uint64_t OldWrd, NewWrd, hed, tal;
+
+   OldWrd = AtmLod(&pth->StlWrd);
+
+   do
+   {
+      hed = OldWrd >> 32;
+      tal = OldWrd & 0xffffffff;
+
+      if(hed >= tal)
+         return(-1);
+
+      if(StlFlg)
+         NewWrd = (hed << 32) | (tal - 1);
+      else
+         NewWrd = ((hed + 1) << 32) | tal;
+   }while(!AtmCas(&pth->StlWrd, &OldWrd, NewWrd));
+
+   return(StlFlg ? (int)(tal - 1) : (int)hed);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the last work stealing loop's imbalance: max over average thread    */
+/* busy time, and optionally each thread's number of lines and steals         */
+/*----------------------------------------------------------------------------*/
+
+float GetWorkStealingStats(int64_t ParIdx, itg *LinTab, int *StlTab)
+{
+   int i;
+   double MaxTim = 0., TotTim = 0.;
+   ParSct *par = (ParSct *)ParIdx;
+
+   if(!par)
+      return(0.);
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      if(LinTab)
+         LinTab[i] = par->PthTab[i].StlLin;
+
+      if(StlTab)
+         StlTab[i] = par->PthTab[i].StlCpt;
+
+      TotTim += par->PthTab[i].StlTim;
+
+      if(par->PthTab[i].StlTim > MaxTim)
+         MaxTim = par->PthTab[i].StlTim;
+   }
+
+   if(TotTim <= 0.)
+      return(0.);
+
+   return((float)(MaxTim * par->NmbCpu / TotTim));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Bump a thread's command generation and signal it if it was sleeping        */
+/*----------------------------------------------------------------------------*/
+
+static void WakPth(PthSct *pth)
+{
+   AtmAdd(&pth->gen, 1);
+
+   if(AtmLod(&pth->prk))
+   {
+      pthread_mutex_lock(&pth->mtx);
+      pthread_cond_signal(&pth->cnd);
+      pthread_mutex_unlock(&pth->mtx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Poll for a new command generation for a while, then sleep on a condition   */
+/*----------------------------------------------------------------------------*/
+
+static void WaiCmd(PthSct *pth, int *gen)
+{
+   int i, SpnWat = pth->par->SpnWat;
+
+   for(i=0;i<SpnWat;i++)
+   {
+      if(AtmLod(&pth->gen) != *gen)
+      {
+         *gen = AtmLod(&pth->gen);
+         return;
+      }
+
+      CpuPau();
+   }
+
+   // The parking flag must be set before checking the generation once more
+   pthread_mutex_lock(&pth->mtx);
+   AtmSto(&pth->prk, 1);
+
+   while(AtmLod(&pth->gen) == *gen)
+      pthread_cond_wait(&pth->cnd, &pth->mtx);
+
+   AtmSto(&pth->prk, 0);
+   pthread_mutex_unlock(&pth->mtx);
+   *gen = AtmLod(&pth->gen);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Count a thread's completion and wake the master up if it was the last     */
+/*----------------------------------------------------------------------------*/
+
+static void DonPth(ParSct *par)
+{
+   if( (AtmAdd(&par->DonCpt, 1) >= par->NmbCpu + AtmLod(&par->MstJoi)) && AtmLod(&par->MstPrk) )
+   {
+      pthread_mutex_lock(&par->ParMtx);
+      pthread_cond_signal(&par->ParCnd);
+      pthread_mutex_unlock(&par->ParMtx);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Wake all threads with the current command and wait for their completion    */
+/*----------------------------------------------------------------------------*/
+
+static void LchPth(ParSct *par)
+{
+   int i, n = 0;
+
+   // No threads may be lent or given back to a team in the meantime
+   pthread_mutex_lock(&par->TemMtx);
+   AtmSto(&par->DonCpt, 0);
+
+   // The threads lent to a team are not woken up, the others and the master
+   // will run their share in their place
+   for(i=0;i<par->NmbCpu;i++)
+      if(par->PthTab[i].TemPth)
+         par->PxyTab[ n++ ] = i;
+
+   AtmSto(&par->PxyIdx, 0);
+   AtmSto(&par->NmbPxy, n);
+
+   // Let the master join once the completion count is reset, through
+   // TestParallel or WaitParallel
+   if(par->MstJoi)
+   {
+      pthread_mutex_lock(&par->AsyMtx);
+      par->JoiLch = par->AsyCur;
+      pthread_cond_broadcast(&par->AsyDonCnd);
+      pthread_mutex_unlock(&par->AsyMtx);
+   }
+
+   for(i=0;i<par->NmbCpu;i++)
+      if(!par->PthTab[i].TemPth)
+         WakPth(&par->PthTab[i]);
+
+   RunPxy(par);
+
+   for(i=0;i<par->SpnWat;i++)
+   {
+      if(AtmLod(&par->DonCpt) >= par->NmbCpu + par->MstJoi)
+         break;
+
+      CpuPau();
+   }
+
+   if(i == par->SpnWat)
+   {
+      pthread_mutex_lock(&par->ParMtx);
+      AtmSto(&par->MstPrk, 1);
+
+      while(AtmLod(&par->DonCpt) < par->NmbCpu + par->MstJoi)
+         pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+
+      AtmSto(&par->MstPrk, 0);
+      pthread_mutex_unlock(&par->ParMtx);
+   }
+
+   AtmSto(&par->NmbPxy, 0);
+   pthread_mutex_unlock(&par->TemMtx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Get the next WP to be computed                                             */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *NexWrk(ParSct *par, int PthIdx)
+{
+   PthSct *pth = &par->PthTab[ PthIdx ];
+   WrkSct *wrk;
+
+   // Remove previous work's tags
+   if(pth->wrk)
+      WrkSub(par->typ1, pth->wrk, par->typ1->RunDepTab);
+
+   // Prefer a WP next to the one this thread has just computed
+   if(par->LocSch && pth->wrk && (wrk = LocNexWrk(par, pth)))
+      return(wrk);
+
+   // If the wp's buffer is empty search for some new compatible wp to fill in
+   if(!par->BufCpt)
+   {
+      wrk = par->NexWrk;
+
+      while(wrk)
+      {
+         // Check for dependencies and add new work's tags
+         if(!WrkTsa(par->typ1, wrk, par->typ1->RunDepTab))
+         {
+            par->BufWrk[ par->BufCpt++ ] = wrk;
+
+            // Unlink wp
+            if(wrk->pre)
+               wrk->pre->nex = wrk->nex;
+            else
+               par->NexWrk = wrk->nex;
+
+            if(wrk->nex)
+               wrk->nex->pre = wrk->pre;
+
+            wrk->flg = 2;
+
+            if(par->BufCpt == par->BufMax)
+               break;
+         }
+
+         wrk = wrk->nex;
+      }
+   }
+
+   // Return the next available wp in buffer and unlink it from the todo list
+   return(par->BufCpt ? par->BufWrk[ --par->BufCpt ] : NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Look for a compatible WP still in the todo list among the neighbours of    */
+/* the thread's previous WP in index order, the closest ones first            */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *LocNexWrk(ParSct *par, PthSct *pth)
+{
+   int i, pos;
+   TypSct *typ = par->typ1;
+   WrkSct *wrk;
+
+   if(!typ->OrdTab)
+      return(NULL);
+
+   pth->LocTry++;
+
+   for(i=1;i<=2*LocWin;i++)
+   {
+      pos = (i & 1) ? pth->wrk->pos + (i+1)/2 : pth->wrk->pos - i/2;
+
+      if( (pos < 0) || (pos >= typ->NmbSmlWrk) )
+         continue;
+
+      wrk = typ->OrdTab[ pos ];
+
+      if(wrk->flg || WrkTsa(typ, wrk, typ->RunDepTab))
+         continue;
+
+      // Unlink wp and add its tags
+      if(wrk->pre)
+         wrk->pre->nex = wrk->nex;
+      else
+         par->NexWrk = wrk->nex;
+
+      if(wrk->nex)
+         wrk->nex->pre = wrk->pre;
+
+      wrk->flg = 2;
+      pth->LocHit++;
+
+      return(wrk);
+   }
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Same as above with atomic reservation and claiming of the WP               */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *LocLfrWrk(ParSct *par, PthSct *pth)
+{
+   int i, pos, flg;
+   TypSct *typ = par->typ1;
+   WrkSct *wrk;
+
+   if(!typ->OrdTab)
+      return(NULL);
+
+   pth->LocTry++;
+
+   for(i=1;i<=2*LocWin;i++)
+   {
+      pos = (i & 1) ? pth->wrk->pos + (i+1)/2 : pth->wrk->pos - i/2;
+
+      if( (pos < 0) || (pos >= typ->NmbSmlWrk) )
+         continue;
+
+      wrk = typ->OrdTab[ pos ];
+      flg = AtmLod(&wrk->flg);
+
+      if(flg || !AtmCas(&wrk->flg, &flg, 1))
+         continue;
+
+      if(WrkCla(typ, wrk, typ->RunDepTab))
+      {
+         AtmSto(&wrk->flg, 2);
+         pth->LocHit++;
+         return(wrk);
+      }
+
+      AtmSto(&wrk->flg, 0);
+   }
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the locality scheduling hit rate of the last dependency loop:       */
+/* the ratio of WP taken next to the previous one over the number of attempts */
+/*----------------------------------------------------------------------------*/
+
+float GetLocalityStats(int64_t ParIdx)
+{
+   int i, NmbHit = 0, NmbTry = 0;
+   ParSct *par = (ParSct *)ParIdx;
+
+   if(!par)
+      return(0.);
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      NmbHit += par->PthTab[i].LocHit;
+      NmbTry += par->PthTab[i].LocTry;
+   }
+
+   return(NmbTry ? (float)NmbHit / (float)NmbTry : 0.);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Lock-free loop: claim compatible WP, run them and signal end of work       */
+/*----------------------------------------------------------------------------*/
+
+static void LfrWrk(PthSct *pth)
+{
+   float    sta[2] = {0., 0.};
+   ParSct   *par = pth->par;
+   TypSct   *typ = par->typ1;
+   WrkSct   *wrk;
+
+   // Keep on claiming WP until none are left in the todo list
+   while(AtmLod(&par->LfrIdx) < typ->NmbSmlWrk)
+   {
+      if(!(wrk = LfrNexWrk(pth)))
+      {
+         pth->NmbBlk++;
+         YldPth();
+         continue;
+      }
+
+      // Sample the number of concurrently running WP
+      sta[0]++;
+      sta[1] += (float)AtmAdd(&par->LfrRun, 1);
+
+      CalPrc(par, wrk->BegIdx, wrk->EndIdx, pth->idx);
+
+      // Release this WP's dependency tags
+      AtmAdd(&par->LfrRun, -1);
+      WrkRls(typ, wrk, typ->RunDepTab);
+      pth->wrk = wrk;
+   }
+
+   // Store the local stats and signal the completion to the scheduler
+   pth->sta[0] = sta[0];
+   pth->sta[1] = sta[1];
+   DonPth(par);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Scan the todo WP and atomically claim the first compatible one             */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *LfrNexWrk(PthSct *pth)
+{
+   int      i, flg, beg, AdvFlg = 1;
+   ParSct   *par = pth->par;
+   TypSct   *typ = par->typ1;
+   WrkSct   *wrk;
+
+   // Prefer a WP next to the one this thread has just computed
+   if(par->LocSch && pth->wrk && (wrk = LocLfrWrk(par, pth)))
+      return(wrk);
+
+   beg = AtmLod(&par->LfrIdx);
+
+   for(i=beg; i<typ->NmbSmlWrk; i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+      flg = AtmLod(&wrk->flg);
+
+      // Move the todo-list head past the leading taken WP
+      if(flg == 2)
+      {
+         if(AdvFlg)
+         {
+            beg = i;
+            AtmCas(&par->LfrIdx, &beg, i + 1);
+         }
+
+         continue;
+      }
+
+      AdvFlg = 0;
+
+      // Reserve the WP so that no other thread will test it concurrently
+      if(flg || !AtmCas(&wrk->flg, &flg, 1))
+         continue;
+
+      // Try to set this WP's tags into the running ones
+      if(WrkCla(typ, wrk, typ->RunDepTab))
+      {
+         AtmSto(&wrk->flg, 2);
+         return(wrk);
+      }
+
+      AtmSto(&wrk->flg, 0);
+   }
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a deterministic launch's WP precedence graph: the WP are ranked by   */
+/* their position in the type, whatever the sorting or the threads timing,    */
+/* and each one depends on the last lower ranked WP of each of its blocks.    */
+/* The lines of a block are thus updated in the lines order, as in a serial   */
+/* loop, whatever the number of threads or the level of WP picked             */
+/*----------------------------------------------------------------------------*/
+
+static int SetRsv(ParSct *par, TypSct *typ, RsvSct *rsv)
+{
+   int      i, j, k, b, p, NmbRef = 0, NmbEdg = 0, *LstTab, *CurTab, *EdgTab = NULL;
+   uint64_t wrd;
+   WrkSct   *wrk;
+
+   memset(rsv, 0, sizeof(RsvSct));
+   rsv->NmbWrk = typ->NmbSmlWrk;
+   rsv->NmbBlk = typ->NmbDepWrd * 64;
+
+   rsv->WrkTab = PolAlc(par, (int64_t)rsv->NmbWrk * sizeof(WrkSct *));
+   rsv->PrdCpt = PolAlc(par, (int64_t)rsv->NmbWrk * sizeof(int));
+   rsv->SucBeg = PolAlc(par, (int64_t)(rsv->NmbWrk + 1) * sizeof(int));
+   rsv->RdyTab = PolAlc(par, (int64_t)rsv->NmbWrk * sizeof(int));
+   LstTab = PolAlc(par, (int64_t)(rsv->NmbBlk + 1) * sizeof(int));
+   CurTab = PolAlc(par, (int64_t)rsv->NmbWrk * sizeof(int));
+
+   if( !rsv->WrkTab || !rsv->PrdCpt || !rsv->SucBeg || !rsv->RdyTab
+   ||  !LstTab || !CurTab )
+   {
+      PolFre(par, LstTab);
+      PolFre(par, CurTab);
+      FreRsv(par, rsv);
+      return(0);
+   }
+
+   // Same order as the one GetWrk relies on
+   for(i=0;i<rsv->NmbWrk;i++)
+      rsv->WrkTab[i] = typ->OrdTab ? typ->OrdTab[i] : &typ->SmlWrkTab[i];
+
+   // Count the WP's blocks to bound the number of edges, then link each WP
+   // to the previous owners of its blocks, LstTab and CurTab store indices + 1
+   for(k=0;k<2;k++)
+   {
+      for(i=0;i<rsv->NmbWrk;i++)
+      {
+         wrk = rsv->WrkTab[i];
+
+         for(j=0; j < (typ->SpsFlg ? wrk->NmbSps : (wrk->DepWrdTab ? typ->NmbDepWrd : 0)); j++)
+         {
+            wrd = typ->SpsFlg ? wrk->SpsMsk[j] : wrk->DepWrdTab[j];
+
+            if(!k)
+            {
+               NmbRef += BitCnt(wrd);
+               continue;
+            }
+
+            while(wrd)
+            {
+               b = 64 * (typ->SpsFlg ? wrk->SpsIdx[j] : j) + BitCtz(wrd);
+               wrd &= wrd - 1;
+               p = LstTab[b];
+               LstTab[b] = i + 1;
+
+               // Several blocks may be shared with the same predecessor
+               if(!p || (CurTab[ p-1 ] == i + 1))
+                  continue;
+
+               CurTab[ p-1 ] = i + 1;
+               EdgTab[ 2 * NmbEdg ] = p - 1;
+               EdgTab[ 2 * NmbEdg + 1 ] = i;
+               NmbEdg++;
+               rsv->SucBeg[p]++;
+               rsv->PrdCpt[i]++;
+            }
+         }
+      }
+
+      if( !k && !(EdgTab = PolAlc(par, (int64_t)(2 * NmbRef + 1) * sizeof(int))) )
+         break;
+   }
+
+   PolFre(par, LstTab);
+
+   if( !EdgTab || !(rsv->SucTab = PolAlc(par, (int64_t)(NmbEdg + 1) * sizeof(int))) )
+   {
+      PolFre(par, CurTab);
+      PolFre(par, EdgTab);
+      FreRsv(par, rsv);
+      return(0);
+   }
+
+   // Store the successors as compressed rows
+   for(i=0;i<rsv->NmbWrk;i++)
+   {
+      rsv->SucBeg[ i+1 ] += rsv->SucBeg[i];
+      CurTab[i] = rsv->SucBeg[i];
+   }
+
+   for(i=0;i<NmbEdg;i++)
+      rsv->SucTab[ CurTab[ EdgTab[ 2*i ] ]++ ] = EdgTab[ 2*i + 1 ];
+
+   PolFre(par, CurTab);
+   PolFre(par, EdgTab);
+
+   // The WP without predecessors are ready to run
+   for(i=0;i<rsv->NmbWrk;i++)
+      if(!rsv->PrdCpt[i])
+         rsv->RdyTab[ rsv->RdyEnd++ ] = i + 1;
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Release a deterministic launch's tables                                    */
+/*----------------------------------------------------------------------------*/
+
+static void FreRsv(ParSct *par, RsvSct *rsv)
+{
+   PolFre(par, rsv->WrkTab);
+   PolFre(par, rsv->PrdCpt);
+   PolFre(par, rsv->SucBeg);
+   PolFre(par, rsv->SucTab);
+   PolFre(par, rsv->RdyTab);
+   rsv->WrkTab = NULL;
+   rsv->PrdCpt = rsv->SucBeg = rsv->SucTab = rsv->RdyTab = NULL;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Deterministic loop: pop the ready WP, run them and release the successors  */
+/* whose last predecessor they were. The queue's slots are written only once, */
+/* so that an empty slot means its WP is still waiting for its predecessors   */
+/*----------------------------------------------------------------------------*/
+
+static void RsvWrk(PthSct *pth)
+{
+   int      i, pos, idx, suc;
+   float    sta[2] = {0., 0.};
+   ParSct   *par = pth->par;
+   RsvSct   *rsv = par->rsv;
+   WrkSct   *wrk;
+
+   while((pos = AtmLod(&rsv->RdyBeg)) < rsv->NmbWrk)
+   {
+      if(!(idx = AtmLod(&rsv->RdyTab[ pos ])))
+      {
+         pth->NmbBlk++;
+         YldPth();
+         continue;
+      }
+
+      if(!AtmCas(&rsv->RdyBeg, &pos, pos + 1))
+         continue;
+
+      wrk = rsv->WrkTab[ idx - 1 ];
+
+      // Sample the number of concurrently running WP
+      sta[0]++;
+      sta[1] += (float)AtmAdd(&par->LfrRun, 1);
+
+      CalPrc(par, wrk->BegIdx, wrk->EndIdx, pth->idx);
+
+      AtmAdd(&par->LfrRun, -1);
+
+      // Queue the successors this WP was the last one to wait for
+      for(i=rsv->SucBeg[ idx - 1 ]; i<rsv->SucBeg[ idx ]; i++)
+      {
+         suc = rsv->SucTab[i];
+
+         if(!AtmAdd(&rsv->PrdCpt[ suc ], -1))
+            AtmSto(&rsv->RdyTab[ AtmAdd(&rsv->RdyEnd, 1) - 1 ], suc + 1);
+      }
+   }
+
+   // Store the local stats and signal the completion to the scheduler
+   pth->sta[0] = sta[0];
+   pth->sta[1] = sta[1];
+   DonPth(par);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a new kind of elements and set work-packages                      */
+/*----------------------------------------------------------------------------*/
+
+int NewType(int64_t ParIdx, itg NmbLin)
+{
+   int      TypIdx = 0;
+   itg      i, idx, BigWrkSiz, NmbBigWrk;
+   TypSct   *typ;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   WaiAsy(par);
+
+   if(NmbLin <= 0)
+      return(0);
+
+   // Search for a free type structure
+   for(i=1;i<=MaxTyp;i++)
+      if(!par->TypTab[i].NmbLin)
+      {
+         TypIdx = i;
+         break;
+      }
+
+   if(!TypIdx)
+      return(0);
+
+   typ = &par->TypTab[ TypIdx ];
+   typ->NmbLin = NmbLin;
+   typ->MaxNmbLin = NmbLin * par->SizMul;
+   typ->NexGrp = NULL;
+
+   // Compute the size of small work-packages
+   if(NmbLin >= par->NmbSmlBlk * par->NmbCpu)
+   {
+      typ->SmlWrkSiz = NmbLin / (par->NmbSmlBlk * par->NmbCpu);
+      typ->NmbSmlWrk = NmbLin / typ->SmlWrkSiz;
+
+      if(NmbLin != typ->NmbSmlWrk * typ->SmlWrkSiz)
+         typ->NmbSmlWrk++;
+   }
+   else
+   {
+      typ->SmlWrkSiz = NmbLin;
+      typ->NmbSmlWrk = 1;
+   }
+
+   // Room is left for the WP appended by ResizeType
+   typ->MaxSmlWrk = typ->NmbSmlWrk * par->SizMul;
+
+   if(!(typ->SmlWrkTab = PolAlc(par, (int64_t)typ->MaxSmlWrk * sizeof(WrkSct))))
+      return(0);
+
+   // Set small work-packages
+   idx = 0;
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      typ->SmlWrkTab[i].BegIdx = idx + 1;
+      typ->SmlWrkTab[i].EndIdx = idx + typ->SmlWrkSiz;
+      idx += typ->SmlWrkSiz;
+   }
+
+   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].EndIdx = NmbLin;
+
+   // Compute the size of big work-packages
+   if(!(typ->BigWrkTab = LPL_calloc(par->lmb, par->NmbCpu * par->SizMul , sizeof(BigSct))))
+      return(0);
+
+   // Compute the size of big work-packages
+	if(NmbLin >= par->NmbCpu)
+	{
+		BigWrkSiz = NmbLin / par->NmbCpu;
+		NmbBigWrk = par->NmbCpu;
+	}
+	else
+	{
+		BigWrkSiz = NmbLin;
+		NmbBigWrk = 1;
+	}
+
+	// Set big work-packages
+	idx = 0;
+
+	for(i=0;i<NmbBigWrk;i++)
+	{
+		typ->BigWrkTab[i].ItlTab[0][0] = idx + 1;
+		typ->BigWrkTab[i].ItlTab[0][1] = idx + BigWrkSiz;
+		idx += BigWrkSiz;
+	}
+
+	typ->BigWrkTab[ NmbBigWrk - 1 ].ItlTab[0][1] = NmbLin;
+
+   return(TypIdx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Grow or shrink a data type: its WP tables are reallocated from the         */
+/* instance's pool, doubling their size once full, and given back to it once  */
+/* mostly unused                                                              */
+/*----------------------------------------------------------------------------*/
+
+int ResizeType(int64_t ParIdx, int TypIdx, itg NmbLin)
+{
+   itg      i, idx, BigWrkSiz, NmbBigWrk;
+   int      NmbSmlWrk, NewMax, NmbNew = 0;
+   TypSct   *typ;
+   WrkSct   *NewWrk = NULL;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   WaiAsy(par);
+
+   // Get and check lib parallel instance
+   if(!ParIdx || par->typ1)
+      return(0);
+
+   // Check bounds and free mem
+   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
+      return(0);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   // The lines renumbered by geometric blocks must remain
+   if(!typ->NmbLin || (NmbLin < 1) || (NmbLin < typ->GeoNmb))
+      return(0);
+
+   // WPs are added to or removed from the finest level
+   FreLvl(par, typ);
+   NmbSmlWrk = (NmbLin - 1) / typ->SmlWrkSiz + 1;
+
+   if(NmbSmlWrk > typ->MaxSmlWrk)
+   {
+      NewMax = (NmbSmlWrk > 2 * typ->MaxSmlWrk) ? NmbSmlWrk : 2 * typ->MaxSmlWrk;
+
+      if(!ReaTyp(par, typ, NewMax))
+         return(0);
+   }
+
+   if(NmbLin > typ->NmbLin)
+   {
+      // Fill the last WP, which may have been partial, then append new ones
+      i = typ->NmbSmlWrk;
+      idx = i * typ->SmlWrkSiz;
+      GetWrk(typ, idx)->EndIdx = idx;
+
+      while(idx < NmbLin)
+      {
+         typ->SmlWrkTab[i].BegIdx = idx + 1;
+         typ->SmlWrkTab[i].EndIdx = idx + typ->SmlWrkSiz;
+
+         // Appended WP are not sorted yet, they stay at their index position
+         typ->SmlWrkTab[i].pos = i;
+
+         if(typ->OrdTab)
+            typ->OrdTab[i] = &typ->SmlWrkTab[i];
+
+         // Link them in reverse order to give them to the static groups
+         typ->SmlWrkTab[i].pre = NULL;
+         typ->SmlWrkTab[i].nex = NewWrk;
+
+         if(NewWrk)
+            NewWrk->pre = &typ->SmlWrkTab[i];
+
+         NewWrk = &typ->SmlWrkTab[i];
+         NmbNew++;
+
+         i++;
+         idx += typ->SmlWrkSiz;
+         typ->NmbSmlWrk++;
+      }
+   }
+   else if( (NmbLin < typ->NmbLin) && !ShrTyp(par, typ, NmbSmlWrk) )
+      return(0);
+
+   typ->NmbLin = NmbLin;
+   GetWrk(typ, NmbLin)->EndIdx = NmbLin;
+
+   // Without dependencies, the new WP may run along with any other
+   if(typ->NexGrp && !AddGrp(par, typ, NewWrk, NmbNew))
+      return(0);
+
+   // Compute the size of big work-packages
+	if(NmbLin >= par->NmbCpu)
+	{
+		BigWrkSiz = NmbLin / par->NmbCpu;
+		NmbBigWrk = par->NmbCpu;
+	}
+	else
+	{
+		BigWrkSiz = NmbLin;
+		NmbBigWrk = 1;
+	}
+
+	// Set big work-packages
+	idx = 0;
+
+	for(i=0;i<NmbBigWrk;i++)
+	{
+		typ->BigWrkTab[i].ItlTab[0][0] = idx + 1;
+		typ->BigWrkTab[i].ItlTab[0][1] = idx + BigWrkSiz;
+		idx += BigWrkSiz;
+	}
+
+	typ->BigWrkTab[ NmbBigWrk - 1 ].ItlTab[0][1] = NmbLin;
+
+   return(TypIdx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set big work blocks interleaving                                           */
+/*----------------------------------------------------------------------------*/
+
+static void SetItlBlk(ParSct *par, TypSct *typ)
+{
+   itg      i, j, BegIdx, EndIdx, CpuIdx = 0, PagIdx[ MaxPth ] = {0};
+   double   ItlSiz, ItlIdx = 0.;
+
+   // Set big WP interleaved indices and block sizes if requested
+   if(par->NmbItlBlk)
+      ItlSiz = (double)typ->NmbLin / (double)(par->NmbItlBlk * par->NmbCpu);
+   else if(par->ItlBlkSiz)
+   {
+      par->NmbItlBlk = typ->NmbLin / (par->ItlBlkSiz * par->NmbCpu);
+      ItlSiz = (double)par->ItlBlkSiz;
+   }
+
+   // In case the block or lines numbers is too small, deactivate interleaving
+   if(!par->NmbItlBlk || !ItlSiz)
+   {
+      par->NmbItlBlk = 1;
+      ItlSiz = (double)typ->NmbLin / (double)(par->NmbCpu);
+   }
+
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      for(j=0;j<par->NmbItlBlk;j++)
+      {
+         BegIdx = (itg)(ItlIdx + 1.);
+         EndIdx = (itg)(ItlIdx + ItlSiz);
+         ItlIdx += ItlSiz;
+
+         if(BegIdx <= EndIdx)
+         {
+            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][0] = BegIdx;
+            typ->BigWrkTab[ CpuIdx ].ItlTab[ PagIdx[ CpuIdx ] ][1] = EndIdx;
+            PagIdx[ CpuIdx ]++;
+            CpuIdx++;
+            CpuIdx = CpuIdx % par->NmbCpu;
+         }
+      }
+   }
+
+   typ->BigWrkTab[ par->NmbCpu - 1 ].ItlTab[ par->NmbItlBlk - 1 ][1] = typ->NmbLin;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Add this kind of element to the free-list                                  */
+/*----------------------------------------------------------------------------*/
+
+void FreeType(int64_t ParIdx, int TypIdx)
+{
+   TypSct *typ;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return;
+
+   WaiAsy(par);
+
+   // Check bounds and free mem
+   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
+      return;
+
+   typ = &par->TypTab[ TypIdx ];
+
+   FreLvl(par, typ);
+   FreSps(par, typ);
+   FreGeo(par, typ);
+
+   PolFre(par, typ->SmlWrkTab);
+
+   if(typ->BigWrkTab)
+      LPL_free(par->lmb, typ->BigWrkTab);
+
+   PolFre(par, typ->RunDepAdr);
+   PolFre(par, typ->DepMatAdr);
+   PolFre(par, typ->OrdTab);
+
+   FreGrp(par, typ);
+   memset(typ, 0, sizeof(TypSct));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Allocate a dependency matrix linking both types                            */
+/*----------------------------------------------------------------------------*/
+
+int BeginDependency(int64_t ParIdx, int TypIdx1, int TypIdx2)
+{
+   int i, WrdStr;
+   TypSct *typ1, *typ2;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   WaiAsy(par);
+
+   // Check bounds
+   par->CurTyp = typ1 = &par->TypTab[ TypIdx1 ];
+   par->DepTyp = typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin || !typ2->NmbLin)
+   {
+      return(0);
+   }
+
+   FreLvl(par, typ1);
+   typ1->DepIdx = TypIdx2;
+
+   // Compute dependency table's size
+   if( (typ2->NmbLin >= par->NmbDepBlk * par->NmbCpu)
+   &&  (typ2->NmbLin >= typ1->DepWrkSiz * 64) )
+   {
+      typ1->DepWrkSiz = typ2->NmbLin / (par->NmbDepBlk * par->NmbCpu);
+      typ1->NmbDepWrd = typ2->NmbLin / (typ1->DepWrkSiz * 64);
+
+      if(typ2->NmbLin != typ1->NmbDepWrd * typ1->DepWrkSiz * 64)
+         typ1->NmbDepWrd++;
+   }
+   else
+   {
+      typ1->DepWrkSiz = typ2->NmbLin;
+      typ1->NmbDepWrd = 1;
+   }
+
+   // Free the tables of a previous dependency
+   PolFre(par, typ1->DepMatAdr);
+   PolFre(par, typ1->RunDepAdr);
+
+   typ1->DepMatAdr = typ1->RunDepAdr = NULL;
+   typ1->DepWrdMat = NULL;
+   FreSps(par, typ1);
+   typ1->DepErr = 0;
+
+   // The automatic mode stores as lists the WP whose words outnumber their
+   // lines SpsRat times, most of them would stay empty in a dense matrix
+   if(par->DepMod == AutDep)
+      typ1->SpsFlg = ((int64_t)typ1->NmbDepWrd > (int64_t)SpsRat * typ1->SmlWrkSiz);
+   else
+      typ1->SpsFlg = (par->DepMod == SpsDep);
+
+   WrdStr = typ1->NmbDepWrd * par->SizMul;
+   WrdStr = ((WrdStr + WrdAln - 1) / WrdAln) * WrdAln;
+   typ1->DepWrdStr = WrdStr;
+
+   // Allocate a global dependency table, each WP's words start on a cache line
+   // Sparse WP allocate their own list of words while dependencies are added
+   if( !typ1->SpsFlg && !(typ1->DepWrdMat = typ1->DepMatAdr = PolAlc(par,
+         (int64_t)typ1->MaxSmlWrk * WrdStr * sizeof(uint64_t))) )
+   {
+      return(0);
+   }
+
+   // Then spread sub-tables among WP
+   for(i=0;i<typ1->MaxSmlWrk;i++)
+   {
+      typ1->SmlWrkTab[i].NmbDep = 0;
+      typ1->SmlWrkTab[i].DepWrdTab =
+         typ1->SpsFlg ? NULL : &typ1->DepWrdMat[ (int64_t)i * WrdStr ];
+   }
+
+   // Allocate a running tags table
+   if(!(typ1->RunDepTab = typ1->RunDepAdr = PolAlc(par, WrdStr * sizeof(uint64_t))))
+      return(0);
+
+   // Allocate the table giving the WP in index order as they may be sorted
+   PolFre(par, typ1->OrdTab);
+
+   if(!(typ1->OrdTab = PolAlc(par, (int64_t)typ1->MaxSmlWrk * sizeof(WrkSct *))))
+      return(0);
+
+   // A previous sort may have moved the WP, their position is given by their lines
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+      typ1->SmlWrkTab[i].pos = (typ1->SmlWrkTab[i].BegIdx - 1) / typ1->SmlWrkSiz;
+
+   SetOrd(typ1);
+
+   return(typ1->NmbDepWrd);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Type1 element idx1 depends on type2 element idx2                           */
+/*----------------------------------------------------------------------------*/
+
+int AddDependency(int64_t ParIdx, itg idx1, itg idx2)
+{
+   WrkSct *wrk;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if( !par || !par->CurTyp || !par->CurTyp->SmlWrkSiz
+   ||  !par->CurTyp->DepWrkSiz || !par->DepTyp || (idx1 < 1)
+   ||  (idx1 > par->CurTyp->NmbLin) || (idx2 < 1)
+   ||  (idx2 > par->DepTyp->NmbLin) )
+   {
+      return(0);
+   }
+
+   WaiAsy(par);
+
+   // Set and count dependency bit
+   wrk = GetWrk(par->CurTyp, PosLin(par->CurTyp, idx1));
+
+   if(!WrkBit(par, par->CurTyp, wrk, (PosLin(par->DepTyp, idx2) - 1) / par->CurTyp->DepWrkSiz ))
+      wrk->NmbDep++;
+
+   return(wrk->NmbDep);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set all to all dependencies without any pre-checking                       */
+/*----------------------------------------------------------------------------*/
+
+void AddDependencyFast( int64_t ParIdx, int NmbTyp1, itg *TabIdx1,
+                        int NmbTyp2, itg *TabIdx2 )
+{
+   int i, j;
+   ParSct *par = (ParSct *)ParIdx;
+   WrkSct *wrk;
+
+   WaiAsy(par);
+
+   for(i=0;i<NmbTyp1;i++)
+   {
+      wrk = GetWrk(par->CurTyp, PosLin(par->CurTyp, TabIdx1[i]));
+
+      for(j=0;j<NmbTyp2;j++)
+         if( !WrkBit(par, par->CurTyp, wrk,
+               (PosLin(par->DepTyp, TabIdx2[j]) - 1) / par->CurTyp->DepWrkSiz ) )
+            wrk->NmbDep++;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Type1 element idx1 depends on type2 element idx2                           */
+/*----------------------------------------------------------------------------*/
+
+int UpdateDependency(int64_t ParIdx, int TypIdx1, int TypIdx2,
+                     itg idx1, itg idx2 )
+{
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   WaiAsy(par);
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin || !typ2->NmbLin
+   ||  !typ1->SmlWrkSiz || !typ1->DepWrkSiz || (idx1 < 1)
+   ||  (idx1 > typ1->MaxNmbLin) || (idx2 < 1) || (idx2 > typ2->MaxNmbLin) )
+   {
+      return(0);
+   }
+
+   // Typ2 may have grown beyond the words allocated by BeginDependency
+   if(!GrwDep(par, typ1, typ2))
+      return(0);
+
+   // Set and count dependency bit in all block levels
+   return(LvlBit(par, typ1, PosLin(typ1, idx1),
+                 (PosLin(typ2, idx2) - 1) / typ1->DepWrkSiz));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Same as above, without any pre-checking of data                            */
+/*----------------------------------------------------------------------------*/
+
+void UpdateDependencyFast( int64_t ParIdx,  int TypIdx1, int NmbTyp1,
+                           itg *TabIdx1, int TypIdx2, int NmbTyp2,
+                           itg *TabIdx2 )
+{
+   int i, j;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1 = &par->TypTab[ TypIdx1 ], *typ2 = &par->TypTab[ TypIdx2 ];
+
+   WaiAsy(par);
+
+   if(!GrwDep(par, typ1, typ2))
+      return;
+
+   for(i=0;i<NmbTyp1;i++)
+      for(j=0;j<NmbTyp2;j++)
+         LvlBit(  par, typ1, PosLin(typ1, TabIdx1[i]),
+                  (PosLin(typ2, TabIdx2[j]) - 1) / typ1->DepWrkSiz );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build the dependencies between typ1 elements and the typ2 indices stored   */
+/* in EleTab (EleSiz per element, from index 1) with all the threads          */
+/*----------------------------------------------------------------------------*/
+
+int BuildDependencyParallel(int64_t ParIdx, int TypIdx1, int TypIdx2,
+                            int EleSiz, itg *EleTab, float DepSta[2])
+{
+   DepSct arg;
+   ParSct *par = (ParSct *)ParIdx;
+
+   WaiAsy(par);
+
+   // Get and check lib parallel instance and the connectivity table
+   if(!ParIdx || !EleTab || (EleSiz < 1) || !DepSta || par->typ1)
+      return(0);
+
+   if(!BeginDependency(ParIdx, TypIdx1, TypIdx2))
+      return(0);
+
+   arg.par = par;
+   arg.typ1 = par->CurTyp;
+   arg.typ2 = par->DepTyp;
+   arg.EleTab = EleTab;
+   arg.EleSiz = EleSiz;
+
+   // Each small WP is filled by a single thread so that no atomic is needed,
+   // but sparse lists are allocated on the fly and libMemBlocks is not
+   // thread safe
+#ifdef WITH_LIBMEMBLOCKS
+   if(arg.typ1->SpsFlg)
+      DepPrc(1, arg.typ1->NmbLin, 0, &arg);
+   else
+#endif
+   RunBig(par, arg.typ1, (void *)DepPrc, (void *)&arg);
+
+   return(EndDependency(ParIdx, DepSta));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set the dependencies of the small WP whose first line is in the range      */
+/*----------------------------------------------------------------------------*/
+
+static void DepPrc(itg BegIdx, itg EndIdx, int PthIdx, DepSct *arg)
+{
+   itg beg, end;
+   int k, BegWrk, EndWrk, siz = arg->typ1->SmlWrkSiz;
+   WrkSct *wrk;
+   (void)(PthIdx);
+
+   BegWrk = (BegIdx - 1 + siz - 1) / siz;
+   EndWrk = (EndIdx - 1) / siz;
+
+   for(k=BegWrk; k<=EndWrk; k++)
+   {
+      beg = k * siz + 1;
+      end = (k + 1) * siz;
+
+      if(end > arg->typ1->NmbLin)
+         end = arg->typ1->NmbLin;
+
+      wrk = GetWrk(arg->typ1, beg);
+      SetWrkDep(arg->par, arg->typ1, arg->typ2, wrk, beg, end, arg->EleSiz, arg->EleTab);
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set a WP's dependencies from the typ2 indices of its lines in EleTab       */
+/*----------------------------------------------------------------------------*/
+
+static void SetWrkDep(  ParSct *par, TypSct *typ1, TypSct *typ2, WrkSct *wrk,
+                        itg beg, itg end, int EleSiz, itg *EleTab )
+{
+   itg i, idx2, *LinTab;
+   int j;
+
+   // Positions follow the geometric order if any
+   for(i=beg; i<=end; i++)
+   {
+      LinTab = &EleTab[ (size_t)(typ1->GeoIdx && (i <= typ1->GeoNmb)
+                        ? typ1->GeoIdx[i] : i) * EleSiz ];
+
+      for(j=0;j<EleSiz;j++)
+      {
+         idx2 = LinTab[j];
+
+         if( (idx2 < 1) || (idx2 > typ2->NmbLin) )
+            continue;
+
+         if(!WrkBit(par, typ1, wrk, (PosLin(typ2, idx2) - 1) / typ1->DepWrkSiz))
+            wrk->NmbDep++;
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Move a type's WP to new tables from the pool able to hold NewMax WP,       */
+/* their dependency words and static groups follow them                       */
+/*----------------------------------------------------------------------------*/
+
+static int ReaTyp(ParSct *par, TypSct *typ, int NewMax)
+{
+   int      i, j, k, NmbCpy = (NewMax < typ->MaxSmlWrk) ? NewMax : typ->MaxSmlWrk;
+   int64_t  str = typ->DepWrdStr;
+   uint64_t *NewMat = NULL;
+   GrpSct   *grp;
+   WrkSct   *NewWrk, **NewOrd = NULL;
+
+   if( !(NewWrk = PolAlc(par, (int64_t)NewMax * sizeof(WrkSct)))
+   ||  (typ->OrdTab && !(NewOrd = PolAlc(par, (int64_t)NewMax * sizeof(WrkSct *))))
+   ||  (typ->DepWrdMat && !(NewMat = PolAlc(par, NewMax * str * sizeof(uint64_t)))) )
+   {
+      PolFre(par, NewWrk);
+      PolFre(par, NewOrd);
+      return(0);
+   }
+
+   memcpy(NewWrk, typ->SmlWrkTab, NmbCpy * sizeof(WrkSct));
+
+   // The WP left out are unused, only their sparse lists may remain
+   for(i=NewMax;i<typ->MaxSmlWrk;i++)
+      if(typ->SmlWrkTab[i].SpsMsk)
+         LPL_free(par->lmb, typ->SmlWrkTab[i].SpsMsk);
+
+   // Copy each WP's words to the slot of its new index
+   if(NewMat)
+      for(i=0;i<NewMax;i++)
+      {
+         if(i < NmbCpy)
+            memcpy(&NewMat[ i * str ], NewWrk[i].DepWrdTab, str * sizeof(uint64_t));
+
+         NewWrk[i].DepWrdTab = &NewMat[ i * str ];
+      }
+
+   for(grp = typ->NexGrp; grp; grp = grp->nex)
+      for(j=0;j<par->NmbCpu;j++)
+         for(k=0;k<grp->NmbSmlWrk[j];k++)
+            grp->SmlWrkTab[j][k] = &NewWrk[ grp->SmlWrkTab[j][k] - typ->SmlWrkTab ];
+
+   PolFre(par, typ->SmlWrkTab);
+   PolFre(par, typ->OrdTab);
+   PolFre(par, typ->DepMatAdr);
+
+   typ->SmlWrkTab = NewWrk;
+   typ->OrdTab = NewOrd;
+   typ->DepWrdMat = typ->DepMatAdr = NewMat;
+   typ->MaxSmlWrk = NewMax;
+   typ->MaxNmbLin = (itg)NewMax * typ->SmlWrkSiz;
+   SetOrd(typ);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Keep the first NmbSmlWrk WP positions: the remaining WP are packed in      */
+/* their current order and the removed ones are cleared after them            */
+/*----------------------------------------------------------------------------*/
+
+static int ShrTyp(ParSct *par, TypSct *typ, int NmbSmlWrk)
+{
+   int      i, j, k, n, NmbDel = typ->NmbSmlWrk - NmbSmlWrk, *MapTab;
+   GrpSct   *grp;
+   WrkSct   *wrk, *DelTab;
+
+   if(NmbDel <= 0)
+      return(1);
+
+   if(!(MapTab = LPL_malloc(par->lmb, typ->NmbSmlWrk * sizeof(int))))
+      return(0);
+
+   if(!(DelTab = LPL_malloc(par->lmb, NmbDel * sizeof(WrkSct))))
+   {
+      LPL_free(par->lmb, MapTab);
+      return(0);
+   }
+
+   // Each WP keeps its own words' slot wherever it is moved
+   for(i=j=k=0;i<typ->NmbSmlWrk;i++)
+   {
+      wrk = &typ->SmlWrkTab[i];
+
+      if((wrk->BegIdx - 1) / typ->SmlWrkSiz < NmbSmlWrk)
+      {
+         MapTab[i] = j;
+         typ->SmlWrkTab[ j++ ] = *wrk;
+      }
+      else
+      {
+         MapTab[i] = NmbSmlWrk + k;
+         DelTab[ k++ ] = *wrk;
+      }
+   }
+
+   for(k=0;k<NmbDel;k++)
+   {
+      wrk = &typ->SmlWrkTab[ NmbSmlWrk + k ];
+      *wrk = DelTab[k];
+
+      if(wrk->SpsMsk)
+         LPL_free(par->lmb, wrk->SpsMsk);
+
+      if(wrk->DepWrdTab)
+         memset(wrk->DepWrdTab, 0, typ->DepWrdStr * sizeof(uint64_t));
+
+      wrk->SpsMsk = NULL;
+      wrk->SpsIdx = NULL;
+      wrk->NmbSps = wrk->MaxSps = wrk->NmbDep = wrk->upd = wrk->flg = 0;
+   }
+
+   // Static groups keep the remaining WP at their new index
+   for(grp = typ->NexGrp; grp; grp = grp->nex)
+      for(i=0;i<par->NmbCpu;i++)
+      {
+         for(j=n=0;j<grp->NmbSmlWrk[i];j++)
+            if((k = MapTab[ grp->SmlWrkTab[i][j] - typ->SmlWrkTab ]) < NmbSmlWrk)
+               grp->SmlWrkTab[i][ n++ ] = &typ->SmlWrkTab[k];
+
+         grp->NmbSmlWrk[i] = n;
+      }
+
+   LPL_free(par->lmb, MapTab);
+   LPL_free(par->lmb, DelTab);
+
+   typ->NmbSmlWrk = NmbSmlWrk;
+
+   if(typ->NmbSrtWrk > NmbSmlWrk)
+      typ->NmbSrtWrk = NmbSmlWrk;
+
+   DelGrp(par, typ);
+   SetOrd(typ);
+
+   // Give the tables back to the pool once mostly unused,
+   // keep the current ones if smaller cannot be allocated
+   if(4 * NmbSmlWrk <= typ->MaxSmlWrk)
+      ReaTyp(par, typ, NmbSmlWrk * par->SizMul);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Widen typ1's dependency words to cover all the lines typ2 may hold         */
+/*----------------------------------------------------------------------------*/
+
+static int GrwDep(ParSct *par, TypSct *typ1, TypSct *typ2)
+{
+   int      i, NmbWrd, NewStr;
+   uint64_t *NewMat = NULL, *NewRun;
+
+   if(!typ1->DepWrkSiz || !typ1->RunDepTab)
+      return(0);
+
+   NmbWrd = (typ2->MaxNmbLin - 1) / typ1->DepWrkSiz / 64 + 1;
+
+   if(NmbWrd <= typ1->DepWrdStr)
+      return(1);
+
+   NewStr = (NmbWrd > 2 * typ1->DepWrdStr) ? NmbWrd : 2 * typ1->DepWrdStr;
+   NewStr = ((NewStr + WrdAln - 1) / WrdAln) * WrdAln;
+
+   // Levels are built with the current stride
+   FreLvl(par, typ1);
+
+   if( !(NewRun = PolAlc(par, NewStr * sizeof(uint64_t)))
+   ||  (typ1->DepWrdMat && !(NewMat = PolAlc(par,
+         (int64_t)typ1->MaxSmlWrk * NewStr * sizeof(uint64_t)))) )
+   {
+      PolFre(par, NewRun);
+      return(0);
+   }
+
+   if(NewMat)
+   {
+      for(i=0;i<typ1->MaxSmlWrk;i++)
+      {
+         memcpy(&NewMat[ (int64_t)i * NewStr ], typ1->SmlWrkTab[i].DepWrdTab,
+                typ1->DepWrdStr * sizeof(uint64_t));
+         typ1->SmlWrkTab[i].DepWrdTab = &NewMat[ (int64_t)i * NewStr ];
+      }
+
+      PolFre(par, typ1->DepMatAdr);
+      typ1->DepWrdMat = typ1->DepMatAdr = NewMat;
+   }
+
+   PolFre(par, typ1->RunDepAdr);
+   typ1->RunDepTab = typ1->RunDepAdr = NewRun;
+   typ1->DepWrdStr = NewStr;
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the WP containing a line, wherever the sorting has moved it         */
+/*----------------------------------------------------------------------------*/
+
+static WrkSct *GetWrk(TypSct *typ, itg idx)
+{
+   int pos = (idx - 1) / typ->SmlWrkSiz;
+
+   // WP beyond the current number of lines are never sorted
+   if(!typ->OrdTab || (pos >= typ->NmbSmlWrk))
+      return(&typ->SmlWrkTab[ pos ]);
+
+   return(typ->OrdTab[ pos ]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Rebuild the WP's index order table from their position                     */
+/*----------------------------------------------------------------------------*/
+
+static void SetOrd(TypSct *typ)
+{
+   int i;
+
+   if(!typ->OrdTab)
+      return;
+
+   for(i=0;i<typ->NmbSmlWrk;i++)
+      typ->OrdTab[ typ->SmlWrkTab[i].pos ] = &typ->SmlWrkTab[i];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort wp depending on their number of dependencies                          */
+/*----------------------------------------------------------------------------*/
+
+int EndDependency(int64_t ParIdx, float DepSta[2])
+{
+   int      i;
+   ParSct   *par = (ParSct *)ParIdx;
+   TypSct   *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if( !ParIdx || !DepSta )
+      return(0);
+
+   WaiAsy(par);
+
+   // Compute average number of collisions
+   DepSta[1] = 0.;
+   typ1 = par->CurTyp;
+   typ2 = par->DepTyp;
+
+   if(!typ1 || !typ2 || !typ1->DepWrkSiz || typ1->DepErr)
+      return(0);
+
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+      typ1->SmlWrkTab[i].rnd = rand();
+
+   if(!SetDepSta(typ1, typ2, DepSta))
+      return(0);
+
+   // Sort WP from highest collision number to the lowest
+   if(par->WrkSizSrt && par->DynSch)
+   {
+      qsort(typ1->SmlWrkTab, typ1->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+      SetOrd(typ1);
+   }
+
+   // If the dynamic scheduling is disabled, set static WP
+   if(!par->DynSch && !SetGrp(par, typ1))
+      return(0);
+
+   // Otherwise build the coarser levels for the automatic block sizing,
+   // the finest WP alone remain usable if it fails
+   if(par->AutBlk && par->DynSch)
+      BldLvl(par, typ1);
+
+   typ1->NmbSrtWrk = typ1->NmbSmlWrk;
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compute the average and maximum dependency ratios, in percent              */
+/*----------------------------------------------------------------------------*/
+
+static int SetDepSta(TypSct *typ1, TypSct *typ2, float DepSta[2])
+{
+   int i, NmbDepBit, TotNmbDep = 0;
+
+   DepSta[1] = 0.;
+
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+   {
+      TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
+
+      if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
+         DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
+   }
+
+   if(!TotNmbDep)
+      return(0);
+
+   DepSta[0] = (float)TotNmbDep;
+
+   // Compute stats
+   if(typ2->NmbLin >= typ1->DepWrkSiz)
+   {
+      NmbDepBit = typ2->NmbLin / typ1->DepWrkSiz;
+
+      if(typ2->NmbLin - NmbDepBit * typ1->DepWrkSiz)
+         NmbDepBit++;
+   }
+   else
+      NmbDepBit = 1;
+
+   if(!NmbDepBit)
+      return(0);
+
+   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
+   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Incrementally update the dependencies of typ1 against typ2 after a local   */
+/* modification: the WP holding the NmbLin lines listed in LinTab lose all    */
+/* their dependencies, which are rebuilt from the typ2 indices of all their   */
+/* lines in EleTab (EleSiz per line, from index 1) as BuildDependencyParallel */
+/* does                                                                       */
+/* The WP appended by ResizeType are handled too, be they listed or set with  */
+/* UpdateDependency, and NmbLin may be 0 to only account for the latter       */
+/* Only the modified WP are sorted back or regrouped with static scheduling   */
+/*----------------------------------------------------------------------------*/
+
+int RefreshDependency(  int64_t ParIdx, int TypIdx1, int TypIdx2, itg NmbLin,
+                        itg *LinTab, int EleSiz, itg *EleTab, float DepSta[2] )
+{
+   int      i, NmbUpd = 0;
+   itg      idx;
+   WrkSct   *wrk;
+   TypSct   *typ1, *typ2;
+   ParSct   *par = (ParSct *)ParIdx;
+
+   WaiAsy(par);
+
+   // Get and check lib parallel instance and arguments
+   if( !ParIdx || !DepSta || (NmbLin < 0) || par->typ1
+   ||  (NmbLin && (!LinTab || !EleTab || (EleSiz < 1))) )
+   {
+      return(0);
+   }
+
+   // Check bounds and that typ1 dependencies were built
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (TypIdx1 == TypIdx2) )
+   {
+      return(0);
+   }
+
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if(!typ1->NmbLin || !typ2->NmbLin || !typ1->DepWrkSiz || !typ1->RunDepTab)
+      return(0);
+
+   FreLvl(par, typ1);
+
+   // Enlarge the words to the lines typ2 gained since
+   if(!GrwDep(par, typ1, typ2))
+      return(0);
+
+   // Clear the WP holding the modified lines
+   for(i=0;i<NmbLin;i++)
+   {
+      idx = LinTab[i];
+
+      if( (idx < 1) || (idx > typ1->NmbLin) )
+         continue;
+
+      wrk = GetWrk(typ1, PosLin(typ1, idx));
+
+      if(wrk->upd)
+         continue;
+
+      wrk->upd = 1;
+      wrk->NmbDep = 0;
+      wrk->NmbSps = 0;
+
+      if(!typ1->SpsFlg)
+         memset(wrk->DepWrdTab, 0, typ1->NmbDepWrd * sizeof(uint64_t));
+
+      SetWrkDep(par, typ1, typ2, wrk, wrk->BegIdx, wrk->EndIdx, EleSiz, EleTab);
+   }
+
+   if(typ1->DepErr)
+      return(0);
+
+   // The WP appended since the last sort are modified as well
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+   {
+      wrk = &typ1->SmlWrkTab[i];
+
+      if(wrk->pos >= typ1->NmbSrtWrk)
+         wrk->upd = 1;
+
+      if(wrk->upd)
+      {
+         wrk->rnd = rand();
+         NmbUpd++;
+      }
+   }
+
+   if(!SetDepSta(typ1, typ2, DepSta))
+      return(0);
+
+   // Merge the modified WP back into the sorted ones
+   if(NmbUpd && par->WrkSizSrt && par->DynSch && !MrgWrk(par, typ1, NmbUpd))
+      return(0);
+
+   // Regroup them with static scheduling
+   if(NmbUpd && !par->DynSch && !UpdGrp(par, typ1))
+      return(0);
+
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+      typ1->SmlWrkTab[i].upd = 0;
+
+   if(par->AutBlk && par->DynSch)
+      BldLvl(par, typ1);
+
+   typ1->NmbSrtWrk = typ1->NmbSmlWrk;
+
+   return(NmbUpd);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort the modified WP and merge them with the others, which are still in    */
+/* decreasing dependency order                                                */
+/*----------------------------------------------------------------------------*/
+
+static int MrgWrk(ParSct *par, TypSct *typ, int NmbUpd)
+{
+   int i, j, k;
+   WrkSct *UpdTab;
+
+   if(!(UpdTab = LPL_malloc(par->lmb, NmbUpd * sizeof(WrkSct))))
+      return(0);
+
+   // Extract the modified WP and pack the others, keeping their order
+   for(i=j=k=0;i<typ->NmbSmlWrk;i++)
+   {
+      if(typ->SmlWrkTab[i].upd)
+         UpdTab[ k++ ] = typ->SmlWrkTab[i];
+      else
+      {
+         if(j < i)
+            typ->SmlWrkTab[j] = typ->SmlWrkTab[i];
+
+         j++;
+      }
+   }
+
+   qsort(UpdTab, k, sizeof(WrkSct), CmpWrk);
+
+   // Merge both sorted lists from the end of the table
+   for(i=typ->NmbSmlWrk-1, j--, k--; k>=0; i--)
+   {
+      if( (j >= 0) && (CmpWrk(&typ->SmlWrkTab[j], &UpdTab[k]) > 0) )
+         typ->SmlWrkTab[i] = typ->SmlWrkTab[ j-- ];
+      else
+         typ->SmlWrkTab[i] = UpdTab[ k-- ];
+   }
+
+   LPL_free(par->lmb, UpdTab);
+   SetOrd(typ);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort wp depending on their number of dependencies                          */
+/*----------------------------------------------------------------------------*/
+
+void GetDependencyStats(int64_t ParIdx, int TypIdx1,
+                        int TypIdx2, float DepSta[2])
+{
+   int i, NmbDepBit, TotNmbDep = 0;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return;
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
+   ||  !typ2->NmbLin )
+   {
+      return;
+   }
+
+   // Compute average number of collisions
+   DepSta[1] = 0.;
+
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+   {
+      TotNmbDep += typ1->SmlWrkTab[i].NmbDep;
+
+      if(typ1->SmlWrkTab[i].NmbDep > DepSta[1])
+         DepSta[1] = (float)typ1->SmlWrkTab[i].NmbDep;
+   }
+
+   DepSta[0] = (float)TotNmbDep;
+
+   // Compute stats
+   if(typ2->NmbLin >= typ1->DepWrkSiz)
+   {
+      NmbDepBit = typ2->NmbLin / typ1->DepWrkSiz;
+
+      if(typ2->NmbLin - NmbDepBit * typ1->DepWrkSiz)
+         NmbDepBit++;
+   }
+   else
+      NmbDepBit = 1;
+
+   DepSta[0] = 100 * DepSta[0] / (typ1->NmbSmlWrk * NmbDepBit);
+   DepSta[1] = 100 * DepSta[1] / NmbDepBit;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Halve the number of small blocks by compining pairs of consecutive blocks  */
+/*----------------------------------------------------------------------------*/
+
+int HalveSmallBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+{
+   int i, j, k;
+   ParSct *par = (ParSct *)ParIdx;
+   WrkSct *EvnWrk, *OddWrk, *NewWrk;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   WaiAsy(par);
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
+   ||  !typ2->NmbLin )
+   {
+      return(0);
+   }
+
+   // Manual sizing replaces the automatic hierarchy
+   FreLvl(par, typ1);
+
+   // Do not halve the number of blocks if there is only one left
+   // nor if the small blocks have been sorted
+   if(typ1->NmbSmlWrk < 2 || par->WrkSizSrt)
+      return(0);
+
+   // For each new block, compute the logical OR between two consecutive old blocks
+   // The new data is copied on top of former one
+   for(i=0;i<typ1->NmbSmlWrk;i+=2)
+   {
+      EvnWrk = &typ1->SmlWrkTab[ i     ];
+      OddWrk = &typ1->SmlWrkTab[ i + 1 ];
+      NewWrk = &typ1->SmlWrkTab[ i / 2 ];
+      NewWrk->BegIdx = EvnWrk->BegIdx;
+      NewWrk->EndIdx = (i+1 < typ1->NmbSmlWrk) ? OddWrk->EndIdx : EvnWrk->EndIdx;
+
+      if(typ1->SpsFlg)
+      {
+         // Move the even block's list to the new one and merge the odd one
+         if(NewWrk != EvnWrk)
+         {
+            NewWrk->NmbSps = EvnWrk->NmbSps;
+            NewWrk->MaxSps = EvnWrk->MaxSps;
+            NewWrk->SpsIdx = EvnWrk->SpsIdx;
+            NewWrk->SpsMsk = EvnWrk->SpsMsk;
+            EvnWrk->NmbSps = EvnWrk->MaxSps = 0;
+            EvnWrk->SpsIdx = NULL;
+            EvnWrk->SpsMsk = NULL;
+         }
+
+         if(i+1 < typ1->NmbSmlWrk)
+         {
+            for(j=0;j<OddWrk->NmbSps;j++)
+               for(k=0;k<64;k++)
+                  if(OddWrk->SpsMsk[j] & (1ULL << k))
+                     WrkBit(par, typ1, NewWrk, OddWrk->SpsIdx[j] * 64 + k);
+
+            if(OddWrk->SpsMsk)
+               LPL_free(par->lmb, OddWrk->SpsMsk);
+
+            OddWrk->NmbSps = OddWrk->MaxSps = 0;
+            OddWrk->SpsIdx = NULL;
+            OddWrk->SpsMsk = NULL;
+         }
+
+         continue;
+      }
+
+      for(j=0;j<typ1->NmbDepWrd;j++)
+         if(i+1 < typ1->NmbSmlWrk)
+            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j] | OddWrk->DepWrdTab[j];
+         else
+            NewWrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j];
+   }
+
+   if(typ1->DepErr)
+      return(0);
+
+   // Halve the number of blocks and add one if the number was odd
+   typ1->SmlWrkSiz *= typ1->NmbSmlWrk;
+
+   if(typ1->NmbSmlWrk & 1)
+      typ1->NmbSmlWrk = typ1->NmbSmlWrk / 2 + 1;
+   else
+      typ1->NmbSmlWrk /= 2;
+
+   typ1->SmlWrkSiz /= typ1->NmbSmlWrk;
+
+   // Blocks are not sorted so that their position is their index
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+      typ1->SmlWrkTab[i].pos = i;
+
+   SetOrd(typ1);
+
+   return(typ1->NmbSmlWrk);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build a hierarchy of small blocks: level 0 holds the type's WP and each    */
+/* next level merges the consecutive pairs of WP of the previous one          */
+/* Returns the number of levels or 0 if it ran out of memory                  */
+/*----------------------------------------------------------------------------*/
+
+static int BldLvl(ParSct *par, TypSct *typ)
+{
+   int i, j, k, n, WrdStr, err = 0;
+   LvlSct *src, *dst;
+   WrkSct *wrk, *EvnWrk, *OddWrk;
+
+   if(!typ->LvlTab && !(typ->LvlTab = LPL_calloc(par->lmb, MaxLvl, sizeof(LvlSct))))
+      return(0);
+
+   // Level 0 keeps the WP set by the dependency
+   dst = &typ->LvlTab[0];
+   dst->NmbSmlWrk = typ->NmbSmlWrk;
+   dst->SmlWrkSiz = typ->SmlWrkSiz;
+   dst->SmlWrkTab = typ->SmlWrkTab;
+   dst->OrdTab = typ->OrdTab;
+   dst->DepWrdMat = typ->DepWrdMat;
+   dst->DepMatAdr = typ->DepMatAdr;
+   typ->NmbLvl = 1;
+   typ->CurLvl = typ->LstLvl = typ->LvlCnt = 0;
+
+   WrdStr = ((typ->NmbDepWrd + WrdAln - 1) / WrdAln) * WrdAln;
+
+   // Stop merging when there would be too few WP to feed all threads
+   while( (typ->NmbLvl < MaxLvl)
+   &&     (typ->LvlTab[ typ->NmbLvl - 1 ].NmbSmlWrk >= 4 * par->NmbCpu) )
+   {
+      src = &typ->LvlTab[ typ->NmbLvl - 1 ];
+      dst = &typ->LvlTab[ typ->NmbLvl ];
+      n = (src->NmbSmlWrk + 1) / 2;
+
+      dst->NmbSmlWrk = n;
+      dst->SmlWrkSiz = src->SmlWrkSiz * 2;
+      dst->WrdStr = WrdStr;
+      dst->SmlWrkTab = LPL_calloc(par->lmb, n, sizeof(WrkSct));
+      dst->OrdTab = LPL_malloc(par->lmb, n * sizeof(WrkSct *));
+
+      if( !typ->SpsFlg && !(dst->DepWrdMat = LPL_aligned_calloc(par->lmb,
+            (int64_t)n * WrdStr * sizeof(uint64_t), &dst->DepMatAdr)) )
+      {
+         err = 1;
+      }
+
+      // The level is counted right away so that FreLvl can release it
+      typ->NmbLvl++;
+
+      if(!dst->SmlWrkTab || !dst->OrdTab || err)
+      {
+         err = 1;
+         break;
+      }
+
+      // Merge the pairs of WP taken in index order as they may be sorted
+      for(i=0;i<n;i++)
+      {
+         wrk = &dst->SmlWrkTab[i];
+         EvnWrk = src->OrdTab[ 2*i ];
+         OddWrk = (2*i+1 < src->NmbSmlWrk) ? src->OrdTab[ 2*i+1 ] : NULL;
+         wrk->BegIdx = EvnWrk->BegIdx;
+         wrk->EndIdx = OddWrk ? OddWrk->EndIdx : EvnWrk->EndIdx;
+         wrk->pos = i;
+         wrk->rnd = rand();
+
+         if(!typ->SpsFlg)
+         {
+            wrk->DepWrdTab = &dst->DepWrdMat[ (int64_t)i * WrdStr ];
+
+            for(j=0;j<typ->NmbDepWrd;j++)
+            {
+               wrk->DepWrdTab[j] = EvnWrk->DepWrdTab[j] | (OddWrk ? OddWrk->DepWrdTab[j] : 0);
+               wrk->NmbDep += BitCnt(wrk->DepWrdTab[j]);
+            }
+
+            continue;
+         }
+
+         for(j=0;j<EvnWrk->NmbSps;j++)
+            for(k=0;k<64;k++)
+               if( (EvnWrk->SpsMsk[j] & (1ULL << k))
+               &&  !WrkBit(par, typ, wrk, EvnWrk->SpsIdx[j] * 64 + k) )
+               {
+                  wrk->NmbDep++;
+               }
+
+         for(j=0; OddWrk && (j<OddWrk->NmbSps); j++)
+            for(k=0;k<64;k++)
+               if( (OddWrk->SpsMsk[j] & (1ULL << k))
+               &&  !WrkBit(par, typ, wrk, OddWrk->SpsIdx[j] * 64 + k) )
+               {
+                  wrk->NmbDep++;
+               }
+      }
+
+      // Sparse lists report their allocation failures through DepErr
+      if(typ->DepErr)
+      {
+         typ->DepErr = 0;
+         err = 1;
+         break;
+      }
+
+      // Sort the level's WP like the finest ones
+      SetLvl(typ, typ->NmbLvl - 1);
+
+      if(par->WrkSizSrt)
+         qsort(typ->SmlWrkTab, typ->NmbSmlWrk, sizeof(WrkSct), CmpWrk);
+
+      SetOrd(typ);
+   }
+
+   SetLvl(typ, 0);
+
+   if(err)
+   {
+      FreLvl(par, typ);
+      return(0);
+   }
+
+   return(typ->NmbLvl);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Make a level's WP the current ones of the type                             */
+/*----------------------------------------------------------------------------*/
+
+static void SetLvl(TypSct *typ, int idx)
+{
+   LvlSct *lvl = &typ->LvlTab[ idx ];
+
+   typ->CurLvl = idx;
+   typ->NmbSmlWrk = lvl->NmbSmlWrk;
+   typ->SmlWrkSiz = lvl->SmlWrkSiz;
+   typ->SmlWrkTab = lvl->SmlWrkTab;
+   typ->OrdTab = lvl->OrdTab;
+   typ->DepWrdMat = lvl->DepWrdMat;
+   typ->DepMatAdr = lvl->DepMatAdr;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Pick the level of the next launch: the fastest one measured so far,        */
+/* unless one of its neighbours has not been timed yet.                       */
+/* A poor concurrency factor tries the finer level first, while too short     */
+/* WP try the coarser one first                                               */
+/*----------------------------------------------------------------------------*/
+
+static void ChsLvl(ParSct *par, TypSct *typ)
+{
+   int i, BstLvl = -1, FinLvl, CrsLvl, NxtLvl;
+   LvlSct *lvl;
+
+   // Forget the neighbours' timings once in a while to probe them again
+   if(!(++typ->LvlCnt % LvlPrb))
+      for(i=0;i<typ->NmbLvl;i++)
+         if(i != typ->LstLvl)
+            typ->LvlTab[i].tim = 0.;
+
+   for(i=0;i<typ->NmbLvl;i++)
+      if( typ->LvlTab[i].tim
+      &&  ((BstLvl < 0) || (typ->LvlTab[i].tim < typ->LvlTab[ BstLvl ].tim)) )
+      {
+         BstLvl = i;
+      }
+
+   if(BstLvl < 0)
+   {
+      typ->LstLvl = 0;
+      return;
+   }
+
+   lvl = &typ->LvlTab[ BstLvl ];
+   FinLvl = ((BstLvl > 0) && !typ->LvlTab[ BstLvl - 1 ].tim) ? BstLvl - 1 : -1;
+   CrsLvl = ((BstLvl < typ->NmbLvl - 1) && !typ->LvlTab[ BstLvl + 1 ].tim)
+          ? BstLvl + 1 : -1;
+
+   if( (FinLvl >= 0) && (lvl->acc < par->NmbCpu / 2.)
+   &&  (lvl->tim * par->NmbCpu / lvl->NmbSmlWrk >= MinWrkTim) )
+   {
+      NxtLvl = FinLvl;
+   }
+   else if(CrsLvl >= 0)
+      NxtLvl = CrsLvl;
+   else if(FinLvl >= 0)
+      NxtLvl = FinLvl;
+   else
+      NxtLvl = BstLvl;
+
+   typ->LstLvl = NxtLvl;
+   SetLvl(typ, NxtLvl);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Record the timing and concurrency factor of the current level             */
+/*----------------------------------------------------------------------------*/
+
+static void UpdLvl(TypSct *typ, double tim, float acc)
+{
+   LvlSct *lvl = &typ->LvlTab[ typ->CurLvl ];
+
+   // Smooth the timings to filter out the noise
+   lvl->tim = lvl->tim ? .7 * lvl->tim + .3 * tim : tim;
+   lvl->acc = acc;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set a dependency bit in the WP holding a line at every level, as the       */
+/* coarser ones merge the finer ones' dependencies                            */
+/* The coarser levels only cover the lines the type had when they were built  */
+/* and their words are limited to their own stride: a bit beyond it drops     */
+/* them and the finest WP are used until the levels are built again           */
+/* Returns the number of dependencies of the finest WP                        */
+/*----------------------------------------------------------------------------*/
+
+static int LvlBit(ParSct *par, TypSct *typ, itg idx, int BitIdx)
+{
+   int i;
+   LvlSct *lvl;
+   WrkSct *wrk;
+
+   for(i=typ->NmbLvl-1; i>0; i--)
+   {
+      lvl = &typ->LvlTab[i];
+
+      if((idx - 1) / lvl->SmlWrkSiz >= lvl->NmbSmlWrk)
+         continue;
+
+      if(!typ->SpsFlg && ((BitIdx >> 6) >= lvl->WrdStr))
+      {
+         FreLvl(par, typ);
+         break;
+      }
+
+      SetLvl(typ, i);
+      wrk = GetWrk(typ, idx);
+
+      if(!WrkBit(par, typ, wrk, BitIdx))
+         wrk->NmbDep++;
+   }
+
+   // Finish with level 0 so that it stays the current one
+   if(typ->NmbLvl)
+      SetLvl(typ, 0);
+
+   wrk = GetWrk(typ, idx);
+
+   if(!WrkBit(par, typ, wrk, BitIdx))
+      wrk->NmbDep++;
+
+   return(wrk->NmbDep);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free the coarser levels and bring back the finest WP                       */
+/*----------------------------------------------------------------------------*/
+
+static void FreLvl(ParSct *par, TypSct *typ)
+{
+   int i, j;
+   LvlSct *lvl;
+
+   if(!typ->LvlTab)
+      return;
+
+   if(typ->NmbLvl)
+      SetLvl(typ, 0);
+
+   for(i=1;i<typ->NmbLvl;i++)
+   {
+      lvl = &typ->LvlTab[i];
+
+      if(lvl->SmlWrkTab)
+      {
+         for(j=0;j<lvl->NmbSmlWrk;j++)
+            if(lvl->SmlWrkTab[j].SpsMsk)
+               LPL_free(par->lmb, lvl->SmlWrkTab[j].SpsMsk);
+
+         LPL_free(par->lmb, lvl->SmlWrkTab);
+      }
+
+      if(lvl->OrdTab)
+         LPL_free(par->lmb, lvl->OrdTab);
+
+      if(lvl->DepMatAdr)
+         LPL_free(par->lmb, lvl->DepMatAdr);
+   }
+
+   LPL_free(par->lmb, typ->LvlTab);
+   typ->LvlTab = NULL;
+   typ->NmbLvl = typ->CurLvl = typ->LstLvl = typ->LvlCnt = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Halve the number of dependency words by ORing consecutive pairs of bits    */
+/*----------------------------------------------------------------------------*/
+
+int HalveDependencyBlocks(int64_t ParIdx, int TypIdx1, int TypIdx2)
+{
+   int i, j, idx, NmbSps;
+   uint64_t msk;
+   WrkSct *wrk;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ1, *typ2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
+
+   WaiAsy(par);
+
+   // Check bounds
+   typ1 = &par->TypTab[ TypIdx1 ];
+   typ2 = &par->TypTab[ TypIdx2 ];
+
+   if( (TypIdx1 < 1) || (TypIdx1 > MaxTyp) || (TypIdx2 < 1)
+   ||  (TypIdx2 > MaxTyp) || (typ1 == typ2) || !typ1->NmbLin
+   ||  !typ2->NmbLin )
+   {
+      return(0);
+   }
+
+   // Manual sizing replaces the automatic hierarchy
+   FreLvl(par, typ1);
+
+   // Do not halve the number of blocks if there is only one left
+   if(typ1->NmbDepWrd < 2)
+      return(0);
+
+   // Fold each pair of words into a single one: a word's lower half is
+   // overwritten only once it has been read
+   for(i=0;i<typ1->NmbSmlWrk;i++)
+   {
+      wrk = &typ1->SmlWrkTab[i];
+
+      if(typ1->SpsFlg)
+      {
+         // The lists are sorted, so both halves of a new word are consecutive
+         for(j=0, NmbSps=0; j<wrk->NmbSps; j++)
+         {
+            idx = wrk->SpsIdx[j] / 2;
+            msk = FldWrd(wrk->SpsMsk[j]) << ((wrk->SpsIdx[j] & 1) * 32);
+
+            if(NmbSps && (wrk->SpsIdx[ NmbSps - 1 ] == idx))
+               wrk->SpsMsk[ NmbSps - 1 ] |= msk;
+            else
+            {
+               wrk->SpsIdx[ NmbSps ] = idx;
+               wrk->SpsMsk[ NmbSps ] = msk;
+               NmbSps++;
+            }
+         }
+
+         wrk->NmbSps = NmbSps;
+         continue;
+      }
+
+      for(j=0;j<typ1->NmbDepWrd;j+=2)
+         wrk->DepWrdTab[ j/2 ] = FldWrd(wrk->DepWrdTab[j])
+                | ((j+1 < typ1->NmbDepWrd) ? FldWrd(wrk->DepWrdTab[ j+1 ]) << 32 : 0);
+
+      // Words beyond the used ones stay clear as WrkBit may use them later
+      for(j=(typ1->NmbDepWrd + 1) / 2; j<typ1->NmbDepWrd; j++)
+         wrk->DepWrdTab[j] = 0;
+   }
+
+   // Each bit now covers two former ones
+   typ1->DepWrkSiz *= 2;
+
+   if(typ1->NmbDepWrd & 1)
+      typ1->NmbDepWrd = typ1->NmbDepWrd / 2 + 1;
+   else
+      typ1->NmbDepWrd /= 2;
+
+   return(typ1->NmbDepWrd * 64);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Return the block ID containing the given element ID                        */
+/*----------------------------------------------------------------------------*/
+
+int GetBlkIdx(int64_t ParIdx, int typ, int idx)
+{
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(-1);
+
+   return( (PosLin(&par->TypTab[ typ ], idx) - 1) / par->TypTab[ typ ].SmlWrkSiz );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check whether two blocks are dependant or not from each others             */
+/*----------------------------------------------------------------------------*/
+
+int ChkBlkDep(int64_t ParIdx, int TypIdx, int blk1, int blk2)
+{
+   int i, j;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ;
+   WrkSct *wrk1, *wrk2;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(-1);
+
+   typ = &par->TypTab[ TypIdx ];
+   wrk1 = &typ->SmlWrkTab[ blk1 ];
+   wrk2 = &typ->SmlWrkTab[ blk2 ];
+
+   if(!typ->SpsFlg)
+      return(AndWrd(typ->NmbDepWrd, wrk1->DepWrdTab, wrk2->DepWrdTab));
+
+   // Merge both sorted lists of words
+   for(i=j=0; (i < wrk1->NmbSps) && (j < wrk2->NmbSps); )
+   {
+      if(wrk1->SpsIdx[i] < wrk2->SpsIdx[j])
+         i++;
+      else if(wrk1->SpsIdx[i] > wrk2->SpsIdx[j])
+         j++;
+      else if(wrk1->SpsMsk[i++] & wrk2->SpsMsk[j++])
+         return(1);
+   }
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Test and set a bit in a multibyte word                                     */
+/*----------------------------------------------------------------------------*/
+
+static int SetBit(uint64_t *tab, int idx)
+{
+   int res = ( (tab[ idx >> 6 ] & (1ULL << (idx & 63))) != 0 );
+   tab[ idx >> 6 ] |= 1ULL << (idx & 63);
+   return(res);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Test a bit in a multibyte word                                             */
+/*----------------------------------------------------------------------------*/
+
+static int GetBit(uint64_t *tab, int idx)
+{
+   return( (tab[ idx >> 6 ] & (1ULL << (idx & 63))) != 0 );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check wether two WP share common resources -> locked                       */
+/*----------------------------------------------------------------------------*/
+
+static int AndWrd(int NmbWrd, uint64_t *wrd1, uint64_t *wrd2)
+{
+   int i = 0;
+
+#ifdef VecWid
+   for(;i+VecWid<=NmbWrd;i+=VecWid)
+      if(VecTst(VecLod(&wrd1[i]), VecLod(&wrd2[i])))
+         return(1);
+#endif
+
+   for(;i<NmbWrd;i++)
+      if(wrd1[i] & wrd2[i])
+         return(1);
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Check wether a WP collides with a combined word minus a sub-word           */
+/*----------------------------------------------------------------------------*/
+
+static int AnnWrd(int NmbWrd, uint64_t *WrkWrd, uint64_t *AllWrd, uint64_t *SubWrd)
+{
+   int i = 0;
+
+#ifdef VecWid
+   for(;i+VecWid<=NmbWrd;i+=VecWid)
+      if(VecTst(VecLod(&WrkWrd[i]), VecAnn(VecLod(&AllWrd[i]), VecLod(&SubWrd[i]))))
+         return(1);
+#endif
+
+   for(;i<NmbWrd;i++)
+      if(WrkWrd[i] & AllWrd[i] & ~SubWrd[i])
+         return(1);
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Add a WP's word to the running one if they do not collide, in one pass:    */
+/* on a collision, the words already added are removed and 1 is returned      */
+/*----------------------------------------------------------------------------*/
+
+static int TstAddWrd(int NmbWrd, uint64_t *SrcWrd, uint64_t *DstWrd)
+{
+   int i = 0, j;
+
+#ifdef VecWid
+   VecTyp src, dst;
+
+   for(;i+VecWid<=NmbWrd;i+=VecWid)
+   {
+      src = VecLod(&SrcWrd[i]);
+      dst = VecLod(&DstWrd[i]);
+
+      if(VecTst(src, dst))
+      {
+         SubWrd(i, SrcWrd, DstWrd);
+         return(1);
+      }
+
+      VecSto(&DstWrd[i], VecOr(src, dst));
+   }
+#endif
+
+   for(j=i;j<NmbWrd;j++)
+   {
+      if(SrcWrd[j] & DstWrd[j])
+      {
+         SubWrd(j, SrcWrd, DstWrd);
+         return(1);
+      }
+
+      DstWrd[j] |= SrcWrd[j];
+   }
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Logical OR between two multibyte words                                     */
+/*----------------------------------------------------------------------------*/
+
+static void AddWrd(int NmbWrd, uint64_t *SrcWrd, uint64_t *DstWrd)
+{
+   int i = 0;
+
+#ifdef VecWid
+   for(;i+VecWid<=NmbWrd;i+=VecWid)
+      VecSto(&DstWrd[i], VecOr(VecLod(&DstWrd[i]), VecLod(&SrcWrd[i])));
+#endif
+
+   for(;i<NmbWrd;i++)
+      DstWrd[i] |= SrcWrd[i];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Exclusive OR between two multibyte words                                   */
+/*----------------------------------------------------------------------------*/
+
+static void SubWrd(int NmbWrd, uint64_t *SrcWrd, uint64_t *DstWrd)
+{
+   int i = 0;
+
+#ifdef VecWid
+   for(;i+VecWid<=NmbWrd;i+=VecWid)
+      VecSto(&DstWrd[i], VecAnn(VecLod(&DstWrd[i]), VecLod(&SrcWrd[i])));
+#endif
+
+   for(;i<NmbWrd;i++)
+      DstWrd[i] &= ~SrcWrd[i];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Clear a multibyte word                                                     */
+/*----------------------------------------------------------------------------*/
+
+static void ClrWrd(int NmbWrd, uint64_t *wrd)
+{
+   memset(wrd, 0, NmbWrd * sizeof(uint64_t));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Atomically set a WP's word into the running one, fails on any collision    */
+/*----------------------------------------------------------------------------*/
+
+static int ClaWrd(int NmbWrd, uint64_t *WrkWrd, uint64_t *RunWrd)
+{
+   int i, j;
+   uint64_t OldWrd;
+
+   for(i=0;i<NmbWrd;i++)
+   {
+      if(!WrkWrd[i])
+         continue;
+
+      OldWrd = AtmLod(&RunWrd[i]);
+
+      do
+      {
+         // In case of collision, remove the tags that were already set
+         if(OldWrd & WrkWrd[i])
+         {
+            for(j=0;j<i;j++)
+               if(WrkWrd[j])
+                  AtmAnd(&RunWrd[j], ~WrkWrd[j]);
+
+            return(0);
+         }
+      }while(!AtmCas(&RunWrd[i], &OldWrd, OldWrd | WrkWrd[i]));
+   }
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Atomically remove a WP's word from the running one                         */
+/*----------------------------------------------------------------------------*/
+
+static void RlsWrd(int NmbWrd, uint64_t *WrkWrd, uint64_t *RunWrd)
+{
+   int i;
+
+   for(i=0;i<NmbWrd;i++)
+      if(WrkWrd[i])
+         AtmAnd(&RunWrd[i], ~WrkWrd[i]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Fold a word's pairs of bits into its lower half                            */
+/*----------------------------------------------------------------------------*/
+
+static uint64_t FldWrd(uint64_t wrd)
+{
+   wrd = (wrd | (wrd >>  1)) & 0x5555555555555555ULL;
+   wrd = (wrd | (wrd >>  1)) & 0x3333333333333333ULL;
+   wrd = (wrd | (wrd >>  2)) & 0x0f0f0f0f0f0f0f0fULL;
+   wrd = (wrd | (wrd >>  4)) & 0x00ff00ff00ff00ffULL;
+   wrd = (wrd | (wrd >>  8)) & 0x0000ffff0000ffffULL;
+   wrd = (wrd | (wrd >> 16)) & 0x00000000ffffffffULL;
+   return(wrd);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* WP level dependency operations against a dense word: they either call the  */
+/* dense kernels or loop over the (word index, mask) list of a sparse WP      */
+/*----------------------------------------------------------------------------*/
+
+// Test and set a dependency bit
+static int WrkBit(ParSct *par, TypSct *typ, WrkSct *wrk, int idx)
+{
+   int res;
+
+   // Words are used up to the highest one set, within their allocation
+   if((idx >> 6) >= typ->DepWrdStr)
+   {
+      typ->DepErr = 1;
+      return(1);
+   }
+
+   if((idx >> 6) >= typ->NmbDepWrd)
+      typ->NmbDepWrd = (idx >> 6) + 1;
+
+   if(!typ->SpsFlg)
+      return(SetBit(wrk->DepWrdTab, idx));
+
+   if((res = SetSps(par, wrk, idx)) < 0)
+   {
+      typ->DepErr = 1;
+      return(1);
+   }
+
+   return(res);
+}
+
+// Add the WP to the word if there is no collision
+static int WrkTsa(TypSct *typ, WrkSct *wrk, uint64_t *wrd)
+{
+   int i, j;
+
+   if(!typ->SpsFlg)
+      return(TstAddWrd(typ->NmbDepWrd, wrk->DepWrdTab, wrd));
+
+   for(i=0;i<wrk->NmbSps;i++)
+   {
+      if(wrk->SpsMsk[i] & wrd[ wrk->SpsIdx[i] ])
+      {
+         for(j=0;j<i;j++)
+            wrd[ wrk->SpsIdx[j] ] &= ~wrk->SpsMsk[j];
+
+         return(1);
+      }
+
+      wrd[ wrk->SpsIdx[i] ] |= wrk->SpsMsk[i];
+   }
+
+   return(0);
+}
+
+// Check for a collision with a word minus a sub-word
+static int WrkAnn(TypSct *typ, WrkSct *wrk, uint64_t *AllWrd, uint64_t *SubWrd)
+{
+   int i;
+
+   if(!typ->SpsFlg)
+      return(AnnWrd(typ->NmbDepWrd, wrk->DepWrdTab, AllWrd, SubWrd));
+
+   for(i=0;i<wrk->NmbSps;i++)
+      if(wrk->SpsMsk[i] & AllWrd[ wrk->SpsIdx[i] ] & ~SubWrd[ wrk->SpsIdx[i] ])
+         return(1);
+
+   return(0);
+}
+
+// Logical OR
+static void WrkAdd(TypSct *typ, WrkSct *wrk, uint64_t *wrd)
+{
+   int i;
+
+   if(!typ->SpsFlg)
+   {
+      AddWrd(typ->NmbDepWrd, wrk->DepWrdTab, wrd);
+      return;
+   }
+
+   for(i=0;i<wrk->NmbSps;i++)
+      wrd[ wrk->SpsIdx[i] ] |= wrk->SpsMsk[i];
+}
+
+// Remove the WP's bits
+static void WrkSub(TypSct *typ, WrkSct *wrk, uint64_t *wrd)
+{
+   int i;
+
+   if(!typ->SpsFlg)
+   {
+      SubWrd(typ->NmbDepWrd, wrk->DepWrdTab, wrd);
+      return;
+   }
+
+   for(i=0;i<wrk->NmbSps;i++)
+      wrd[ wrk->SpsIdx[i] ] &= ~wrk->SpsMsk[i];
+}
+
+// Atomically claim the WP's bits
+static int WrkCla(TypSct *typ, WrkSct *wrk, uint64_t *wrd)
+{
+   int i, j;
+   uint64_t OldWrd;
+
+   if(!typ->SpsFlg)
+      return(ClaWrd(typ->NmbDepWrd, wrk->DepWrdTab, wrd));
+
+   for(i=0;i<wrk->NmbSps;i++)
+   {
+      OldWrd = AtmLod(&wrd[ wrk->SpsIdx[i] ]);
+
+      do
+      {
+         if(OldWrd & wrk->SpsMsk[i])
+         {
+            for(j=0;j<i;j++)
+               AtmAnd(&wrd[ wrk->SpsIdx[j] ], ~wrk->SpsMsk[j]);
+
+            return(0);
+         }
+      }while(!AtmCas(&wrd[ wrk->SpsIdx[i] ], &OldWrd, OldWrd | wrk->SpsMsk[i]));
+   }
+
+   return(1);
+}
+
+// Atomically release the WP's bits
+static void WrkRls(TypSct *typ, WrkSct *wrk, uint64_t *wrd)
+{
+   int i;
+
+   if(!typ->SpsFlg)
+   {
+      RlsWrd(typ->NmbDepWrd, wrk->DepWrdTab, wrd);
+      return;
+   }
+
+   for(i=0;i<wrk->NmbSps;i++)
+      AtmAnd(&wrd[ wrk->SpsIdx[i] ], ~wrk->SpsMsk[i]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Test and set a bit in a sparse WP: a binary search looks for its word,     */
+/* which is inserted in the sorted list if missing. Returns -1 on failure     */
+/*----------------------------------------------------------------------------*/
+
+static int SetSps(ParSct *par, WrkSct *wrk, int idx)
+{
+   int i, beg = 0, end = wrk->NmbSps - 1, mid, WrdIdx = idx >> 6, NewMax;
+   int *NewIdx;
+   uint64_t msk = 1ULL << (idx & 63), *NewMsk;
+
+   // Renumbered meshes mostly hit the last word
+   if(wrk->NmbSps && (wrk->SpsIdx[ end ] <= WrdIdx))
+      beg = (wrk->SpsIdx[ end ] == WrdIdx) ? end : wrk->NmbSps;
+   else
+      while(beg <= end)
+      {
+         mid = (beg + end) / 2;
+
+         if(wrk->SpsIdx[ mid ] < WrdIdx)
+            beg = mid + 1;
+         else if(wrk->SpsIdx[ mid ] > WrdIdx)
+            end = mid - 1;
+         else
+         {
+            beg = mid;
+            break;
+         }
+      }
+
+   if( (beg < wrk->NmbSps) && (wrk->SpsIdx[ beg ] == WrdIdx) )
+   {
+      i = ((wrk->SpsMsk[ beg ] & msk) != 0);
+      wrk->SpsMsk[ beg ] |= msk;
+      return(i);
+   }
+
+   // Double the list's size when it is full, masks and indices share a block
+   if(wrk->NmbSps == wrk->MaxSps)
+   {
+      NewMax = wrk->MaxSps ? 2 * wrk->MaxSps : 4;
+
+      if(!(NewMsk = LPL_malloc(par->lmb, NewMax * (sizeof(uint64_t) + sizeof(int)))))
+         return(-1);
+
+      NewIdx = (int *)&NewMsk[ NewMax ];
+
+      if(wrk->NmbSps)
+      {
+         memcpy(NewMsk, wrk->SpsMsk, wrk->NmbSps * sizeof(uint64_t));
+         memcpy(NewIdx, wrk->SpsIdx, wrk->NmbSps * sizeof(int));
+      }
+
+      if(wrk->SpsMsk)
+         LPL_free(par->lmb, wrk->SpsMsk);
+
+      wrk->SpsMsk = NewMsk;
+      wrk->SpsIdx = NewIdx;
+      wrk->MaxSps = NewMax;
+   }
+
+   for(i=wrk->NmbSps; i>beg; i--)
+   {
+      wrk->SpsMsk[i] = wrk->SpsMsk[ i-1 ];
+      wrk->SpsIdx[i] = wrk->SpsIdx[ i-1 ];
+   }
+
+   wrk->SpsMsk[ beg ] = msk;
+   wrk->SpsIdx[ beg ] = WrdIdx;
+   wrk->NmbSps++;
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free the WP's sparse lists                                                 */
+/*----------------------------------------------------------------------------*/
+
+static void FreSps(ParSct *par, TypSct *typ)
+{
+   int i;
+
+   if(!typ->SmlWrkTab)
+      return;
+
+   for(i=0;i<typ->MaxSmlWrk;i++)
+   {
+      if(typ->SmlWrkTab[i].SpsMsk)
+         LPL_free(par->lmb, typ->SmlWrkTab[i].SpsMsk);
+
+      typ->SmlWrkTab[i].SpsMsk = NULL;
+      typ->SmlWrkTab[i].SpsIdx = NULL;
+      typ->SmlWrkTab[i].NmbSps = typ->SmlWrkTab[i].MaxSps = 0;
+   }
+
+   typ->SpsFlg = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Compare two workpackages number of bits                                    */
+/*----------------------------------------------------------------------------*/
+
+int CmpWrk(const void *ptr1, const void *ptr2)
+{
+   WrkSct *w1, *w2;
+
+   w1 = (WrkSct *)ptr1;
+   w2 = (WrkSct *)ptr2;
+
+   if(w1->NmbDep > w2->NmbDep)
+      return(-1);
+   else if(w1->NmbDep < w2->NmbDep)
+      return(1);
+   else
+      return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Generate static scheduling groups of small WP for each thread              */
+/*----------------------------------------------------------------------------*/
+
+static int SetGrp(ParSct *par, TypSct *typ)
+{
+   int i;
+
+   // Release the groups of a previous dependency build
+   FreGrp(par, typ);
+
+   // Link all WP together to make a free list
+   for(i=0;i<typ->NmbSmlWrk;i++)
+   {
+      typ->SmlWrkTab[i].pre = &typ->SmlWrkTab[ i - 1 ];
+      typ->SmlWrkTab[i].nex = &typ->SmlWrkTab[ i + 1 ];
+   }
+
+   typ->SmlWrkTab[0].pre = NULL;
+   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].nex = NULL;
+
+   return(AddGrp(par, typ, &typ->SmlWrkTab[0], typ->NmbSmlWrk));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Add new static groups made of the NmbSmlWrk WP linked from NexWrk          */
+/*----------------------------------------------------------------------------*/
+
+static int AddGrp(ParSct *par, TypSct *typ, WrkSct *NexWrk, int NmbSmlWrk)
+{
+   int      i, IncFlg, siz = typ->NmbDepWrd;
+   uint64_t *GrpWrd, *AllWrd;
+   GrpSct   *grp;
+   WrkSct   *wrk;
+
+   if(!NmbSmlWrk)
+      return(1);
+
+   // Allocate a dependency word to contain all threads
+   if(!(GrpWrd = LPL_malloc(par->lmb, par->NmbCpu * siz * sizeof(uint64_t))))
+      return(0);
+
+   // Allocate a dependency word to concatenate all thread words
+   if(!(AllWrd = LPL_malloc(par->lmb, siz * sizeof(uint64_t))))
+   {
+      LPL_free(par->lmb, GrpWrd);
+      return(0);
+   }
+
+   // Kepp on creating new groups as long as there are free WP
+   do
+   {
+      // Allocate a new group and link it
+      if(!(grp = LPL_calloc(par->lmb, 1, sizeof(GrpSct))))
+         return(0);
+
+      grp->nex = typ->NexGrp;
+      typ->NexGrp = grp;
+      grp->idx = ++typ->NmbGrp;
+
+      // Reset all the dependencies words
+      memset(GrpWrd, 0, par->NmbCpu * siz * sizeof(uint64_t));
+      memset(AllWrd, 0, siz * sizeof(uint64_t));
+
+      // Keep on adding WP to each groups' threads until they reach WrkPerGrp
+      do
+      {
+         // Could we add some WP to this group during this iteration ?
+         IncFlg = 0;
+
+         // Loop over the threads and try adding them as many WP as possible
+         for(i=0;i<par->NmbCpu;i++)
+         {
+            // Do not add WP is this threads has reached its target number
+            if(!NexWrk || (grp->NmbSmlWrk[i] >= WrkPerGrp))
+               continue;
+
+            // Initialize the WP pointer with the first
+            // available one from the linked list
+            wrk = NexWrk;
+
+            // Then loop over the linked list of available WP and add them to
+            // the curent group-thread list as long as they do not interfere
+            // with the combined dependency word of other threads
+            do
+            {
+               // To avoid making a AND with all threads' words, we remode (XOR)
+               // the tested thread' word from the combined one and test (AND)
+               // it against this WP's word, all in a single pass
+               if(!WrkAnn(typ, wrk, AllWrd, &GrpWrd[ i * siz ]))
+               {
+                  // If this WP is compatible, add its word to the thread
+                  // dependency word and to the combined one
+                  WrkAdd(typ, wrk, AllWrd);
+                  WrkAdd(typ, wrk, &GrpWrd[ i * siz ]);
+
+                  // Add this WP to the list, decrease the number of available
+                  // WPs and set the flag to indicate that we found some work
+                  grp->SmlWrkTab[i][ grp->NmbSmlWrk[i] ] = wrk;
+                  grp->NmbSmlWrk[i]++;
+                  NmbSmlWrk--;
+                  IncFlg = 1;
+
+                  // Unlink the WP from the available WP linked list
+                  if(wrk->pre)
+                     wrk->pre->nex = wrk->nex;
+                  else
+                     NexWrk = wrk->nex;
+
+                  if(wrk->nex)
+                     wrk->nex->pre = wrk->pre;
+               }
+
+               // Stop adding WP to this group-thread if its table is full
+               if(grp->NmbSmlWrk[i] >= WrkPerGrp)
+                  break;
+
+               wrk = wrk->nex;
+            }while(wrk && NmbSmlWrk);
+         }
+      }while(IncFlg && NmbSmlWrk);
+   }while(NmbSmlWrk);
+
+   LPL_free(par->lmb, GrpWrd);
+   LPL_free(par->lmb, AllWrd);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Remove the modified WP from the static groups where they now collide with  */
+/* the other threads' WP and put them, with the appended WP, in new groups    */
+/*----------------------------------------------------------------------------*/
+
+static int UpdGrp(ParSct *par, TypSct *typ)
+{
+   int      i, j, k, NmbWrk, NmbFre = 0, siz = typ->NmbDepWrd;
+   uint64_t *GrpWrd, *AllWrd;
+   GrpSct   *grp;
+   WrkSct   *wrk, *FreWrk = NULL;
+
+   if(!typ->NexGrp)
+      return(SetGrp(par, typ));
+
+   if(!(GrpWrd = LPL_malloc(par->lmb, par->NmbCpu * siz * sizeof(uint64_t))))
+      return(0);
+
+   if(!(AllWrd = LPL_malloc(par->lmb, siz * sizeof(uint64_t))))
+   {
+      LPL_free(par->lmb, GrpWrd);
+      return(0);
+   }
+
+   for(grp = typ->NexGrp; grp; grp = grp->nex)
+   {
+      for(i=k=0;i<par->NmbCpu;i++)
+         for(j=0;j<grp->NmbSmlWrk[i];j++)
+            k += grp->SmlWrkTab[i][j]->upd;
+
+      // Untouched groups are left as they are
+      if(!k)
+         continue;
+
+      memset(GrpWrd, 0, par->NmbCpu * siz * sizeof(uint64_t));
+      memset(AllWrd, 0, siz * sizeof(uint64_t));
+
+      // Combine the words of the unmodified WP
+      for(i=0;i<par->NmbCpu;i++)
+         for(j=0;j<grp->NmbSmlWrk[i];j++)
+         {
+            wrk = grp->SmlWrkTab[i][j];
+
+            if(!wrk->upd)
+            {
+               WrkAdd(typ, wrk, AllWrd);
+               WrkAdd(typ, wrk, &GrpWrd[ i * siz ]);
+            }
+         }
+
+      // Keep the modified WP that still do not interfere with other threads
+      for(i=0;i<par->NmbCpu;i++)
+      {
+         for(j=NmbWrk=0;j<grp->NmbSmlWrk[i];j++)
+         {
+            wrk = grp->SmlWrkTab[i][j];
+
+            if(wrk->upd)
+            {
+               if(WrkAnn(typ, wrk, AllWrd, &GrpWrd[ i * siz ]))
+                  continue;
+
+               WrkAdd(typ, wrk, AllWrd);
+               WrkAdd(typ, wrk, &GrpWrd[ i * siz ]);
+               wrk->upd = 0;
+            }
+
+            grp->SmlWrkTab[i][ NmbWrk++ ] = wrk;
+         }
+
+         grp->NmbSmlWrk[i] = NmbWrk;
+      }
+   }
+
+   LPL_free(par->lmb, GrpWrd);
+   LPL_free(par->lmb, AllWrd);
+   DelGrp(par, typ);
+
+   // Link the evicted and the appended WP, which are still flagged
+   for(i=typ->NmbSmlWrk-1; i>=0; i--)
+   {
+      wrk = &typ->SmlWrkTab[i];
+
+      if(!wrk->upd)
+         continue;
+
+      wrk->pre = NULL;
+      wrk->nex = FreWrk;
+
+      if(FreWrk)
+         FreWrk->pre = wrk;
+
+      FreWrk = wrk;
+      NmbFre++;
+   }
+
+   return(AddGrp(par, typ, FreWrk, NmbFre));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Unlink and free the static groups left empty                               */
+/*----------------------------------------------------------------------------*/
+
+static void DelGrp(ParSct *par, TypSct *typ)
+{
+   int i, k;
+   GrpSct *grp, **PrvGrp;
+
+   for(PrvGrp = &typ->NexGrp; (grp = *PrvGrp); )
+   {
+      for(i=k=0;i<par->NmbCpu;i++)
+         k += grp->NmbSmlWrk[i];
+
+      if(k)
+         PrvGrp = &grp->nex;
+      else
+      {
+         *PrvGrp = grp->nex;
+         LPL_free(par->lmb, grp);
+         typ->NmbGrp--;
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Free a type's static groups                                                */
+/*----------------------------------------------------------------------------*/
+
+static void FreGrp(ParSct *par, TypSct *typ)
+{
+   GrpSct *grp, *NexGrp = typ->NexGrp;
+
+   while((grp = NexGrp))
+   {
+      NexGrp = grp->nex;
+      LPL_free(par->lmb, grp);
+   }
+
+   typ->NexGrp = NULL;
+   typ->NmbGrp = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Loop over the type's colors and run their grains with the threads,         */
+/* each color is a barrier before the next one                                */
+/*----------------------------------------------------------------------------*/
+
+int LaunchColorGrains(int64_t ParIdx, int TypIdx, void *prc, void *PtrArg)
+{
+   int      col;
+   ParSct   *par = (ParSct *)ParIdx;
+   TypSct   *typ;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(1);
+
+   WaiAsy(par);
+
+   // Check bounds
+   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
+      return(2);
+
+   typ =  &par->TypTab[ TypIdx ];
+
+   if(par->PrfFlg)
+      BegLch(par, prc, TypIdx, 0);
+
+   par->cmd = RunColWrk;
+   par->prc = (void (*)(itg, itg, int, void *))prc;
+   par->arg = PtrArg;
+   par->typ1 = typ;
+   par->typ2 = NULL;
+   par->GrnDon = 0;
+
+   // Loop over the colors
+   for(col=1;col<=typ->NmbCol;col++)
+   {
+      if(typ->ColTab[ col ][0] > typ->ColTab[ col ][1])
+         continue;
+
+      // Threads pick up the color's grains from the shared counter
+      par->CurCol = col;
+      par->GrnNxt = typ->ColTab[ col ][0];
+
+      // Wake up all threads and wait for the color's completion
+      LchPth(par);
+   }
+
+   par->typ1 = 0;
+
+   if(par->PrfFlg)
+      EndLch(par, 0.);
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Claim the current color's grains one by one and call user's procedure      */
+/*----------------------------------------------------------------------------*/
+
+static void ColWrk(PthSct *pth)
+{
+   int GrnIdx;
+   ParSct *par = pth->par;
+   TypSct *typ = par->typ1;
+   EvtSct evt;
+   void (*prc)(int, int, int, void *) = (void (*)(int, int, int, void *))par->prc;
+
+   while((GrnIdx = AtmAdd(&par->GrnNxt, 1) - 1) <= typ->ColTab[ par->CurCol ][1])
+   {
+      pth->GrnIdx = GrnIdx;
+
+      if(par->PrfFlg)
+         evt.beg = GetWallClock();
+
+      prc(typ->GrnTab[ GrnIdx ][0], typ->GrnTab[ GrnIdx ][1], GrnIdx, par->arg);
+      AtmAdd(&par->GrnDon, 1);
+
+      if(par->PrfFlg)
+      {
+         evt.end = GetWallClock();
+         evt.BegIdx = typ->GrnTab[ GrnIdx ][0];
+         evt.EndIdx = typ->GrnTab[ GrnIdx ][1];
+         evt.lch = par->CurLch;
+         evt.tid = pth->idx;
+         AddEvt(&pth->EvtTab, &pth->NmbEvt, &pth->MaxEvt, &evt);
+      }
+   }
+
+   DonPth(par);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Provide the LPlib with color and grain index for each entities             */
+/*----------------------------------------------------------------------------*/
+
+int SetColorGrains(  int64_t ParIdx, int TypIdx,
+                     int NmbCol, int *ColTab,
+                     int NmbGrn, int *GrnTab )
+{
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ;
+
+   WaiAsy(par);
+
+   // Check type validity
+   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
+      return(1);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   // Allocate and copy memory to store colors information
+   typ->NmbCol = NmbCol;
+   typ->ColTab = LPL_malloc(par->lmb, (NmbCol+1) * 2 * sizeof(int));
+
+   if(!typ->ColTab)
+      return(2);
+
+   memcpy(typ->ColTab, ColTab, (NmbCol+1) * 2 * sizeof(int));
+
+   // Allocate and copy memory to store grains information
+   typ->NmbGrn = NmbGrn;
+   typ->GrnTab = LPL_malloc(par->lmb, (NmbGrn+1) * 2 * sizeof(int));
+
+   if(!typ->GrnTab)
+      return(3);
+
+   memcpy(typ->GrnTab, GrnTab, (NmbGrn+1) * 2 * sizeof(int));
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Set an element field colors and grains from their vertices information     */
+/* Elements must be sorted against trheir color and grain beforehand          */
+/*----------------------------------------------------------------------------*/
+
+int SetElementsColorGrain( int64_t ParIdx, int VerTypIdx, int EleTypIdx,
+                           int EleSiz, int *EleTab )
+{
+   int i, VerIdx, CurGrn = 1, BegIdx = 1;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *VerTyp, *EleTyp;
+
+   WaiAsy(par);
+
+   // Make sur there are vertices and this element kind
+   if(VerTypIdx < 1 || VerTypIdx > MaxTyp || EleTypIdx < 1 || EleTypIdx > MaxTyp)
+      return(1);
+
+   VerTyp = &par->TypTab[ VerTypIdx ];
+   EleTyp = &par->TypTab[ EleTypIdx ];
+
+   // Vertices must have colors and grains set
+   if(!VerTyp->NmbCol || !VerTyp->NmbGrn)
+      return(2);
+
+   // Allocate a color table and a grain table for this element kind
+   if(!(EleTyp->ColTab = LPL_calloc(par->lmb, VerTyp->NmbCol + 1, 2 * sizeof(int))))
+      return(3);
+
+   if(!(EleTyp->GrnTab = LPL_calloc(par->lmb, VerTyp->NmbGrn + 1, 2 * sizeof(int))))
+      return(4);
+
+   // The number of colors and grains partition must match that of the vertices
+   EleTyp->NmbCol = VerTyp->NmbCol;
+   EleTyp->NmbGrn = VerTyp->NmbGrn;
+
+   // Each element's colors partitions point to the same grains as the vertex ones
+   for(i=1;i<=VerTyp->NmbCol;i++)
+   {
+      EleTyp->ColTab[i][0] = VerTyp->ColTab[i][0];
+      EleTyp->ColTab[i][1] = VerTyp->ColTab[i][1];
+   }
+
+   // Setup the first and last element index in each grain
+   for(i=1;i<=EleTyp->NmbLin;i++)
+   {
+      VerIdx = EleTab[ i * EleSiz ];
+
+      if(VerIdx > VerTyp->GrnTab[ CurGrn ][1])
+      {
+         EleTyp->GrnTab[ CurGrn ][0] = BegIdx;
+         EleTyp->GrnTab[ CurGrn ][1] = i - 1;
+         CurGrn++;
+         BegIdx = i;
+      }
+   }
+
+   // Special setup for the last grain
+   EleTyp->GrnTab[ CurGrn ][0] = BegIdx;
+   EleTyp->GrnTab[ CurGrn ][1] = EleTyp->NmbLin;
+
+   return(0);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Clear a buffer with all threads, each one first-touches its own slice      */
+/*----------------------------------------------------------------------------*/
+
+int ParallelMemClear(int64_t ParIdx, void *PtrArg, size_t siz)
+{
+   char zer = 0;
+
+   return(ParallelMemFill(ParIdx, PtrArg, siz, &zer, 1));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Fill a buffer with copies of a pattern, the last one may be truncated      */
+/*----------------------------------------------------------------------------*/
+
+int ParallelMemFill(int64_t ParIdx, void *PtrArg, size_t siz,
+                    void *pat, size_t PatSiz)
+{
+   MemSct arg;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Slices hold whole patterns so that each one starts with the first byte
+   if(!PtrArg || !pat || !PatSiz || !SetSlc(par, &arg, PtrArg, siz / PatSiz, PatSiz))
+      return(0);
+
+   arg.dst = (char *)PtrArg;
+   arg.pat = (char *)pat;
+   arg.siz = siz;
+   RunMem(par, &arg, (void *)FilPrc);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy a buffer to another one, they must not overlap                        */
+/*----------------------------------------------------------------------------*/
+
+int ParallelMemCopy(int64_t ParIdx, void *dst, void *src, size_t siz)
+{
+   MemSct arg;
+   ParSct *par = (ParSct *)ParIdx;
+
+   if(!dst || !src || !SetSlc(par, &arg, dst, siz, 1))
+      return(0);
+
+   arg.dst = (char *)dst;
+   arg.src = (char *)src;
+   RunMem(par, &arg, (void *)MovPrc);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Gather items of ItmSiz bytes: dst[i] = src[ IdxTab[i] ], for i = 1..NmbItm */
+/* The tables are indexed from 1 like the types' lines and renumberings       */
+/*----------------------------------------------------------------------------*/
+
+int ParallelGather(  int64_t ParIdx, void *dst, void *src,
+                     size_t ItmSiz, itg NmbItm, itg *IdxTab )
+{
+   MemSct arg;
+   ParSct *par = (ParSct *)ParIdx;
+
+   if( !dst || !src || !IdxTab || (NmbItm < 0)
+   ||  !SetSlc(par, &arg, (char *)dst + ItmSiz, NmbItm, ItmSiz) )
+   {
+      return(0);
+   }
+
+   arg.dst = (char *)dst;
+   arg.src = (char *)src;
+   arg.IdxTab = IdxTab;
+   RunMem(par, &arg, (void *)GatPrc);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Scatter items of ItmSiz bytes: dst[ IdxTab[i] ] = src[i], for i = 1..NmbItm*/
+/* IdxTab must not hold the same index twice                                  */
+/*----------------------------------------------------------------------------*/
+
+int ParallelScatter( int64_t ParIdx, void *dst, void *src,
+                     size_t ItmSiz, itg NmbItm, itg *IdxTab )
+{
+   MemSct arg;
+   ParSct *par = (ParSct *)ParIdx;
+
+   if( !dst || !src || !IdxTab || (NmbItm < 0)
+   ||  !SetSlc(par, &arg, (char *)src + ItmSiz, NmbItm, ItmSiz) )
+   {
+      return(0);
+   }
+
+   arg.dst = (char *)dst;
+   arg.src = (char *)src;
+   arg.IdxTab = IdxTab;
+   RunMem(par, &arg, (void *)SctPrc);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Inclusive prefix sum: each entry from 1 to NmbItm receives the sum of      */
+/* itself and all the previous ones, starting with tab[0]                     */
+/*----------------------------------------------------------------------------*/
+
+int ParallelPrefixSum(int64_t ParIdx, itg NmbItm, itg *tab)
+{
+   int i;
+   itg sum;
+   MemSct arg;
+   ParSct *par = (ParSct *)ParIdx;
+
+   if(!tab || (NmbItm < 0) || !SetSlc(par, &arg, &tab[1], NmbItm, sizeof(itg)))
+      return(0);
+
+   // Small tables are not worth waking up the threads twice
+   if(arg.siz < (size_t)arg.NmbPth * MinMemSiz)
+   {
+      for(i=1;i<=NmbItm;i++)
+         tab[i] += tab[ i-1 ];
+
+      return(1);
+   }
+
+   // Sum each slice, then add the sum of the previous ones to its entries
+   arg.SumTab = tab;
+   RunPth(par, (void *)SumPrc, (void *)&arg);
+
+   for(i=0, sum = tab[0]; i<par->NmbCpu; i++)
+   {
+      sum += arg.SumPth[i];
+      arg.SumPth[i] = sum - arg.SumPth[i];
+   }
+
+   RunPth(par, (void *)OffPrc, (void *)&arg);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Clear a type's table: each thread first-touches the lines of its big WP    */
+/*----------------------------------------------------------------------------*/
+
+int ParallelTypeMemClear(int64_t ParIdx, int TypIdx, void *PtrArg, size_t LinSiz)
+{
+   ClrSct arg;
+   ParSct *par = (ParSct *)ParIdx;
+   TypSct *typ;
+
+   // Get and check lib parallel instance, type and adresse
+   if(!ParIdx || !PtrArg || !LinSiz || (TypIdx < 1) || (TypIdx > MaxTyp))
+      return(0);
+
+   WaiAsy(par);
+
+   typ = &par->TypTab[ TypIdx ];
+
+   if(!typ->NmbLin || par->typ1)
+      return(0);
+
+   // The table is indexed from 1 to NmbLin: line 0 is cleared locally
+   arg.adr = (char *)PtrArg;
+   arg.siz = LinSiz;
+   memset(arg.adr, 0, LinSiz);
+
+   // Run the clearing through the same big WP as LaunchParallel
+   RunBig(par, typ, (void *)ClrPrc, (void *)&arg);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run an internal procedure on a type's big WP                               */
+/*----------------------------------------------------------------------------*/
+
+static void RunBig(ParSct *par, TypSct *typ, void *prc, void *arg)
+{
+   int i;
+
+   par->cmd = RunBigWrk;
+   par->prc = (void (*)(itg, itg, int, void *))prc;
+   par->arg = arg;
+   par->typ1 = typ;
+   par->typ2 = NULL;
+   par->NmbVarArg = 0;
+
+   for(i=0;i<par->NmbCpu;i++)
+      par->PthTab[i].big = &typ->BigWrkTab[i];
+
+   if( (par->NmbItlBlk != 1) || par->ItlBlkSiz)
+      SetItlBlk(par, typ);
+
+   LchPth(par);
+   par->typ1 = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run an internal procedure once on each thread                              */
+/*----------------------------------------------------------------------------*/
+
+static void RunPth(ParSct *par, void *prc, void *arg)
+{
+   par->cmd = RunPthWrk;
+   par->prc = (void (*)(itg, itg, int, void *))prc;
+   par->arg = arg;
+   par->NmbVarArg = 0;
+
+   LchPth(par);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Clear a range of lines                                                     */
+/*----------------------------------------------------------------------------*/
+
+static void ClrPrc(itg BegIdx, itg EndIdx, int PthIdx, ClrSct *arg)
+{
+   (void)(PthIdx);
+
+   memset(&arg->adr[ (size_t)BegIdx * arg->siz ], 0,
+          (size_t)(EndIdx - BegIdx + 1) * arg->siz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Split the NmbItm items starting at adr among the threads: the pages        */
+/* holding them, counted from the one containing adr, are evenly shared and   */
+/* each slice starts with the first item of its pages, so that they are first */
+/* touched by a single thread and land on its NUMA node                       */
+/*----------------------------------------------------------------------------*/
+
+static int SetSlc(ParSct *par, MemSct *arg, void *adr, size_t NmbItm, size_t ItmSiz)
+{
+   int i;
+   size_t NmbPag, BegItm;
+   uintptr_t BegAdr = (uintptr_t)adr, org, bnd;
+
+   if(!par || !ItmSiz)
+      return(0);
+
+   // Threads cannot be driven from a running loop
+   WaiAsy(par);
+
+   if(par->typ1)
+      return(0);
+
+   memset(arg, 0, sizeof(MemSct));
+   arg->NmbItm = NmbItm;
+   arg->ItmSiz = ItmSiz;
+   arg->siz = NmbItm * ItmSiz;
+   arg->NmbPth = par->NmbCpu;
+
+   // Large buffers would only evict the caches' content
+   arg->stm = (arg->siz >= MinStmSiz);
+
+   org = BegAdr & ~(uintptr_t)(PagSiz - 1);
+   NmbPag = (BegAdr + arg->siz - org + PagSiz - 1) / PagSiz;
+   arg->SlcBeg[ arg->NmbPth ] = NmbItm;
+
+   for(i=1;i<arg->NmbPth;i++)
+   {
+      bnd = org + (NmbPag * i / arg->NmbPth) * PagSiz;
+      BegItm = (bnd <= BegAdr) ? 0 : (bnd - BegAdr + ItmSiz - 1) / ItmSiz;
+
+      if(BegItm > NmbItm)
+         BegItm = NmbItm;
+
+      arg->SlcBeg[i] = (BegItm < arg->SlcBeg[ i-1 ]) ? arg->SlcBeg[ i-1 ] : BegItm;
+   }
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Give a thread's slice of items [beg, end[                                  */
+/*----------------------------------------------------------------------------*/
+
+static void GetSlc(MemSct *arg, int PthIdx, size_t *beg, size_t *end)
+{
+   *beg = arg->SlcBeg[ PthIdx ];
+   *end = arg->SlcBeg[ PthIdx + 1 ];
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Run a memory procedure with all threads, or locally when their slices      */
+/* would hold less than MinMemSiz bytes each                                  */
+/*----------------------------------------------------------------------------*/
+
+static void RunMem(ParSct *par, MemSct *arg, void *prc)
+{
+   if(arg->siz >= (size_t)arg->NmbPth * MinMemSiz)
+   {
+      RunPth(par, prc, (void *)arg);
+      return;
+   }
+
+   // The last thread's slice then holds all the items
+   memset(arg->SlcBeg, 0, arg->NmbPth * sizeof(size_t));
+   ((void (*)(itg, itg, int, MemSct *))prc)(0, 0, arg->NmbPth - 1, arg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy with streaming stores that bypass the caches                          */
+/*----------------------------------------------------------------------------*/
+
+static void StmCpy(char *dst, char *src, size_t siz)
+{
+#if defined(__SSE2__)
+   size_t i, pre = (16 - ((uintptr_t)dst & 15)) & 15;
+
+   if(siz < pre + 16)
+   {
+      memcpy(dst, src, siz);
+      return;
+   }
+
+   memcpy(dst, src, pre);
+   dst += pre;
+   src += pre;
+   siz -= pre;
+
+   for(i=0; i+16<=siz; i+=16)
+      _mm_stream_si128((__m128i *)&dst[i], _mm_loadu_si128((__m128i *)&src[i]));
+
+   memcpy(&dst[i], &src[i], siz - i);
+   _mm_sfence();
+#else
+   memcpy(dst, src, siz);
+#endif
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Fill a slice: the pattern is replicated over a first block,                */
+/* which is then copied along the slice                                       */
+/*----------------------------------------------------------------------------*/
+
+static void FilPrc(itg BegIdx, itg EndIdx, int PthIdx, MemSct *arg)
+{
+   size_t i, beg, end, len, BlkSiz, PatSiz = arg->ItmSiz;
+   char *dst;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   // Slices are made of patterns, the truncated one goes to the last thread
+   GetSlc(arg, PthIdx, &beg, &end);
+   beg *= PatSiz;
+   end = (PthIdx == arg->NmbPth - 1) ? arg->siz : end * PatSiz;
+   dst = &arg->dst[ beg ];
+   len = end - beg;
+
+   if( (PatSiz == 1) && !arg->stm )
+   {
+      memset(dst, arg->pat[0], len);
+      return;
+   }
+
+   BlkSiz = (FilBlkSiz > PatSiz) ? FilBlkSiz - FilBlkSiz % PatSiz : PatSiz;
+
+   if(BlkSiz > len)
+      BlkSiz = len;
+
+   for(i=0;i<BlkSiz;i+=PatSiz)
+      memcpy(&dst[i], arg->pat, (BlkSiz - i < PatSiz) ? BlkSiz - i : PatSiz);
+
+   for(i=BlkSiz;i<len;i+=BlkSiz)
+      if(arg->stm)
+         StmCpy(&dst[i], dst, (len - i < BlkSiz) ? len - i : BlkSiz);
+      else
+         memcpy(&dst[i], dst, (len - i < BlkSiz) ? len - i : BlkSiz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy a slice of bytes                                                      */
+/*----------------------------------------------------------------------------*/
+
+static void MovPrc(itg BegIdx, itg EndIdx, int PthIdx, MemSct *arg)
+{
+   size_t beg, end;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   GetSlc(arg, PthIdx, &beg, &end);
+
+   if(arg->stm)
+      StmCpy(&arg->dst[ beg ], &arg->src[ beg ], end - beg);
+   else
+      memcpy(&arg->dst[ beg ], &arg->src[ beg ], end - beg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Gather a slice of items, each thread writes its own part of dst            */
+/*----------------------------------------------------------------------------*/
+
+static void GatPrc(itg BegIdx, itg EndIdx, int PthIdx, MemSct *arg)
+{
+   size_t i, beg, end, siz = arg->ItmSiz;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   GetSlc(arg, PthIdx, &beg, &end);
+
+   for(i=beg+1; i<=end; i++)
+      memcpy(&arg->dst[ i * siz ], &arg->src[ (size_t)arg->IdxTab[i] * siz ], siz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Scatter a slice of items, each thread reads its own part of src            */
+/*----------------------------------------------------------------------------*/
+
+static void SctPrc(itg BegIdx, itg EndIdx, int PthIdx, MemSct *arg)
+{
+   size_t i, beg, end, siz = arg->ItmSiz;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   GetSlc(arg, PthIdx, &beg, &end);
+
+   for(i=beg+1; i<=end; i++)
+      memcpy(&arg->dst[ (size_t)arg->IdxTab[i] * siz ], &arg->src[ i * siz ], siz);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sum a slice of a prefix sum's entries                                      */
+/*----------------------------------------------------------------------------*/
+
+static void SumPrc(itg BegIdx, itg EndIdx, int PthIdx, MemSct *arg)
+{
+   size_t i, beg, end;
+   itg sum = 0;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   GetSlc(arg, PthIdx, &beg, &end);
+
+   for(i=beg+1; i<=end; i++)
+      sum += arg->SumTab[i];
+
+   arg->SumPth[ PthIdx ] = sum;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Scan a slice of a prefix sum from the sum of the previous slices           */
+/*----------------------------------------------------------------------------*/
+
+static void OffPrc(itg BegIdx, itg EndIdx, int PthIdx, MemSct *arg)
+{
+   size_t i, beg, end;
+   itg sum = arg->SumPth[ PthIdx ];
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   GetSlc(arg, PthIdx, &beg, &end);
+
+   for(i=beg+1; i<=end; i++)
+   {
+      sum += arg->SumTab[i];
+      arg->SumTab[i] = sum;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Bind the threads to the cores in compact or scatter order                  */
+/* Compact fills a socket with all its cores before using the next one,       */
+/* scatter distributes consecutive threads in a round-robin among sockets     */
+/*----------------------------------------------------------------------------*/
+
+static int SetPin(ParSct *par, int mod)
+{
+#ifdef __linux__
+   int i, j, k, cpu, NmbAvl = 0, MaxPkg = -1, *PkgTab, *CorTab, *CpuTab;
+   int *OrdTab, *UsdTab, *SctTab;
+   char FilNam[ 128 ];
+   FILE *hdl;
+   cpu_set_t AvlSet, PinSet;
+
+   if(sched_getaffinity(0, sizeof(cpu_set_t), &AvlSet))
+      return(0);
+
+   // Unpinning restores the process' mask to every thread
+   if(mod == NoPinning)
+   {
+      for(i=0;i<par->NmbCpu;i++)
+         pthread_setaffinity_np(par->PthTab[i].pth, sizeof(cpu_set_t), &AvlSet);
+
+      return(1);
+   }
+
+   NmbAvl = CPU_COUNT(&AvlSet);
+
+   if( (NmbAvl < 1)
+   ||  !(PkgTab = LPL_malloc(par->lmb, 6 * NmbAvl * sizeof(int))) )
+      return(0);
+
+   CorTab = &PkgTab[ NmbAvl ];
+   CpuTab = &PkgTab[ 2 * NmbAvl ];
+   OrdTab = &PkgTab[ 3 * NmbAvl ];
+   UsdTab = &PkgTab[ 4 * NmbAvl ];
+   SctTab = &PkgTab[ 5 * NmbAvl ];
+
+   // Read the socket and core of each available logical cpu
+   for(cpu=0, i=0; (cpu < CPU_SETSIZE) && (i < NmbAvl); cpu++)
+   {
+      if(!CPU_ISSET(cpu, &AvlSet))
+         continue;
+
+      CpuTab[i] = cpu;
+      PkgTab[i] = CorTab[i] = 0;
+
+      sprintf(FilNam, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+
+      if((hdl = fopen(FilNam, "r")))
+      {
+         if(fscanf(hdl, "%d", &PkgTab[i]) != 1 || PkgTab[i] < 0)
+            PkgTab[i] = 0;
+
+         fclose(hdl);
+      }
+
+      sprintf(FilNam, "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+
+      if((hdl = fopen(FilNam, "r")))
+      {
+         if(fscanf(hdl, "%d", &CorTab[i]) != 1)
+            CorTab[i] = 0;
+
+         fclose(hdl);
+      }
+
+      if(PkgTab[i] > MaxPkg)
+         MaxPkg = PkgTab[i];
+
+      i++;
+   }
+
+   NmbAvl = i;
+
+   // Compact order: sort the cpus by socket, core and logical index
+   for(i=0;i<NmbAvl;i++)
+      OrdTab[i] = i;
+
+   for(i=1;i<NmbAvl;i++)
+   {
+      k = OrdTab[i];
+
+      for(j=i-1;j>=0;j--)
+      {
+         if( (PkgTab[ OrdTab[j] ] < PkgTab[k])
+         ||  ((PkgTab[ OrdTab[j] ] == PkgTab[k]) && (CorTab[ OrdTab[j] ] <= CorTab[k])) )
+            break;
+
+         OrdTab[ j+1 ] = OrdTab[j];
+      }
+
+      OrdTab[ j+1 ] = k;
+   }
+
+   // Scatter order: take the next unused cpu of each socket in turn
+   if(mod == ScatterPinning)
+   {
+      for(i=0;i<NmbAvl;i++)
+         UsdTab[i] = 0;
+
+      for(j=0, k=0; j<NmbAvl; k = (k + 1) % (MaxPkg + 1))
+         for(i=0;i<NmbAvl;i++)
+            if(!UsdTab[i] && (PkgTab[ OrdTab[i] ] == k))
+            {
+               UsdTab[i] = 1;
+               SctTab[ j++ ] = OrdTab[i];
+               break;
+            }
+
+      for(i=0;i<NmbAvl;i++)
+         OrdTab[i] = SctTab[i];
+   }
+
+   // Bind each thread to a single cpu, wrapping around when oversubscribed
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      CPU_ZERO(&PinSet);
+      CPU_SET(CpuTab[ OrdTab[ i % NmbAvl ] ], &PinSet);
+      pthread_setaffinity_np(par->PthTab[i].pth, sizeof(cpu_set_t), &PinSet);
+   }
+
+   LPL_free(par->lmb, PkgTab);
+
+   return(1);
+#else
+   return(mod == NoPinning);
+#endif
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Queue a user procedure that will be run by the pipeline threads as soon    */
+/* as all the pipes it depends on have completed                              */
+/*----------------------------------------------------------------------------*/
+
+int LaunchPipeline(  int64_t ParIdx, void *prc,
+                     void *PtrArg, int NmbDep, int *DepTab )
+{
+   int i, j, idx;
+   PipSct *NewPip=NULL;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance and the number of pipes and dependencies
+   if( !ParIdx || (NmbDep < 0) || (NmbDep > MaxPipDep)
+   ||  (par->NmbPip >= MaxTotPip - 1) )
+   {
+      return(0);
+   }
+
+   for(i=0;i<NmbDep;i++)
+      if( (DepTab[i] < 1) || (DepTab[i] >= MaxTotPip) )
+         return(0);
+
+   // Allocate and setup a new pipe
+   if(!(NewPip = LPL_calloc(par->lmb, 1, sizeof(PipSct))))
+      return(0);
+
+   NewPip->prc = prc;
+   NewPip->arg = PtrArg;
+   NewPip->par = par;
+   NewPip->NmbDep = NmbDep;
+
+   for(i=0;i<NmbDep;i++)
+      NewPip->DepTab[i] = DepTab[i];
+
+   // In case variable arguments where passed through the common LPlib structure
+   // Copy them in the pipeline's own arguments table
+   if(par->NmbVarArg)
+   {
+      NewPip->NmbVarArg = par->NmbVarArg;
+
+      for(i=0;i<par->NmbVarArg;i++)
+         NewPip->VarArgTab[i] = par->VarArgTab[i];
+   }
+
+   // Lock pipe mutex and start the pipeline threads on first use
+   pthread_mutex_lock(&par->PipMtx);
+
+   if(!par->PipPth && !IniPip(par))
+   {
+      pthread_mutex_unlock(&par->PipMtx);
+      LPL_free(par->lmb, NewPip);
+      return(0);
+   }
+
+   NewPip->idx = ++par->NmbPip;
+   par->PenPip++;
+
+   // Link the pipe to each uncompleted pipe it depends on, once per pipe
+   for(i=0;i<NmbDep;i++)
+   {
+      if(GetBit(par->PipWrd, DepTab[i]))
+         continue;
+
+      for(j=0;j<i;j++)
+         if(DepTab[j] == DepTab[i])
+            break;
+
+      if(j < i)
+         continue;
+
+      NewPip->SucLnk[i] = par->SucHed[ DepTab[i] ];
+      par->SucHed[ DepTab[i] ] = NewPip;
+      NewPip->NmbWai++;
+   }
+
+   // Queue the pipe right away if its dependencies are already met,
+   // it may then be run and freed as soon as the mutex is released
+   idx = NewPip->idx;
+
+   if(!NewPip->NmbWai)
+      RdyPip(par, NewPip);
+
+   pthread_mutex_unlock(&par->PipMtx);
+
+   return(idx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch the pipeline threads and allocate the dependency lists' heads       */
+/* Must be called with PipMtx locked                                          */
+/*----------------------------------------------------------------------------*/
+
+static int IniPip(ParSct *par)
+{
+   int i;
+   pthread_attr_t atr;
+
+   if( !(par->SucHed = LPL_calloc(par->lmb, MaxTotPip, sizeof(PipSct *)))
+   ||  !(par->PipStk = LPL_calloc(par->lmb, par->NmbCpu, sizeof(void *)))
+   ||  !(par->PipPth = LPL_calloc(par->lmb, par->NmbCpu, sizeof(pthread_t))) )
+   {
+      if(par->SucHed)
+         LPL_free(par->lmb, par->SucHed);
+
+      if(par->PipStk)
+         LPL_free(par->lmb, par->PipStk);
+
+      par->SucHed = NULL;
+      par->PipStk = NULL;
+      return(0);
+   }
+
+   par->RdyHed = par->RdyTal = NULL;
+   par->PipEnd = 0;
+
+   // As many threads as cores may run pipes concurrently
+   for(i=0;i<par->NmbCpu;i++)
+   {
+      if(par->StkSiz)
+      {
+         pthread_attr_init(&atr);
+         par->PipStk[i] = LPL_malloc(par->lmb, par->StkSiz);
+#ifdef _WIN32
+         pthread_attr_setstackaddr(&atr, par->PipStk[i]);
+         pthread_attr_setstacksize(&atr, par->StkSiz);
+#else
+         pthread_attr_setstack(&atr, par->PipStk[i], par->StkSiz);
+#endif
+         pthread_create(&par->PipPth[i], &atr, PipHdl, (void *)par);
+         pthread_attr_destroy(&atr);
+      }
+      else
+         pthread_create(&par->PipPth[i], NULL, PipHdl, (void *)par);
+   }
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Append a pipe to the ready queue and wake up a pipeline thread             */
+/* Must be called with PipMtx locked                                          */
+/*----------------------------------------------------------------------------*/
+
+static void RdyPip(ParSct *par, PipSct *pip)
+{
+   pip->nex = NULL;
+
+   if(par->RdyTal)
+      par->RdyTal->nex = pip;
+   else
+      par->RdyHed = pip;
+
+   par->RdyTal = pip;
+   pthread_cond_signal(&par->PipCnd);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Launch a pipeline procedure with variable numbers of arguments             */
+/*----------------------------------------------------------------------------*/
+
+int LaunchPipelineMultiArg(int64_t ParIdx, int NmbDep, int *DepTab, 
+                           void *prc, int NmbArg, ... )
+{
+   int i, ret;
+   va_list ArgLst;
+   ParSct *par = (ParSct *)ParIdx;
+
+   if(NmbArg > MaxVarArg)
+      return(-1);
+
+   // Get the variable arguments and store then in the common LPlib structure
+   // This is a temporary storage as the will be copied to the pipeline's own
+   // arguments table after it has been allocated by LaunchPipeline()
+   par->NmbVarArg = NmbArg;
+   va_start(ArgLst, NmbArg);
+
+   for(i=0;i<NmbArg;i++)
+      par->VarArgTab[i] = va_arg(ArgLst, void *);
+
+   va_end(ArgLst);
+
+   ret = LaunchPipeline(ParIdx, prc, NULL, NmbDep, DepTab);
+
+   // Clear the temporary arguments table
+   par->NmbVarArg = 0;
+
+   return(ret);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Pipeline thread handler: runs the ready pipes and releases their           */
+/* dependent pipes on completion                                              */
+/*----------------------------------------------------------------------------*/
+
+static void *PipHdl(void *ptr)
+{
+   int i, idx, wid;
+   PipSct *pip, *SucPip, *NexPip;
+   ParSct *par = (ParSct *)ptr;
+   EvtSct evt;
+   void (*prc)(void *);
+
+   pthread_mutex_lock(&par->PipMtx);
+
+   // Give each pipeline thread an index for the profiling records
+   wid = par->PipWid++;
+
+   for(;;)
+   {
+      // Wait for a ready pipe or the end signal
+      while(!par->RdyHed && !par->PipEnd)
+         pthread_cond_wait(&par->PipCnd, &par->PipMtx);
+
+      if(!par->RdyHed)
+         break;
+
+      pip = par->RdyHed;
+      par->RdyHed = pip->nex;
+
+      if(!par->RdyHed)
+         par->RdyTal = NULL;
+
+      par->RunPip++;
+      pthread_mutex_unlock(&par->PipMtx);
+
+      // Execute the user's procedure
+      prc = (void (*)(void *))pip->prc;
+      evt.beg = GetWallClock();
+
+      if(pip->NmbVarArg)
+         CalVarArgPip(pip, pip->prc);
+      else
+         prc(pip->arg);
+
+      pthread_mutex_lock(&par->PipMtx);
+
+      // Flag the pipe as done and release the pipes waiting for it
+      idx = pip->idx;
+      SetBit(par->PipWrd, idx);
+
+      if(par->PrfFlg)
+      {
+         evt.end = GetWallClock();
+         evt.BegIdx = evt.EndIdx = 0;
+         evt.lch = idx;
+         evt.tid = wid;
+         AddEvt(&par->PevTab, &par->NmbPev, &par->MaxPev, &evt);
+      }
+
+      for(SucPip = par->SucHed[ idx ]; SucPip; SucPip = NexPip)
+      {
+         for(i=0;i<SucPip->NmbDep;i++)
+            if(SucPip->DepTab[i] == idx)
+               break;
+
+         NexPip = SucPip->SucLnk[i];
+
+         if(!--SucPip->NmbWai)
+            RdyPip(par, SucPip);
+      }
+
+      par->SucHed[ idx ] = NULL;
+      par->PenPip--;
+      par->RunPip--;
+      LPL_free(par->lmb, pip);
+
+      if(!par->PenPip)
+         pthread_cond_broadcast(&par->WaiCnd);
+   }
+
+   pthread_mutex_unlock(&par->PipMtx);
+
+   return(NULL);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Wait for all pipelined procedures to complete                              */
+/*----------------------------------------------------------------------------*/
+
+void WaitPipeline(int64_t ParIdx)
+{
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return;
+
+   pthread_mutex_lock(&par->PipMtx);
+
+   while(par->PenPip)
+      pthread_cond_wait(&par->WaiCnd, &par->PipMtx);
+
+   pthread_mutex_unlock(&par->PipMtx);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Wait for all pipelined procedures to complete                              */
+/*----------------------------------------------------------------------------*/
+
+void GetLplibInformation(int64_t ParIdx, int *NmbCpu, int *NmbTyp)
+{
+   int i;
+   ParSct *par = (ParSct *)ParIdx;
+
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return;
+
+   *NmbCpu = par->NmbCpu;
+   *NmbTyp = 0;
+
+   // Count the number of used types
+   for(i=1;i<=MaxTyp;i++)
+      if(par->TypTab[i].NmbLin)
+         (*NmbTyp)++;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Each thread sorts a slice with qsort, then pairs of sorted runs are merged */
+/* in parallel until a single one is left                                     */
+/*----------------------------------------------------------------------------*/
+
+void ParallelQsort(  int64_t ParIdx, void *base, size_t nel, size_t width,
+                     int (*compar)(const void *, const void *) )
+{
+   int i;
+   char *tmp, *swp;
+   ParSct *par = (ParSct *)ParIdx;
+   SrtSct arg;
+
+   // Small tables are not worth a parallel launch
+   if( !ParIdx || (par->NmbCpu == 1) || (nel < MinSrtSiz)
+   ||  !(tmp = LPL_malloc(par->lmb, (int64_t)nel * width)) )
+   {
+      qsort(base, nel, width, compar);
+      return;
+   }
+
+   WaiAsy(par);
+
+   arg.src = (char *)base;
+   arg.dst = tmp;
+   arg.nel = nel;
+   arg.width = width;
+   arg.compar = compar;
+
+   for(i=0;i<=par->NmbCpu;i++)
+      arg.bnd[i] = nel * i / par->NmbCpu;
+
+   RunPth(par, (void *)SrtPrc, (void *)&arg);
+
+   // Each round merges pairs of runs made of stp slices
+   arg.NmbRun = par->NmbCpu;
+
+   for(arg.stp=1; arg.stp < par->NmbCpu; arg.stp *= 2)
+   {
+      RunPth(par, (void *)MrgPrc, (void *)&arg);
+      swp = arg.src;
+      arg.src = arg.dst;
+      arg.dst = swp;
+   }
+
+   // The result may lie in the temporary buffer
+   if(arg.src != (char *)base)
+   {
+      arg.dst = (char *)base;
+      RunPth(par, (void *)CpyPrc, (void *)&arg);
+   }
+
+   LPL_free(par->lmb, tmp);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort the thread's slice                                                    */
+/*----------------------------------------------------------------------------*/
+
+static void SrtPrc(itg BegIdx, itg EndIdx, int PthIdx, SrtSct *arg)
+{
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   qsort(  &arg->src[ arg->bnd[ PthIdx ] * arg->width ],
+           arg->bnd[ PthIdx + 1 ] - arg->bnd[ PthIdx ], arg->width, arg->compar );
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Merge the thread's pair of runs, a lonely run is simply copied             */
+/*----------------------------------------------------------------------------*/
+
+static void MrgPrc(itg BegIdx, itg EndIdx, int PthIdx, SrtSct *arg)
+{
+   int lft = 2 * PthIdx * arg->stp;
+   size_t w = arg->width, i, j, k, mid, end;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   if(lft >= arg->NmbRun)
+      return;
+
+   i = k = arg->bnd[ lft ];
+   mid = j = arg->bnd[ (lft + arg->stp < arg->NmbRun) ? lft + arg->stp : arg->NmbRun ];
+   end = arg->bnd[ (lft + 2 * arg->stp < arg->NmbRun) ? lft + 2 * arg->stp : arg->NmbRun ];
+
+   // Take from the left run on equality to keep the merge stable
+   while( (i < mid) && (j < end) )
+      if(arg->compar(&arg->src[ j * w ], &arg->src[ i * w ]) < 0)
+         memcpy(&arg->dst[ k++ * w ], &arg->src[ j++ * w ], w);
+      else
+         memcpy(&arg->dst[ k++ * w ], &arg->src[ i++ * w ], w);
+
+   if(i < mid)
+      memcpy(&arg->dst[ k * w ], &arg->src[ i * w ], (mid - i) * w);
+   else if(j < end)
+      memcpy(&arg->dst[ k * w ], &arg->src[ j * w ], (end - j) * w);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy the thread's slice from src to dst                                    */
+/*----------------------------------------------------------------------------*/
+
+static void CpyPrc(itg BegIdx, itg EndIdx, int PthIdx, SrtSct *arg)
+{
+   size_t beg = arg->bnd[ PthIdx ] * arg->width;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   memcpy(&arg->dst[ beg ], &arg->src[ beg ],
+          arg->bnd[ PthIdx + 1 ] * arg->width - beg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort a table of (64-bit key, 64-bit value) pairs against their keys        */
+/* A stable LSD radix sort processes one byte per pass: each thread counts    */
+/* its slice's digits, then scatters them to their global position            */
+/*----------------------------------------------------------------------------*/
+
+int ParallelRadixSort(int64_t ParIdx, uint64_t (*tab)[2], size_t nel)
+{
+   int i, j;
+   size_t pos, (*CntTab)[256];
+   char *tmp, *swp;
+   ParSct *par = (ParSct *)ParIdx;
+   SrtSct arg;
+
+   // Get and check lib parallel instance
+   if(!ParIdx || !tab)
+      return(0);
+
+   WaiAsy(par);
+
+   if(nel < 2)
+      return(1);
+
+   if(!(tmp = LPL_malloc(par->lmb, (int64_t)nel * 2 * sizeof(uint64_t))))
+      return(0);
+
+   if(!(CntTab = LPL_malloc(par->lmb, par->NmbCpu * 256 * sizeof(size_t))))
+   {
+      LPL_free(par->lmb, tmp);
+      return(0);
+   }
+
+   arg.src = (char *)tab;
+   arg.dst = tmp;
+   arg.nel = nel;
+   arg.width = 2 * sizeof(uint64_t);
+   arg.CntTab = CntTab;
+
+   for(i=0;i<=par->NmbCpu;i++)
+      arg.bnd[i] = nel * i / par->NmbCpu;
+
+   for(arg.sft=0; arg.sft<64; arg.sft+=8)
+   {
+      RunPth(par, (void *)HisPrc, (void *)&arg);
+
+      // Skip the pass if all keys share the same digit
+      for(j=0;j<256;j++)
+      {
+         for(i=0, pos=0; i<par->NmbCpu; i++)
+            pos += CntTab[i][j];
+
+         if(pos)
+            break;
+      }
+
+      if(pos == nel)
+         continue;
+
+      // Turn the counts into each thread's starting position per digit
+      for(j=0, pos=0; j<256; j++)
+         for(i=0;i<par->NmbCpu;i++)
+         {
+            pos += CntTab[i][j];
+            CntTab[i][j] = pos - CntTab[i][j];
+         }
+
+      RunPth(par, (void *)RdxPrc, (void *)&arg);
+      swp = arg.src;
+      arg.src = arg.dst;
+      arg.dst = swp;
+   }
+
+   // After an odd number of passes the result lies in the temporary buffer
+   if(arg.src != (char *)tab)
+   {
+      arg.dst = (char *)tab;
+      RunPth(par, (void *)CpyPrc, (void *)&arg);
+   }
+
+   LPL_free(par->lmb, CntTab);
+   LPL_free(par->lmb, tmp);
+
+   return(1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Count the current digit's values in the thread's slice                     */
+/*----------------------------------------------------------------------------*/
+
+static void HisPrc(itg BegIdx, itg EndIdx, int PthIdx, SrtSct *arg)
+{
+   size_t i, *cnt = arg->CntTab[ PthIdx ];
+   uint64_t (*src)[2] = (uint64_t (*)[2])arg->src;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   memset(cnt, 0, 256 * sizeof(size_t));
+
+   for(i=arg->bnd[ PthIdx ]; i<arg->bnd[ PthIdx + 1 ]; i++)
+      cnt[ (src[i][0] >> arg->sft) & 255 ]++;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Scatter the thread's slice according to the current digit                  */
+/*----------------------------------------------------------------------------*/
+
+static void RdxPrc(itg BegIdx, itg EndIdx, int PthIdx, SrtSct *arg)
+{
+   size_t i, *pos = arg->CntTab[ PthIdx ];
+   uint64_t (*src)[2] = (uint64_t (*)[2])arg->src;
+   uint64_t (*dst)[2] = (uint64_t (*)[2])arg->dst, *ptr;
+   (void)(BegIdx);
+   (void)(EndIdx);
+
+   for(i=arg->bnd[ PthIdx ]; i<arg->bnd[ PthIdx + 1 ]; i++)
+   {
+      ptr = dst[ pos[ (src[i][0] >> arg->sft) & 255 ]++ ];
+      ptr[0] = src[i][0];
+      ptr[1] = src[i][1];
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* SFC state machines: each state is one of the curve's rotations and a table */
+/* entry gives the codes and the next state of several levels at once,        */
+/* they are built once for all LPlib instances and SfcOk tells whether the   */
+/* curves' rotations fitted in the tables                                     */
+/*----------------------------------------------------------------------------*/
+
+static uint16_t Sfc3dTab[ MaxSfcSta ][512];
+static uint16_t Sfc2dTab[ MaxSfcSta ][256], Sfc2dOne[ MaxSfcSta ][4];
+static pthread_once_t SfcOnc = PTHREAD_ONCE_INIT;
+static int SfcOk;
+
+static void IniSfc()
+{
+   int GeoCod3d[8] = {0,3,7,4,1,2,6,5};
+   int HilCod3d[8][8] = {
+      {0,7,6,1,2,5,4,3}, {0,3,4,7,6,5,2,1},
+      {0,3,4,7,6,5,2,1}, {2,3,0,1,6,7,4,5},
+      {2,3,0,1,6,7,4,5}, {6,5,2,1,0,3,4,7},
+      {6,5,2,1,0,3,4,7}, {4,3,2,5,6,1,0,7} };
+   int GeoCod2d[4] = {1,2,0,3};
+   int HilCod2d[4][4] = {{0,3,2,1}, {0,1,2,3}, {0,1,2,3}, {2,1,0,3}};
+
+   // 21 levels in 3d are walked 3 by 3, 31 levels in 2d are walked 4 by 4
+   // and the last 3 one by one
+   SfcOk =  BldSfc(3, GeoCod3d, &HilCod3d[0][0], 3, &Sfc3dTab[0][0])
+         && BldSfc(2, GeoCod2d, &HilCod2d[0][0], 4, &Sfc2dTab[0][0])
+         && BldSfc(2, GeoCod2d, &HilCod2d[0][0], 1, &Sfc2dOne[0][0]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Enumerate the rotations reachable from the initial one, then chain NmbLvl  */
+/* levels for each state and group of geometric bits                          */
+/* Returns 0 if the curve has more rotations than MaxSfcSta                   */
+/*----------------------------------------------------------------------------*/
+
+static int BldSfc(int NmbDim, int *GeoCod, int *HilCod, int NmbLvl, uint16_t *tab)
+{
+   int i, j, k, s, bit, out, NmbSta = 1, n = 1 << NmbDim, NmbBit = NmbDim * NmbLvl;
+   int rot[8], StaRot[ MaxSfcSta ][8], NexSta[ MaxSfcSta ][8];
+
+   memcpy(StaRot[0], GeoCod, n * sizeof(int));
+
+   for(i=0;i<NmbSta;i++)
+      for(j=0;j<n;j++)
+      {
+         for(k=0;k<n;k++)
+            rot[k] = HilCod[ StaRot[i][j] * n + StaRot[i][k] ];
+
+         for(s=0;s<NmbSta;s++)
+            if(!memcmp(rot, StaRot[s], n * sizeof(int)))
+               break;
+
+         if(s == NmbSta)
+         {
+            if(NmbSta == MaxSfcSta)
+               return(0);
+
+            memcpy(StaRot[ NmbSta++ ], rot, n * sizeof(int));
+         }
+
+         NexSta[i][j] = s;
+      }
+
+   for(i=0;i<NmbSta;i++)
+      for(j=0;j<1<<NmbBit;j++)
+      {
+         for(k=0, s=i, out=0; k<NmbLvl; k++)
+         {
+            bit = (j >> (NmbDim * (NmbLvl - 1 - k))) & (n - 1);
+            out = (out << NmbDim) | StaRot[s][ bit ];
+            s = NexSta[s][ bit ];
+         }
+
+         tab[ (i << NmbBit) + j ] = (uint16_t)(out | (s << NmbBit));
+      }
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Clear a bit in a multibyte word                                            */
+/* Spread an integer's bits every NmbDim positions                            */
 /*----------------------------------------------------------------------------*/
 
-static void ClrBit(int *tab, int idx)
+static uint64_t SprBit(uint64_t val, int NmbDim)
 {
-   tab[ idx >> 5 ] &= ~(1UL << (idx & 31));
+#ifdef __BMI2__
+   return(_pdep_u64(val, (NmbDim == 3) ? 0x1249249249249249ULL : 0x5555555555555555ULL));
+#else
+   if(NmbDim == 3)
+   {
+      val &= 0x1fffff;
+      val = (val | val << 32) & 0x1f00000000ffffULL;
+      val = (val | val << 16) & 0x1f0000ff0000ffULL;
+      val = (val | val <<  8) & 0x100f00f00f00f00fULL;
+      val = (val | val <<  4) & 0x10c30c30c30c30c3ULL;
+      val = (val | val <<  2) & 0x1249249249249249ULL;
+   }
+   else
+   {
+      val &= 0xffffffff;
+      val = (val | val << 16) & 0x0000ffff0000ffffULL;
+      val = (val | val <<  8) & 0x00ff00ff00ff00ffULL;
+      val = (val | val <<  4) & 0x0f0f0f0f0f0f0f0fULL;
+      val = (val | val <<  2) & 0x3333333333333333ULL;
+      val = (val | val <<  1) & 0x5555555555555555ULL;
+   }
+
+   return(val);
+#endif
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Check wether two WP share common resources -> locked                       */
+/* Encode a batch of up to SfcBat points: a first loop converts and           */
+/* interleaves all coordinates, a second one walks the state machine          */
+/* box holds the lower corner followed by the scaling factors                 */
 /*----------------------------------------------------------------------------*/
 
-static int AndWrd(int NmbWrd, int *wrd1, int *wrd2)
+static void SfcBlk( int NmbDim, int CrvTyp, double *box, double *crd,
+                    int NmbCrd, uint64_t *cod )
 {
-   int i;
+   int i, j;
+   uint64_t IntCrd, sta, res, MrtCod[ SfcBat ];
+   double dbl;
 
-   for(i=0;i<NmbWrd;i++)
-      if(wrd1[i] & wrd2[i])
-         return(1);
+   for(i=0;i<NmbCrd;i++)
+   {
+      MrtCod[i] = 0;
 
-   return(0);
-}
+      for(j=0;j<NmbDim;j++)
+      {
+         // Clamp the points lying on the upper bound
+         dbl = (crd[ i * NmbDim + j ] - box[j]) * box[ j + NmbDim ];
+         IntCrd = (dbl <= 0.) ? 0 : (dbl >= 18446744073709551615.) ? ~0ULL : (uint64_t)dbl;
 
+         // Keep the 21 (3d) or 31 (2d) highest significant bits
+         if(NmbDim == 3)
+            MrtCod[i] |= SprBit(IntCrd >> 43, 3) << j;
+         else
+            MrtCod[i] |= SprBit((IntCrd >> 32) & 0x7fffffff, 2) << j;
+      }
+   }
 
-/*----------------------------------------------------------------------------*/
-/* Logical OR between two multibyte words                                     */
-/*----------------------------------------------------------------------------*/
+   if(CrvTyp == ZCurve)
+   {
+      for(i=0;i<NmbCrd;i++)
+         cod[i] = MrtCod[i];
 
-static void AddWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
-{
-   int i;
+      return;
+   }
 
-   for(i=0;i<NmbWrd;i++)
-      DstWrd[i] |= SrcWrd[i];
+   for(i=0;i<NmbCrd;i++)
+   {
+      sta = res = 0;
+
+      if(NmbDim == 3)
+      {
+         for(j=54;j>=0;j-=9)
+         {
+            sta = Sfc3dTab[ sta ][ (MrtCod[i] >> j) & 511 ];
+            res = (res << 9) | (sta & 511);
+            sta >>= 9;
+         }
+      }
+      else
+      {
+         for(j=54;j>=6;j-=8)
+         {
+            sta = Sfc2dTab[ sta ][ (MrtCod[i] >> j) & 255 ];
+            res = (res << 8) | (sta & 255);
+            sta >>= 8;
+         }
+
+         for(j=4;j>=0;j-=2)
+         {
+            sta = Sfc2dOne[ sta ][ (MrtCod[i] >> j) & 3 ];
+            res = (res << 2) | (sta & 3);
+            sta >>= 2;
+         }
+      }
+
+      cod[i] = res;
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Exclusive OR between two multibyte words                                   */
+/* Compute the hilbert code and store it with its index                       */
 /*----------------------------------------------------------------------------*/
 
-static void SubWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
+static void RenPrc(itg BegIdx, itg EndIdx, int PthIdx, ArgSct *arg)
 {
-   int i;
+   itg i;
+   int j, n;
+   uint64_t cod[ SfcBat ];
+   (void)(PthIdx);
 
-   for(i=0;i<NmbWrd;i++)
-      DstWrd[i] &= ~SrcWrd[i];
+   for(i=BegIdx; i<=EndIdx; i+=SfcBat)
+   {
+      n = (EndIdx - i + 1 < SfcBat) ? EndIdx - i + 1 : SfcBat;
+      SfcBlk(  arg->NmbDim, HilbertCurve, arg->box,
+               &arg->CrdTab[ (size_t)i * arg->NmbDim ], n, cod );
+
+      for(j=0;j<n;j++)
+      {
+         arg->idx[ i+j ][0] = cod[j];
+         arg->idx[ i+j ][1] = i+j;
+      }
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Clear a multibyte word                                                     */
+/* Compute the SFC codes of a range of points                                 */
 /*----------------------------------------------------------------------------*/
 
-static void ClrWrd(int NmbWrd, int *wrd)
+static void BatPrc(itg BegIdx, itg EndIdx, int PthIdx, ArgSct *arg)
 {
-   int i;
+   itg i;
+   (void)(PthIdx);
 
-   for(i=0;i<NmbWrd;i++)
-      wrd[i] = 0;
+   for(i=BegIdx; i<=EndIdx; i+=SfcBat)
+      SfcBlk(  arg->NmbDim, arg->CrvTyp, arg->box,
+               &arg->CrdTab[ (size_t)i * arg->NmbDim ],
+               (EndIdx - i + 1 < SfcBat) ? EndIdx - i + 1 : SfcBat,
+               &arg->CodTab[i] );
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Copy a multibyte word into another one                                     */
+/* Compute the Hilbert or Z-curve code of NmbLin points with NmbDim (2 or 3)  */
+/* coordinates each, stored from index 1 like the codes                       */
+/* box holds the lower corner followed by the upper one                       */
+/* A null ParIdx runs the encoding in the calling thread                      */
 /*----------------------------------------------------------------------------*/
 
-static void CpyWrd(int NmbWrd, int *SrcWrd, int *DstWrd)
+int HilbertEncodeBatch( int64_t ParIdx, int CrvTyp, int NmbDim, itg NmbLin,
+                        double *box, double *crd, uint64_t *cod )
 {
-   int i;
+   int i, NewTyp;
+   ArgSct arg;
 
-   for(i=0;i<NmbWrd;i++)
-      DstWrd[i] = SrcWrd[i];
+   if( ((NmbDim != 2) && (NmbDim != 3)) || ((CrvTyp != HilbertCurve)
+   &&  (CrvTyp != ZCurve)) || (NmbLin < 1) || !box || !crd || !cod )
+   {
+      return(0);
+   }
+
+   WaiAsy((ParSct *)ParIdx);
+
+   pthread_once(&SfcOnc, IniSfc);
+
+   if(!SfcOk)
+      return(0);
+
+   // Use the same scaling as HilbertRenumbering
+   arg.NmbDim = NmbDim;
+   arg.CrvTyp = CrvTyp;
+   arg.CrdTab = crd;
+   arg.CodTab = cod;
+
+   for(i=0;i<NmbDim;i++)
+   {
+      if(box[ i + NmbDim ] <= box[i])
+         return(0);
+
+      arg.box[i] = box[i];
+      arg.box[ i + NmbDim ] = pow(2, (NmbDim == 3) ? 64 : 62) / (box[ i + NmbDim ] - box[i]);
+   }
+
+   if(!ParIdx || (NmbLin < 10000) || !(NewTyp = NewType(ParIdx, NmbLin)))
+      BatPrc(1, NmbLin, 0, &arg);
+   else
+   {
+      LaunchParallel(ParIdx, NewTyp, 0, (void *)BatPrc, (void *)&arg);
+      FreeType(ParIdx, NewTyp);
+   }
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Compare two workpackages number of bits                                    */
+/* Comparison of two items for the qsort                                      */
 /*----------------------------------------------------------------------------*/
 
-int CmpWrk(const void *ptr1, const void *ptr2)
+int CmpPrc(const void *a, const void *b)
 {
-   WrkSct *w1, *w2;
-
-   w1 = (WrkSct *)ptr1;
-   w2 = (WrkSct *)ptr2;
+   uint64_t *pa = (uint64_t *)a, *pb = (uint64_t *)b;
+   return(*pa > *pb ? 1 : -1);
+}
 
-   if(w1->NmbDep > w2->NmbDep)
-      return(-1);
-   else if(w1->NmbDep < w2->NmbDep)
-      return(1);
-   else
-      return(0);
+void PipSrt(PipArgSct *arg)
+{
+   qsort(arg->base, arg->nel, arg->width, arg->compar);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Generate static scheduling groups of small WP for each thread              */
+/* Renumber a set of coordinates through a Hilbert SFC                        */
 /*----------------------------------------------------------------------------*/
 
-static int SetGrp(ParSct *par, TypSct *typ)
+int HilbertRenumbering( int64_t ParIdx, itg NmbLin, double box[6],
+                        double (*crd)[3], uint64_t (*idx)[2] )
 {
-   int      i, NmbSmlWrk, *GrpWrd, *AllWrd, *TstWrd;
-   int      IncFlg, siz = typ->NmbDepWrd;
-   GrpSct   *grp;
-   WrkSct   *wrk, *NexWrk;
+   int      i, NewTyp;
+   double   len = pow(2,64);
+   ArgSct   arg;
 
-   // Initialize the static group list
-   NmbSmlWrk = typ->NmbSmlWrk;
-   typ->NmbGrp = 0;
-   typ->NexGrp = NULL;
+   // Get and check lib parallel instance
+   if(!ParIdx)
+     return(0);
 
-   // Allocate a dependency word to contain all threads
-   if(!(GrpWrd = LPL_malloc(par->lmb, par->NmbCpu * siz * sizeof(int))))
-      return(0);
+   WaiAsy((ParSct *)ParIdx);
 
-   // Allocate a dependency word to concatenate all thread words
-   if(!(AllWrd = LPL_malloc(par->lmb, siz * sizeof(int))))
-      return(0);
+   // Setup the bounding box and a data type,
+   // then give a Hilbert code to each entries
+   pthread_once(&SfcOnc, IniSfc);
 
-   // Allocate a working dependency word for testings
-   if(!(TstWrd = LPL_malloc(par->lmb, siz * sizeof(int))))
+   if(!SfcOk)
       return(0);
 
-   // Link all WP together to make a free list
-   NexWrk = &typ->SmlWrkTab[0];
+   NewTyp = NewType(ParIdx, NmbLin);
+   arg.NmbDim = 3;
+   arg.CrdTab = &crd[0][0];
+   arg.idx = idx;
+   arg.box[0] = box[0];
+   arg.box[1] = box[1];
+   arg.box[2] = box[2];
+   arg.box[3] = len / (box[3] - box[0]);
+   arg.box[4] = len / (box[4] - box[1]);
+   arg.box[5] = len / (box[5] - box[2]);
 
-   for(i=0;i<typ->NmbSmlWrk;i++)
-   {
-      typ->SmlWrkTab[i].pre = &typ->SmlWrkTab[ i - 1 ];
-      typ->SmlWrkTab[i].nex = &typ->SmlWrkTab[ i + 1 ];
-   }
+   if( (NmbLin < 10000) || !NewTyp )
+      RenPrc(1, NmbLin, 0, &arg);
+   else
+      LaunchParallel(ParIdx, NewTyp, 0, (void *)RenPrc, (void *)&arg);
 
-   typ->SmlWrkTab[0].pre = NULL;
-   typ->SmlWrkTab[ typ->NmbSmlWrk - 1 ].nex = NULL;
+   if(NewTyp)
+      FreeType(ParIdx, NewTyp);
 
-   // Kepp on creating new groups as long as there are free WP
-   do
-   {
-      // Allocate a new group and link it
-      if(!(grp = LPL_calloc(par->lmb, 1, sizeof(GrpSct))))
-         return(0);
+   if(!ParallelRadixSort(ParIdx, &idx[1], NmbLin))
+      qsort(&idx[1][0], NmbLin, 2 * sizeof(int64_t), CmpPrc);
 
-      grp->nex = typ->NexGrp;
-      typ->NexGrp = grp;
-      grp->idx = ++typ->NmbGrp;
+   for(i=1;i<=NmbLin;i++)
+      idx[ idx[i][1] ][0] = i;
 
-      // Reset all the dependencies words
-      memset(GrpWrd, 0, par->NmbCpu * siz * sizeof(int));
-      memset(AllWrd, 0, siz * sizeof(int));
+   return(1);
+}
 
-      // Keep on adding WP to each groups' threads until they reach WrkPerGrp
-      do
-      {
-         // Could we add some WP to this group during this iteration ?
-         IncFlg = 0;
 
-         // Loop over the threads and try adding them as many WP as possible
-         for(i=0;i<par->NmbCpu;i++)
-         {
-            // Do not add WP is this threads has reached its target number
-            if(!NexWrk || (grp->NmbSmlWrk[i] >= WrkPerGrp))
-               continue;
+/*----------------------------------------------------------------------------*/
+/* Renumber a set of 2D coordinates through a Hilbert SFC                     */
+/*----------------------------------------------------------------------------*/
 
-            // Initialize the WP pointer with the first
-            // available one from the linked list
-            wrk = NexWrk;
+int HilbertRenumbering2D(  int64_t ParIdx, itg NmbLin, double box[4],
+                           double (*crd)[2], uint64_t (*idx)[2] )
+{
+   itg i;
+   int NewTyp;
+   double len = pow(2,62);
+   ArgSct arg;
 
-            // Then loop over the linked list of available WP and add them to
-            // the curent group-thread list as long as they do not interfere
-            // with the combined dependency word of other threads
-            do
-            {
-               // To avoid making a AND with all threads' words, we remode (XOR)
-               // the tested thread' word from the combined one and test (AND)
-               // it against this WP's word
-               CpyWrd(siz, AllWrd, TstWrd);
-               SubWrd(siz, &GrpWrd[ i * siz ], TstWrd);
+   // Get and check lib parallel instance
+   if(!ParIdx)
+      return(0);
 
-               if(!AndWrd(siz, wrk->DepWrdTab, TstWrd))
-               {
-                  // If this WP is compatible, add its word to the thread
-                  // dependency word and to the combined one
-                  AddWrd(siz, wrk->DepWrdTab, AllWrd);
-                  AddWrd(siz, wrk->DepWrdTab, &GrpWrd[ i * siz ]);
+   WaiAsy((ParSct *)ParIdx);
 
-                  // Add this WP to the list, decrease the number of available
-                  // WPs and set the flag to indicate that we found some work
-                  grp->SmlWrkTab[i][ grp->NmbSmlWrk[i] ] = wrk;
-                  grp->NmbSmlWrk[i]++;
-                  NmbSmlWrk--;
-                  IncFlg = 1;
+   pthread_once(&SfcOnc, IniSfc);
 
-                  // Unlink the WP from the available WP linked list
-                  if(wrk->pre)
-                     wrk->pre->nex = wrk->nex;
-                  else
-                     NexWrk = wrk->nex;
+   if(!SfcOk)
+      return(0);
 
-                  if(wrk->nex)
-                     wrk->nex->pre = wrk->pre;
-               }
+   NewTyp = NewType(ParIdx, NmbLin);
+   arg.NmbDim = 2;
+   arg.CrdTab = &crd[0][0];
+   arg.idx = idx;
+   arg.box[0] = box[0];
+   arg.box[1] = box[1];
+   arg.box[2] = len / (box[2] - box[0]);
+   arg.box[3] = len / (box[3] - box[1]);
 
-               // Stop adding WP to this group-thread if its table is full
-               if(grp->NmbSmlWrk[i] >= WrkPerGrp)
-                  break;
+   if( (NmbLin < 10000) || !NewTyp )
+      RenPrc(1, NmbLin, 0, &arg);
+   else
+      LaunchParallel(ParIdx, NewTyp, 0, (void *)RenPrc, (void *)&arg);
 
-               wrk = wrk->nex;
-            }while(wrk && NmbSmlWrk);
-         }
-      }while(IncFlg && NmbSmlWrk);
-   }while(NmbSmlWrk);
+   if(NewTyp)
+      FreeType(ParIdx, NewTyp);
 
-   LPL_free(par->lmb, GrpWrd);
-   LPL_free(par->lmb, AllWrd);
-   LPL_free(par->lmb, TstWrd);
+   if(!ParallelRadixSort(ParIdx, &idx[1], NmbLin))
+      qsort(&idx[1][0], NmbLin, 2 * sizeof(int64_t), CmpPrc);
+
+   for(i=1;i<=NmbLin;i++)
+      idx[ idx[i][1] ][0] = i;
 
    return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/*Loop over the type's color and launch a thread for each grain               */
+/* Run an internal procedure over NmbLin lines with a temporary type,         */
+/* small sizes are processed by the calling thread                            */
 /*----------------------------------------------------------------------------*/
 
-int LaunchColorGrains(int64_t ParIdx, int TypIdx, void *prc, void *PtrArg)
+static void RunLin(int64_t ParIdx, itg NmbLin, void *prc, void *arg)
 {
-   int      i, col, ret, NmbPth;
-   void     *sta;
-   ParSct   *par = (ParSct *)ParIdx;
-   TypSct   *typ;
-   GrnSct   *grn, GrnTab[ 1100 ];
-   pthread_attr_t attr;
+   int NewTyp;
+   void (*UsrPrc)(itg, itg, int, void *) = (void (*)(itg, itg, int, void *))prc;
 
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(1);
+   if( (NmbLin < 10000) || !(NewTyp = NewType(ParIdx, NmbLin)) )
+      UsrPrc(1, NmbLin, 0, arg);
+   else
+   {
+      LaunchParallel(ParIdx, NewTyp, 0, prc, arg);
+      FreeType(ParIdx, NewTyp);
+   }
+}
 
-   // Check bounds
-   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
-      return(2);
 
-   typ =  &par->TypTab[ TypIdx ];
+/*----------------------------------------------------------------------------*/
+/* Compute the bounding box of a range of points in the thread's own slot     */
+/*----------------------------------------------------------------------------*/
 
-   // Setup a thread arguments structure to set them as joinable
-   pthread_attr_init(&attr);
-   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+static void BoxPrc(itg BegIdx, itg EndIdx, int PthIdx, RenSct *arg)
+{
+   itg i;
+   int j, NmbDim = arg->NmbDim;
+   double *box = arg->BoxTab[ PthIdx ], *crd;
 
-   // Loop over the colors
-   for(col=1;col<=typ->NmbCol;col++)
+   for(i=BegIdx; i<=EndIdx; i++)
    {
-      NmbPth = 0;
+      crd = &arg->crd[ (size_t)i * NmbDim ];
 
-      // Loop overt the color's grains
-      for(i=typ->ColTab[ col ][0]; i<=typ->ColTab[ col ][1]; i++)
+      for(j=0;j<NmbDim;j++)
       {
-         // Point to the next local grain structure
-         grn = &GrnTab[ NmbPth++ ];
+         if(crd[j] < box[j])
+            box[j] = crd[j];
 
-         grn->GrnIdx = i;
-         grn->BegIdx = typ->GrnTab[i][0];
-         grn->EndIdx = typ->GrnTab[i][1];
-         grn->par = par;
-         grn->prc = prc;
-         grn->arg = PtrArg;
+         if(crd[j] > box[ j + NmbDim ])
+            box[ j + NmbDim ] = crd[j];
+      }
+   }
+}
 
-         // Reset the thread structure
-         memset(&grn->pth, 0, sizeof(pthread_t));
 
-         // Launch the cleared thread with the curent grain information
-         pthread_create(&grn->pth, &attr, GrnHdl, (void *)grn);
-      }
+/*----------------------------------------------------------------------------*/
+/* Compute the points' bounding box and store it with the SFC scaling factors */
+/* Flat directions get a unit length so that 2D meshes may be stored in 3D    */
+/*----------------------------------------------------------------------------*/
 
-      NmbPth = 0;
+static int SetRenBox(int64_t ParIdx, itg NmbVer, RenSct *arg)
+{
+   int i, j, NmbDim = arg->NmbDim;
+   double len = pow(2, (NmbDim == 3) ? 64 : 62), *box;
 
-      // Loop over the grain threads and wait for their completion
-      for(i=typ->ColTab[ col ][0]; i<=typ->ColTab[ col ][1]; i++)
+   for(i=0;i<MaxPth;i++)
+      for(j=0;j<NmbDim;j++)
       {
-         grn = &GrnTab[ NmbPth++ ];
-         ret = pthread_join(grn->pth, &sta);
+         arg->BoxTab[i][j] = DBL_MAX;
+         arg->BoxTab[i][ j + NmbDim ] = -DBL_MAX;
+      }
 
-         if(ret)
-         {
-            printf("ERROR; return code from pthread_join() is %d\n", ret);
-            exit(-1);
-         }
+   RunLin(ParIdx, NmbVer, (void *)BoxPrc, (void *)arg);
+
+   // Merge the threads' boxes and turn the upper corner into scaling factors
+   for(j=0;j<NmbDim;j++)
+   {
+      box = arg->box;
+      box[j] = DBL_MAX;
+      box[ j + NmbDim ] = -DBL_MAX;
+
+      for(i=0;i<MaxPth;i++)
+      {
+         box[j] = fmin(box[j], arg->BoxTab[i][j]);
+         box[ j + NmbDim ] = fmax(box[ j + NmbDim ], arg->BoxTab[i][ j + NmbDim ]);
       }
-   }
 
-   pthread_attr_destroy(&attr);
+      if(box[j] > box[ j + NmbDim ])
+         return(0);
 
-   return(0);
+      if(box[ j + NmbDim ] > box[j])
+         box[ j + NmbDim ] = len / (box[ j + NmbDim ] - box[j]);
+      else
+         box[ j + NmbDim ] = len;
+   }
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Thread handler launching and waiting for user's procedure completion       */
+/* Gather the vertices in the sorted order and fill the old to new table      */
 /*----------------------------------------------------------------------------*/
 
-static void *GrnHdl(void *ptr)
+static void VerPrc(itg BegIdx, itg EndIdx, int PthIdx, RenSct *arg)
 {
-   GrnSct *grn = (GrnSct *)ptr;
-   void (*prc)(int, int, int, void *) = grn->prc;
+   itg i, OldIdx;
+   int j, NmbDim = arg->NmbDim;
+   (void)(PthIdx);
 
-   prc(grn->BegIdx, grn->EndIdx, grn->GrnIdx, grn->arg);
+   for(i=BegIdx; i<=EndIdx; i++)
+   {
+      OldIdx = (itg)arg->idx[i][1];
 
-   return(NULL);
+      for(j=0;j<NmbDim;j++)
+         arg->crd[ (size_t)i * NmbDim + j ] = arg->TmpCrd[ (size_t)OldIdx * NmbDim + j ];
+
+      if(arg->ref)
+         arg->ref[i] = arg->TmpRef[ OldIdx ];
+
+      arg->Old2New[ OldIdx ] = i;
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Provide the LPlib with color and grain index for each entities             */
+/* Remap the elements' vertices and give each element the SFC code            */
+/* of its barycenter                                                          */
 /*----------------------------------------------------------------------------*/
 
-int SetColorGrains(  int64_t ParIdx, int TypIdx,
-                     int NmbCol, int *ColTab,
-                     int NmbGrn, int *GrnTab )
+static void ElePrc(itg BegIdx, itg EndIdx, int PthIdx, RenSct *arg)
 {
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *typ;
+   itg i, *EleTab;
+   int j, k, n, NmbDim = arg->NmbDim, EleSiz = arg->EleSiz;
+   uint64_t cod[ SfcBat ];
+   double MidCrd[ SfcBat * 3 ], *crd;
+   (void)(PthIdx);
 
-   // Check type validity
-   if( (TypIdx < 1) || (TypIdx > MaxTyp) )
-      return(1);
+   for(i=BegIdx; i<=EndIdx; i+=SfcBat)
+   {
+      n = (EndIdx - i + 1 < SfcBat) ? EndIdx - i + 1 : SfcBat;
 
-   typ = &par->TypTab[ TypIdx ];
+      for(j=0;j<n;j++)
+      {
+         EleTab = &arg->EleTab[ (size_t)(i+j) * EleSiz ];
 
-   // Allocate and copy memory to store colors information
-   typ->NmbCol = NmbCol;
-   typ->ColTab = LPL_malloc(par->lmb, (NmbCol+1) * 2 * sizeof(int));
+         for(k=0;k<NmbDim;k++)
+            MidCrd[ j * NmbDim + k ] = 0.;
 
-   if(!typ->ColTab)
-      return(2);
+         for(k=0;k<EleSiz;k++)
+         {
+            if(arg->Old2New)
+               EleTab[k] = arg->Old2New[ EleTab[k] ];
 
-   memcpy(typ->ColTab, ColTab, (NmbCol+1) * 2 * sizeof(int));
+            crd = &arg->crd[ (size_t)EleTab[k] * NmbDim ];
+            MidCrd[ j * NmbDim ] += crd[0];
+            MidCrd[ j * NmbDim + 1 ] += crd[1];
 
-   // Allocate and copy memory to store grains information
-   typ->NmbGrn = NmbGrn;
-   typ->GrnTab = LPL_malloc(par->lmb, (NmbGrn+1) * 2 * sizeof(int));
+            if(NmbDim == 3)
+               MidCrd[ j * NmbDim + 2 ] += crd[2];
+         }
 
-   if(!typ->GrnTab)
-      return(3);
+         for(k=0;k<NmbDim;k++)
+            MidCrd[ j * NmbDim + k ] /= EleSiz;
+      }
 
-   memcpy(typ->GrnTab, GrnTab, (NmbGrn+1) * 2 * sizeof(int));
+      SfcBlk(NmbDim, HilbertCurve, arg->box, MidCrd, n, cod);
 
-   return(0);
+      for(j=0;j<n;j++)
+      {
+         arg->idx[ i+j ][0] = cod[j];
+         arg->idx[ i+j ][1] = i+j;
+      }
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Set an element field colors and grains from their vertices information     */
-/* Elements must be sorted against trheir color and grain beforehand          */
+/* Gather the elements in the sorted order                                    */
 /*----------------------------------------------------------------------------*/
 
-int SetElementsColorGrain( int64_t ParIdx, int VerTypIdx, int EleTypIdx,
-                           int EleSiz, int *EleTab )
+static void PrmPrc(itg BegIdx, itg EndIdx, int PthIdx, RenSct *arg)
 {
-   int i, VerIdx, CurGrn = 1, BegIdx = 1;
-   ParSct *par = (ParSct *)ParIdx;
-   TypSct *VerTyp, *EleTyp;
+   itg i, OldIdx;
+   int EleSiz = arg->EleSiz;
+   (void)(PthIdx);
 
-   // Make sur there are vertices and this element kind
-   if(VerTypIdx < 1 || VerTypIdx > MaxTyp || EleTypIdx < 1 || EleTypIdx > MaxTyp)
-      return(1);
+   for(i=BegIdx; i<=EndIdx; i++)
+   {
+      OldIdx = (itg)arg->idx[i][1];
 
-   VerTyp = &par->TypTab[ VerTypIdx ];
-   EleTyp = &par->TypTab[ EleTypIdx ];
+      memcpy(  &arg->EleTab[ (size_t)i * EleSiz ],
+               &arg->TmpEle[ (size_t)OldIdx * EleSiz ], EleSiz * sizeof(itg) );
 
-   // Vertices must have colors and grains set
-   if(!VerTyp->NmbCol || !VerTyp->NmbGrn)
-      return(2);
+      if(arg->ref)
+         arg->ref[i] = arg->TmpRef[ OldIdx ];
+   }
+}
 
-   // Allocate a color table and a grain table for this element kind
-   if(!(EleTyp->ColTab = LPL_calloc(par->lmb, VerTyp->NmbCol + 1, 2 * sizeof(int))))
-      return(3);
 
-   if(!(EleTyp->GrnTab = LPL_calloc(par->lmb, VerTyp->NmbGrn + 1, 2 * sizeof(int))))
-      return(4);
+/*----------------------------------------------------------------------------*/
+/* Renumber in place a set of vertices along the Hilbert SFC                  */
+/* crd holds NmbDim (2 or 3) coordinates per vertex and the optional ref one  */
+/* integer, both stored from index 1.                                         */
+/* Old2New (NmbVer+1 entries) receives the new index of each old vertex       */
+/*----------------------------------------------------------------------------*/
 
-   // The number of colors and grains partition must match that of the vertices
-   EleTyp->NmbCol = VerTyp->NmbCol;
-   EleTyp->NmbGrn = VerTyp->NmbGrn;
+int RenumberVertices(int64_t ParIdx, int NmbDim, itg NmbVer,
+                     double *crd, itg *ref, itg *Old2New)
+{
+   ParSct *par = (ParSct *)ParIdx;
+   ArgSct SfcArg;
+   RenSct arg;
 
-   // Each element's colors partitions point to the same grains as the vertex ones
-   for(i=1;i<=VerTyp->NmbCol;i++)
+   // Get and check lib parallel instance and arguments
+   if( !ParIdx || ((NmbDim != 2) && (NmbDim != 3)) || (NmbVer < 1)
+   ||  !crd || !Old2New )
    {
-      EleTyp->ColTab[i][0] = VerTyp->ColTab[i][0];
-      EleTyp->ColTab[i][1] = VerTyp->ColTab[i][1];
+      return(0);
    }
 
-   // Setup the first and last element index in each grain
-   for(i=1;i<=EleTyp->NmbLin;i++)
-   {
-      VerIdx = EleTab[ i * EleSiz ];
+   WaiAsy(par);
 
-      if(VerIdx > VerTyp->GrnTab[ CurGrn ][1])
-      {
-         EleTyp->GrnTab[ CurGrn ][0] = BegIdx;
-         EleTyp->GrnTab[ CurGrn ][1] = i - 1;
-         CurGrn++;
-         BegIdx = i;
-      }
-   }
+   pthread_once(&SfcOnc, IniSfc);
 
-   // Special setup for the last grain
-   EleTyp->GrnTab[ CurGrn ][0] = BegIdx;
-   EleTyp->GrnTab[ CurGrn ][1] = EleTyp->NmbLin;
+   if(!SfcOk)
+      return(0);
 
-   return(0);
-}
+   memset(&arg, 0, sizeof(RenSct));
+   arg.NmbDim = NmbDim;
+   arg.crd = crd;
+   arg.ref = ref;
+   arg.Old2New = Old2New;
 
+   if(!SetRenBox(ParIdx, NmbVer, &arg))
+      return(0);
 
-/*----------------------------------------------------------------------------*/
-/* Launch the loop prc on typ1 element depending on typ2                      */
-/*----------------------------------------------------------------------------*/
+   if(!(arg.idx = LPL_malloc(par->lmb, ((int64_t)NmbVer + 1) * 2 * sizeof(uint64_t))))
+      return(0);
 
-int ParallelMemClear(int64_t ParIdx, void *PtrArg, size_t siz)
-{
-   char *tab = (char *)PtrArg;
-   int i;
-   PthSct *pth;
-   ParSct *par = (ParSct *)ParIdx;
+   if(!(arg.TmpCrd = LPL_malloc(par->lmb, ((int64_t)NmbVer + 1) * NmbDim * sizeof(double)))
+   || (ref && !(arg.TmpRef = LPL_malloc(par->lmb, ((int64_t)NmbVer + 1) * sizeof(itg)))) )
+   {
+      if(arg.TmpCrd)
+         LPL_free(par->lmb, arg.TmpCrd);
 
-   // Get and check lib parallel instance, adresse and size
-   if(!ParIdx || !tab || (siz < (size_t)par->NmbCpu) )
+      LPL_free(par->lmb, arg.idx);
       return(0);
+   }
 
-   // Lock acces to global parameters
-   pthread_mutex_lock(&par->ParMtx);
+   // Give a Hilbert code to each vertex and sort them
+   SfcArg.NmbDim = NmbDim;
+   SfcArg.CrdTab = crd;
+   SfcArg.idx = arg.idx;
+   memcpy(SfcArg.box, arg.box, 6 * sizeof(double));
+   RunLin(ParIdx, NmbVer, (void *)RenPrc, (void *)&SfcArg);
 
-   par->cmd = ClrMem;
-   par->ClrLinSiz = siz / par->NmbCpu;
-   par->WrkCpt = 0;
+   if(!ParallelRadixSort(ParIdx, &arg.idx[1], NmbVer))
+      qsort(&arg.idx[1][0], NmbVer, 2 * sizeof(int64_t), CmpPrc);
 
-   // Spread the buffer among each thread and wake then up
-   for(i=0;i<par->NmbCpu;i++)
-   {
-      pth = &par->PthTab[i];
-      pth->ClrAdr = &tab[ i * par->ClrLinSiz ];
+   // Move the vertices to their new location through a copy of the old ones
+   memcpy(arg.TmpCrd, crd, ((size_t)NmbVer + 1) * NmbDim * sizeof(double));
 
-      pthread_mutex_lock(&pth->mtx);
-      pthread_cond_signal(&pth->cnd);
-      pthread_mutex_unlock(&pth->mtx);
-   }
+   if(ref)
+      memcpy(arg.TmpRef, ref, ((size_t)NmbVer + 1) * sizeof(itg));
 
-   // Wait for each thread to complete
-   while(par->WrkCpt < par->NmbCpu)
-      pthread_cond_wait(&par->ParCnd, &par->ParMtx);
+   RunLin(ParIdx, NmbVer, (void *)VerPrc, (void *)&arg);
 
-   pthread_mutex_unlock(&par->ParMtx);
+   if(arg.TmpRef)
+      LPL_free(par->lmb, arg.TmpRef);
+
+   LPL_free(par->lmb, arg.TmpCrd);
+   LPL_free(par->lmb, arg.idx);
 
    return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Wait for a condition, launch and detach a user procedure                   */
+/* Renumber in place a table of elements made of EleSiz vertices each         */
+/* along the Hilbert SFC of their barycenters.                                */
+/* If Old2New is given, the elements' vertices are first renumbered with it.  */
+/* crd must hold the vertices' coordinates in their final numbering           */
 /*----------------------------------------------------------------------------*/
 
-int LaunchPipeline(  int64_t ParIdx, void *prc,
-                     void *PtrArg, int NmbDep, int *DepTab )
+int RenumberElements(int64_t ParIdx, int NmbDim, itg NmbVer, double *crd,
+                     itg *Old2New, itg NmbEle, int EleSiz, itg *EleTab, itg *ref)
 {
-   int i;
-   PipSct *NewPip=NULL;
    ParSct *par = (ParSct *)ParIdx;
+   RenSct arg;
 
-   // Get and check lib parallel instance and the number of pipes and dependencies
-   if( !ParIdx || (NmbDep > MaxPipDep) || (par->NmbPip >= MaxTotPip) )
+   // Get and check lib parallel instance and arguments
+   if( !ParIdx || ((NmbDim != 2) && (NmbDim != 3)) || (NmbVer < 1)
+   ||  !crd || (NmbEle < 0) || (EleSiz < 1) || !EleTab )
+   {
       return(0);
+   }
 
-   // Allocate and setup a new pipe
-   if(!(NewPip = LPL_calloc(par->lmb, 1, sizeof(PipSct))))
+   WaiAsy(par);
+
+   if(!NmbEle)
+      return(1);
+
+   pthread_once(&SfcOnc, IniSfc);
+
+   if(!SfcOk)
       return(0);
 
-   NewPip->prc = prc;
-   NewPip->arg = PtrArg;
-   NewPip->par = par;
-   NewPip->NmbDep = NmbDep;
+   memset(&arg, 0, sizeof(RenSct));
+   arg.NmbDim = NmbDim;
+   arg.EleSiz = EleSiz;
+   arg.crd = crd;
+   arg.ref = ref;
+   arg.Old2New = Old2New;
+   arg.EleTab = EleTab;
 
-   for(i=0;i<NmbDep;i++)
-      NewPip->DepTab[i] = DepTab[i];
+   // Elements' barycenters lie within the vertices' bounding box
+   if(!SetRenBox(ParIdx, NmbVer, &arg))
+      return(0);
 
-   // In case variable arguments where passed through the common LPlib structure
-   // Copy them in the pipeline's own arguments table
-   if(par->NmbVarArg)
+   if(!(arg.idx = LPL_malloc(par->lmb, ((int64_t)NmbEle + 1) * 2 * sizeof(uint64_t))))
+      return(0);
+
+   if(!(arg.TmpEle = LPL_malloc(par->lmb, ((int64_t)NmbEle + 1) * EleSiz * sizeof(itg)))
+   || (ref && !(arg.TmpRef = LPL_malloc(par->lmb, ((int64_t)NmbEle + 1) * sizeof(itg)))) )
    {
-      NewPip->NmbVarArg = par->NmbVarArg;
+      if(arg.TmpEle)
+         LPL_free(par->lmb, arg.TmpEle);
 
-      for(i=0;i<par->NmbVarArg;i++)
-         NewPip->VarArgTab[i] = par->VarArgTab[i];
+      LPL_free(par->lmb, arg.idx);
+      return(0);
    }
 
-   // Lock pipe mutex, increment pipe counter
-   // and launch the pipe regardless dependencies
-   pthread_mutex_lock(&par->PipMtx);
-   NewPip->idx = ++par->NmbPip;
-   par->PenPip++;
+   // Remap the connectivity, give a code to each element and sort them
+   RunLin(ParIdx, NmbEle, (void *)ElePrc, (void *)&arg);
 
-   if(par->StkSiz)
-   {
-      pthread_attr_init(&NewPip->atr);
-      NewPip->StkSiz = par->StkSiz;
-      NewPip->UsrStk = LPL_malloc(par->lmb, par->StkSiz);
-#ifdef _WIN32
-      pthread_attr_setstackaddr(&NewPip->atr, NewPip->UsrStk);
-      pthread_attr_setstacksize(&NewPip->atr, NewPip->StkSiz);
-#else
-      pthread_attr_setstack(&NewPip->atr, NewPip->UsrStk, NewPip->StkSiz);
-#endif
-      pthread_create(&NewPip->pth, &NewPip->atr, PipHdl, (void *)NewPip);
-   }
-   else
-      pthread_create(&NewPip->pth, NULL, PipHdl, (void *)NewPip);
+   if(!ParallelRadixSort(ParIdx, &arg.idx[1], NmbEle))
+      qsort(&arg.idx[1][0], NmbEle, 2 * sizeof(int64_t), CmpPrc);
 
-   // Make the thread unjoinable to work around a memory leak in some systems
-   pthread_detach(NewPip->pth);
-   pthread_mutex_unlock(&par->PipMtx);
+   // Move the elements to their new location through a copy of the old ones
+   memcpy(arg.TmpEle, EleTab, ((size_t)NmbEle + 1) * EleSiz * sizeof(itg));
+
+   if(ref)
+      memcpy(arg.TmpRef, ref, ((size_t)NmbEle + 1) * sizeof(itg));
 
-   return(NewPip->idx);
+   RunLin(ParIdx, NmbEle, (void *)PrmPrc, (void *)&arg);
+
+   if(arg.TmpRef)
+      LPL_free(par->lmb, arg.TmpRef);
+
+   LPL_free(par->lmb, arg.TmpEle);
+   LPL_free(par->lmb, arg.idx);
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Launch a pipeline procedure with variable numbers of arguments             */
+/* Renumber in place a whole mesh: the vertices along the Hilbert SFC,        */
+/* then NmbTab element tables along the SFC of their barycenters              */
+/* Table i stores NmbEle[i] elements of EleSiz[i] vertices from index 1       */
+/* with an optional reference table EleRef[i]                                 */
+/* Old2New is optional and receives the vertices' new indices                 */
 /*----------------------------------------------------------------------------*/
 
-int LaunchPipelineMultiArg(int64_t ParIdx, int NmbDep, int *DepTab, 
-                           void *prc, int NmbArg, ... )
+int RenumberMesh( int64_t ParIdx, int NmbDim, itg NmbVer, double *crd,
+                  itg *VerRef, int NmbTab, itg *NmbEle, int *EleSiz,
+                  itg **EleTab, itg **EleRef, itg *Old2New )
 {
-   int i, ret;
-   va_list ArgLst;
+   int i, res = 1;
+   itg *VerTab = Old2New;
    ParSct *par = (ParSct *)ParIdx;
 
-   if(NmbArg > MaxVarArg)
-      return(-1);
+   // Get and check lib parallel instance and arguments
+   if( !ParIdx || ((NmbDim != 2) && (NmbDim != 3)) || (NmbVer < 1) || !crd
+   ||  (NmbTab < 0) || (NmbTab && (!NmbEle || !EleSiz || !EleTab)) )
+   {
+      return(0);
+   }
 
-   // Get the variable arguments and store then in the common LPlib structure
-   // This is a temporary storage as the will be copied to the pipeline's own
-   // arguments table after it has been allocated by LaunchPipeline()
-   par->NmbVarArg = NmbArg;
-   va_start(ArgLst, NmbArg);
+   WaiAsy(par);
 
-   for(i=0;i<NmbArg;i++)
-      par->VarArgTab[i] = va_arg(ArgLst, void *);
+   if(!VerTab && !(VerTab = LPL_malloc(par->lmb, ((int64_t)NmbVer + 1) * sizeof(itg))))
+      return(0);
 
-   va_end(ArgLst);
+   if(!RenumberVertices(ParIdx, NmbDim, NmbVer, crd, VerRef, VerTab))
+      res = 0;
 
-   ret = LaunchPipeline(ParIdx, prc, NULL, NmbDep, DepTab);
+   for(i=0; res && (i<NmbTab); i++)
+      res = RenumberElements( ParIdx, NmbDim, NmbVer, crd, VerTab, NmbEle[i],
+                              EleSiz[i], EleTab[i], EleRef ? EleRef[i] : NULL );
 
-   // Clear the temporary arguments table
-   par->NmbVarArg = 0;
+   if(!Old2New)
+      LPL_free(par->lmb, VerTab);
 
-   return(ret);
+   return(res);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Thread handler launching and waitint for user's procedure                  */
+/* Build the type's WPs from a spatial decomposition instead of index ranges: */
+/* lines are ordered along the Hilbert SFC of their coordinates crd           */
+/* (NmbDim per line, from index 1) and each WP is a range of this order,      */
+/* hence a compact cell of space.                                             */
+/* IdxTab receives the ordering table: loops over positions BegIdx to EndIdx  */
+/* must process lines IdxTab[i], the dependencies are still given with the    */
+/* lines' indices. Must be called before setting the type's dependencies      */
+/* A null crd restores the index ordering                                     */
+/* Returns 0 if the type already depends on another type or is depended upon  */
 /*----------------------------------------------------------------------------*/
 
-static void *PipHdl(void *ptr)
+int SetGeometricBlocks( int64_t ParIdx, int TypIdx, int NmbDim,
+                        double *crd, itg **IdxTab )
 {
-   int RunFlg=0, i;
-   PipSct *pip = (PipSct *)ptr;
-   ParSct *par = pip->par;
-   void (*prc)(void *), (*prcgrn)(int, int, int, void *);
+   int      i;
+   ParSct   *par = (ParSct *)ParIdx;
+   TypSct   *typ;
+   ArgSct   SfcArg;
+   RenSct   arg;
 
-   if(pip->GrnIdx)
-   {
-      prcgrn = (void (*)(int, int, int, void *))pip->prc;
-      par->RunPip++;
+   // Get and check lib parallel instance and type
+   if( !ParIdx || (TypIdx < 1) || (TypIdx > MaxTyp) )
+      return(0);
 
-      prcgrn(pip->BegIdx, pip->EndIdx, pip->GrnIdx, pip->arg);
+   WaiAsy(par);
 
-      pthread_mutex_lock(&par->PipMtx);
-      par->PenPip--;
-      par->RunPip--;
-      LPL_free(par->lmb, pip);
-      pthread_mutex_unlock(&par->PipMtx);
-   }
-   else
-   {
-      // Wait for conditions to be met
-      do
-      {
-         pthread_mutex_lock(&par->PipMtx);
+   typ = &par->TypTab[ TypIdx ];
 
-         if(par->RunPip < par->NmbCpu)
-         {
-            RunFlg = 1;
+   if(!typ->NmbLin || typ->DepWrkSiz)
+      return(0);
 
-            for(i=0;i<pip->NmbDep;i++)
-               if(!GetBit(par->PipWrd, pip->DepTab[i]))
-               {
-                  RunFlg = 0;
-                  break;
-               }
-         }
+   // Moving the lines would silently break the dependency blocks of the
+   // types that depend on this one
+   for(i=1;i<=MaxTyp;i++)
+      if(par->TypTab[i].DepWrkSiz && (par->TypTab[i].DepIdx == TypIdx))
+         return(0);
 
-         if(!RunFlg)
-         {
-            pthread_mutex_unlock(&par->PipMtx);
-#ifdef _WIN32
-            Sleep(1);
-#else
-            usleep(1000);
-#endif
-         }
-      }while(!RunFlg);
+   FreGeo(par, typ);
+
+   if(IdxTab)
+      *IdxTab = NULL;
+
+   if(!crd)
+      return(1);
+
+   if( ((NmbDim != 2) && (NmbDim != 3)) || !IdxTab )
+      return(0);
+
+   pthread_once(&SfcOnc, IniSfc);
+
+   if(!SfcOk)
+      return(0);
 
-   // Execute the user's procedure and set the flag to 2 (done)
-      prc = (void (*)(void *))pip->prc;
-      par->RunPip++;
+   memset(&arg, 0, sizeof(RenSct));
+   arg.NmbDim = NmbDim;
+   arg.crd = crd;
 
-      pthread_mutex_unlock(&par->PipMtx);
+   if(!SetRenBox(ParIdx, typ->NmbLin, &arg))
+      return(0);
 
-      if(pip->NmbVarArg)
-         CalVarArgPip(pip, pip->prc);
-      else
-         prc(pip->arg);
+   arg.idx = LPL_malloc(par->lmb, ((int64_t)typ->NmbLin + 1) * 2 * sizeof(uint64_t));
+   arg.New2Old = LPL_malloc(par->lmb, ((int64_t)typ->NmbLin + 1) * sizeof(itg));
+   arg.Old2New = LPL_malloc(par->lmb, ((int64_t)typ->NmbLin + 1) * sizeof(itg));
 
-      pthread_mutex_lock(&par->PipMtx);
+   if(!arg.idx || !arg.New2Old || !arg.Old2New)
+   {
+      if(arg.idx)
+         LPL_free(par->lmb, arg.idx);
 
-      SetBit(par->PipWrd, pip->idx);
+      if(arg.New2Old)
+         LPL_free(par->lmb, arg.New2Old);
 
-      par->PenPip--;
-      par->RunPip--;
-      LPL_free(par->lmb, pip);
-      pthread_mutex_unlock(&par->PipMtx);
+      if(arg.Old2New)
+         LPL_free(par->lmb, arg.Old2New);
+
+      return(0);
    }
 
-   return(NULL);
+   // Sort the lines along the Hilbert SFC
+   SfcArg.NmbDim = NmbDim;
+   SfcArg.CrdTab = crd;
+   SfcArg.idx = arg.idx;
+   memcpy(SfcArg.box, arg.box, 6 * sizeof(double));
+   RunLin(ParIdx, typ->NmbLin, (void *)RenPrc, (void *)&SfcArg);
+
+   if(!ParallelRadixSort(ParIdx, &arg.idx[1], typ->NmbLin))
+      qsort(&arg.idx[1][0], typ->NmbLin, 2 * sizeof(int64_t), CmpPrc);
+
+   RunLin(ParIdx, typ->NmbLin, (void *)GeoPrc, (void *)&arg);
+   LPL_free(par->lmb, arg.idx);
+
+   arg.New2Old[0] = arg.Old2New[0] = 0;
+   typ->GeoIdx = arg.New2Old;
+   typ->GeoPos = arg.Old2New;
+   typ->GeoNmb = typ->NmbLin;
+   *IdxTab = typ->GeoIdx;
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Wait for all pipelined procedures to complete                              */
+/* Set both ways of the geometric ordering from the sorted codes              */
 /*----------------------------------------------------------------------------*/
 
-void WaitPipeline(int64_t ParIdx)
+static void GeoPrc(itg BegIdx, itg EndIdx, int PthIdx, RenSct *arg)
 {
-   int PenPip;
-   ParSct *par = (ParSct *)ParIdx;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return;
+   itg i;
+   (void)(PthIdx);
 
-   do
+   for(i=BegIdx; i<=EndIdx; i++)
    {
-      pthread_mutex_lock(&par->PipMtx);
-      PenPip = par->PenPip;
-      pthread_mutex_unlock(&par->PipMtx);
-#ifdef _WIN32
-      Sleep(1);
-#else
-      //usleep(1000);
-      usleep(10);
-#endif
-   }while(PenPip);
+      arg->New2Old[i] = (itg)arg->idx[i][1];
+      arg->Old2New[ arg->idx[i][1] ] = i;
+   }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Wait for all pipelined procedures to complete                              */
+/* Free a type's geometric ordering                                           */
 /*----------------------------------------------------------------------------*/
 
-void GetLplibInformation(int64_t ParIdx, int *NmbCpu, int *NmbTyp)
+static void FreGeo(ParSct *par, TypSct *typ)
 {
-   int i;
-   ParSct *par = (ParSct *)ParIdx;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return;
+   if(typ->GeoIdx)
+      LPL_free(par->lmb, typ->GeoIdx);
 
-   *NmbCpu = par->NmbCpu;
-   *NmbTyp = 0;
+   if(typ->GeoPos)
+      LPL_free(par->lmb, typ->GeoPos);
 
-   // Count the number of used types
-   for(i=1;i<=MaxTyp;i++)
-      if(par->TypTab[i].NmbLin)
-         (*NmbTyp)++;
+   typ->GeoIdx = typ->GeoPos = NULL;
+   typ->GeoNmb = 0;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Call qsort in parallel then call merge sort in serial                      */
+/* Append an event to a growing table, plain realloc is used since threads    */
+/* record their own events concurrently and libMemBlocks is not thread safe   */
 /*----------------------------------------------------------------------------*/
 
-void ParallelQsort(  int64_t ParIdx, void *base, size_t nel, size_t width,
-                     int (*compar)(const void *, const void *) )
+static int AddEvt(EvtSct **tab, int *NmbEvt, int *MaxEvt, EvtSct *evt)
 {
-   (void)(ParIdx);
-   qsort(base, nel, width, compar);
+   EvtSct *NewTab;
+
+   if(*NmbEvt >= *MaxEvt)
+   {
+      if(!(NewTab = realloc(*tab, (*MaxEvt ? *MaxEvt * 2 : 1024) * sizeof(EvtSct))))
+         return(0);
+
+      *tab = NewTab;
+      *MaxEvt = *MaxEvt ? *MaxEvt * 2 : 1024;
+   }
+
+   (*tab)[ (*NmbEvt)++ ] = *evt;
+
+   return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Compute the hilbert code from 3d coordinates                               */
+/* Open a launch record, the WP run by the threads refer to it                */
 /*----------------------------------------------------------------------------*/
 
-static void RenPrc(itg BegIdx, itg EndIdx, int PthIdx, ArgSct *arg)
+static void BegLch(ParSct *par, void *prc, int TypIdx1, int TypIdx2)
 {
-   uint64_t IntCrd[3], m=1ULL<<63, cod;
-   itg i;
-   int j, b, GeoWrd, NewWrd, BitTab[3] = {1,2,4};
-   double dbl;
-   int rot[8], GeoCod[8]={0,3,7,4,1,2,6,5};  // Z curve = {5,4,7,6,1,0,3,2}
-   int HilCod[8][8] = {
-      {0,7,6,1,2,5,4,3}, {0,3,4,7,6,5,2,1},
-      {0,3,4,7,6,5,2,1}, {2,3,0,1,6,7,4,5},
-      {2,3,0,1,6,7,4,5}, {6,5,2,1,0,3,4,7},
-      {6,5,2,1,0,3,4,7}, {4,3,2,5,6,1,0,7} };
-   (void)(PthIdx);
+   int i;
+   LchSct *NewTab;
 
-   for(i=BegIdx; i<=EndIdx; i++)
+   par->CurLch = -1;
+
+   if(par->NmbLch >= par->MaxLch)
    {
-      // Convert double precision coordinates to integers
-      for(j=0;j<3;j++)
-      {
-         dbl = (arg->crd[i][j] - arg->box[j]) * arg->box[j+3];
-         IntCrd[j] = (uint64_t)dbl;
-      }
+      if(!(NewTab = realloc(par->LchTab, (par->MaxLch ? par->MaxLch * 2 : 256) * sizeof(LchSct))))
+         return;
 
-      // Binary hilbert renumbering loop
-      cod = 0;
+      par->LchTab = NewTab;
+      par->MaxLch = par->MaxLch ? par->MaxLch * 2 : 256;
+   }
 
-      for(j=0;j<8;j++)
-         rot[j] = GeoCod[j];
+   for(i=0;i<=par->NmbCpu;i++)
+      par->PthTab[i].NmbBlk = 0;
 
-      for(b=0;b<21;b++)
-      {
-         GeoWrd = 0;
+   par->CurLch = par->NmbLch++;
+   par->LchTab[ par->CurLch ].prc = prc;
+   par->LchTab[ par->CurLch ].TypIdx1 = TypIdx1;
+   par->LchTab[ par->CurLch ].TypIdx2 = TypIdx2;
+   par->LchTab[ par->CurLch ].beg = GetWallClock();
+}
 
-         for(j=0;j<3;j++)
-         {
-            if(IntCrd[j] & m)
-               GeoWrd |= BitTab[j];
 
-            IntCrd[j] = IntCrd[j]<<1;
-         }
+/*----------------------------------------------------------------------------*/
+/* Close the current launch record                                            */
+/*----------------------------------------------------------------------------*/
 
-         NewWrd = rot[ GeoWrd ];
-         cod = cod<<3 | NewWrd;
+static void EndLch(ParSct *par, float acc)
+{
+   int i;
+   LchSct *lch;
 
-         for(j=0;j<8;j++)
-            rot[j] = HilCod[ NewWrd ][ rot[j] ];
-      }
+   if(par->CurLch < 0)
+      return;
 
-      arg->idx[i][0] = cod;
-      arg->idx[i][1] = i;
-   }
+   lch = &par->LchTab[ par->CurLch ];
+   lch->end = GetWallClock();
+   lch->acc = acc;
+   lch->NmbBlk = 0;
+
+   for(i=0;i<=par->NmbCpu;i++)
+      lch->NmbBlk += par->PthTab[i].NmbBlk;
+
+   par->CurLch = -1;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Comparison of two items for the qsort                                      */
+/* Free all profiling records                                                 */
 /*----------------------------------------------------------------------------*/
 
-int CmpPrc(const void *a, const void *b)
+static void FrePrf(ParSct *par)
 {
-   uint64_t *pa = (uint64_t *)a, *pb = (uint64_t *)b;
-   return(*pa > *pb ? 1 : -1);
-}
+   int i;
 
-void PipSrt(PipArgSct *arg)
-{
-   qsort(arg->base, arg->nel, arg->width, arg->compar);
+   for(i=0;i<=par->NmbCpu;i++)
+   {
+      if(par->PthTab[i].EvtTab)
+         free(par->PthTab[i].EvtTab);
+
+      par->PthTab[i].EvtTab = NULL;
+      par->PthTab[i].NmbEvt = par->PthTab[i].MaxEvt = 0;
+   }
+
+   if(par->LchTab)
+      free(par->LchTab);
+
+   if(par->PevTab)
+      free(par->PevTab);
+
+   par->LchTab = NULL;
+   par->PevTab = NULL;
+   par->NmbLch = par->MaxLch = par->NmbPev = par->MaxPev = 0;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Renumber a set of coordinates through a Hilbert SFC                        */
+/* Write the profiling records in the Chrome trace event JSON format,         */
+/* readable by chrome://tracing and Perfetto: launches, threads' WP           */
+/* and pipeline threads' pipes are three separate processes                   */
 /*----------------------------------------------------------------------------*/
 
-int HilbertRenumbering( int64_t ParIdx, itg NmbLin, double box[6],
-                        double (*crd)[3], uint64_t (*idx)[2] )
+int ExportProfile(int64_t ParIdx, char *FilNam)
 {
-   int      i, NewTyp;
-   double   len = pow(2,64);
-   ArgSct   arg;
+   int i, j;
+   FILE *FilHdl;
+   EvtSct *evt;
+   LchSct *lch;
+   ParSct *par = (ParSct *)ParIdx;
 
    // Get and check lib parallel instance
-   if(!ParIdx)
-     return(0);
+   if(!ParIdx || !FilNam || !(FilHdl = fopen(FilNam, "w")))
+      return(0);
 
-   // Setup the bounding box and a data type,
-   // then give a Hilbert code to each entries
-   NewTyp = NewType(ParIdx, NmbLin);
-   arg.crd = crd;
-   arg.idx = idx;
-   arg.box[0] = box[0];
-   arg.box[1] = box[1];
-   arg.box[2] = box[2];
-   arg.box[3] = len / (box[3] - box[0]);
-   arg.box[4] = len / (box[4] - box[1]);
-   arg.box[5] = len / (box[5] - box[2]);
+   pthread_mutex_lock(&par->PipMtx);
 
+   fprintf(FilHdl, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+   fprintf(FilHdl, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"launches\"}},\n");
+   fprintf(FilHdl, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"threads\"}},\n");
+   fprintf(FilHdl, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"pipelines\"}}");
 
-   if(NmbLin < 10000)
-      RenPrc(1, NmbLin, 0, (void *)&arg);
-   else
-      LaunchParallel(ParIdx, NewTyp, 0, (void *)RenPrc, (void *)&arg);
+   for(i=0;i<par->NmbLch;i++)
+   {
+      lch = &par->LchTab[i];
+      fprintf(FilHdl, ",\n{\"name\":\"launch %d\",\"cat\":\"launch\",\"ph\":\"X\","
+               "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0,\"args\":{\"prc\":\"%p\","
+               "\"typ1\":%d,\"typ2\":%d,\"concurrency\":%g,\"blocked\":%d}}",
+               i, (lch->beg - par->PrfOrg) * 1e6, (lch->end - lch->beg) * 1e6,
+               lch->prc, lch->TypIdx1, lch->TypIdx2, lch->acc, lch->NmbBlk );
+   }
 
-   qsort(&idx[1][0], NmbLin, 2 * sizeof(int64_t), CmpPrc);
+   for(i=0;i<=par->NmbCpu;i++)
+      for(j=0;j<par->PthTab[i].NmbEvt;j++)
+      {
+         evt = &par->PthTab[i].EvtTab[j];
+         fprintf(FilHdl, ",\n{\"name\":\"launch %d\",\"cat\":\"wp\",\"ph\":\"X\","
+                  "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                  "\"args\":{\"beg\":%lld,\"end\":%lld}}",
+                  evt->lch, (evt->beg - par->PrfOrg) * 1e6, (evt->end - evt->beg) * 1e6,
+                  evt->tid, (long long)evt->BegIdx, (long long)evt->EndIdx );
+      }
 
-   for(i=1;i<=NmbLin;i++)
-      idx[ idx[i][1] ][0] = i;
+   for(i=0;i<par->NmbPev;i++)
+   {
+      evt = &par->PevTab[i];
+      fprintf(FilHdl, ",\n{\"name\":\"pipe %d\",\"cat\":\"pipe\",\"ph\":\"X\","
+               "\"ts\":%.3f,\"dur\":%.3f,\"pid\":2,\"tid\":%d}",
+               evt->lch, (evt->beg - par->PrfOrg) * 1e6, (evt->end - evt->beg) * 1e6,
+               evt->tid );
+   }
+
+   fprintf(FilHdl, "\n]}\n");
+   pthread_mutex_unlock(&par->PipMtx);
+   fclose(FilHdl);
 
    return(1);
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* Compute the hilbert code from 2d coordinates                               */
+/* Aggregate the profiling records of all launches of the procedure prc, or   */
+/* of all launches if prc is null, in sta[ ProfileNmbStats ]                  */
+/* Returns the number of launches                                             */
 /*----------------------------------------------------------------------------*/
 
-static void RenPrc2D(itg BegIdx, itg EndIdx, int PthIdx, ArgSct *arg)
+int GetLoopProfile(int64_t ParIdx, void *prc, double *sta)
 {
-   uint64_t IntCrd[2], m=1ULL<<62, cod;
-   itg i;
-   int j, b, GeoWrd, NewWrd, BitTab[2] = {1,2};
-   double dbl;
-   int rot[4], GeoCod[4]={1,2,0,3};
-   int HilCod[4][4] = {{0,3,2,1}, {0,1,2,3}, {0,1,2,3}, {2,1,0,3}};
-   (void)(PthIdx);
+   int i, j, NmbLch = 0;
+   double BusTim[ MaxPth + 1 ] = {0.}, MaxTim = 0., sum = 0.;
+   EvtSct *evt;
+   LchSct *lch;
+   ParSct *par = (ParSct *)ParIdx;
 
-   for(i=BegIdx; i<=EndIdx; i++)
+   // Get and check lib parallel instance
+   if(!ParIdx || !sta)
+      return(0);
+
+   for(i=0;i<ProfileNmbStats;i++)
+      sta[i] = 0.;
+
+   for(i=0;i<par->NmbLch;i++)
    {
-      // Convert double precision coordinates to integers
-      for(j=0;j<2;j++)
-      {
-         dbl = (arg->crd2[i][j] - arg->box[j]) * arg->box[j+2];
-         IntCrd[j] = (uint64_t)dbl;
-      }
+      lch = &par->LchTab[i];
 
-      // Binary hilbert renumbering loop
-      cod = 0;
+      if(prc && (lch->prc != prc))
+         continue;
 
-      for(j=0;j<4;j++)
-         rot[j] = GeoCod[j];
+      NmbLch++;
+      sta[ ProfileWallTime ] += lch->end - lch->beg;
+      sta[ ProfileBlocked ] += lch->NmbBlk;
+      sta[ ProfileConcurrency ] += lch->acc;
+   }
+
+   if(!NmbLch)
+      return(0);
 
-      for(b=0;b<31;b++)
+   // Sum the WP run times per thread
+   for(i=0;i<=par->NmbCpu;i++)
+      for(j=0;j<par->PthTab[i].NmbEvt;j++)
       {
-         GeoWrd = 0;
+         evt = &par->PthTab[i].EvtTab[j];
 
-         for(j=0;j<2;j++)
+         if( (evt->lch < 0) || (evt->lch >= par->NmbLch)
+         ||  (prc && (par->LchTab[ evt->lch ].prc != prc)) )
          {
-            if(IntCrd[j] & m)
-               GeoWrd |= BitTab[j];
-
-            IntCrd[j] = IntCrd[j]<<1;
+            continue;
          }
 
-         NewWrd = rot[ GeoWrd ];
-         cod = cod<<2 | NewWrd;
-
-         for(j=0;j<4;j++)
-            rot[j] = HilCod[ NewWrd ][ rot[j] ];
+         BusTim[i] += evt->end - evt->beg;
+         sta[ ProfileWorkPackages ]++;
       }
 
-      arg->idx[i][0] = cod;
-      arg->idx[i][1] = i;
-   }
-}
-
-
-/*----------------------------------------------------------------------------*/
-/* Renumber a set of 2D coordinates through a Hilbert SFC                     */
-/*----------------------------------------------------------------------------*/
-
-int HilbertRenumbering2D(  int64_t ParIdx, itg NmbLin, double box[4],
-                           double (*crd)[2], uint64_t (*idx)[2] )
-{
-   itg i;
-   int NewTyp;
-   double len = pow(2,62);
-   ArgSct arg;
-
-   // Get and check lib parallel instance
-   if(!ParIdx)
-      return(0);
-
-   NewTyp = NewType(ParIdx, NmbLin);
-   arg.crd2 = crd;
-   arg.idx = idx;
-   arg.box[0] = box[0];
-   arg.box[1] = box[1];
-   arg.box[2] = len / (box[2] - box[0]);
-   arg.box[3] = len / (box[3] - box[1]);
+   for(i=0;i<=par->NmbCpu;i++)
+   {
+      sum += BusTim[i];
 
-   LaunchParallel(ParIdx, NewTyp, 0, (void *)RenPrc2D, (void *)&arg);
-   ParallelQsort(ParIdx, &idx[1][0], NmbLin, 2 * sizeof(int64_t), CmpPrc);
+      if(BusTim[i] > MaxTim)
+         MaxTim = BusTim[i];
+   }
 
-   for(i=1;i<=NmbLin;i++)
-      idx[ idx[i][1] ][0] = i;
+   sta[ ProfileLaunches ] = NmbLch;
+   sta[ ProfileBusyTime ] = sum;
+   sta[ ProfileIdleTime ] = par->NmbCpu * sta[ ProfileWallTime ] - sum;
+   sta[ ProfileImbalance ] = sum ? MaxTim * par->NmbCpu / sum : 0.;
+   sta[ ProfileConcurrency ] /= NmbLch;
 
-   return(1);
+   return(NmbLch);
 }
 
 
@@ -2574,6 +8887,24 @@ static void *LPL_calloc(void *lmb, int64_t itm, int64_t siz)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Allocate a cleared memory area aligned on a cache line,                    */
+/* the address to be freed is returned in adr                                 */
+/*----------------------------------------------------------------------------*/
+
+static void *LPL_aligned_calloc(void *lmb, int64_t siz, void **adr)
+{
+   char *ptr;
+
+   if(!(*adr = LPL_calloc(lmb, 1, siz + 64)))
+      return(NULL);
+
+   ptr = (char *)*adr;
+
+   return(ptr + (64 - ((uintptr_t)ptr & 63)) % 64);
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Encapsulate the selection between libMemBlock and regular libc free        */
 /*----------------------------------------------------------------------------*/
@@ -2588,6 +8919,141 @@ static void LPL_free(void *lmb, void *adr)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* Allocate a cleared block aligned on a cache line from the instance's pool: */
+/* small sizes are rounded to powers of two so that resized tables reuse the  */
+/* blocks released by the previous ones instead of fragmenting the heap.      */
+/* Blocks beyond the largest class are neither rounded nor cached: calloc's   */
+/* lazily cleared pages are then first touched by the threads filling them    */
+/*----------------------------------------------------------------------------*/
+
+static void *PolAlc(ParSct *par, int64_t siz)
+{
+   int   cls = MinPolCls;
+   char  *adr, *ptr;
+
+   if(siz < 0)
+      return(NULL);
+
+   // Room is kept for the block's header and the alignment, whatever
+   // the alignment of the allocator's blocks
+   while( (cls < MaxPolCls) && (((int64_t)1 << cls) < siz + CacLin + PolHdr) )
+      cls++;
+
+   if(cls == MaxPolCls)
+   {
+      if(!(adr = LPL_calloc(par->lmb, 1, siz + CacLin + PolHdr)))
+         return(NULL);
+
+      ptr = (char *)(((uintptr_t)adr + PolHdr + CacLin - 1) & ~(uintptr_t)(CacLin - 1));
+      ((void **)ptr)[-1] = adr;
+      ((intptr_t *)ptr)[-2] = cls;
+
+      return(ptr);
+   }
+
+   if((adr = par->PolTab[ cls ]))
+   {
+      par->PolTab[ cls ] = *(void **)adr;
+      par->PolNmb[ cls ]--;
+   }
+   else if(!(adr = LPL_malloc(par->lmb, (int64_t)1 << cls)))
+      return(NULL);
+
+   // The header just before the aligned pointer stores the block and its class
+   ptr = (char *)(((uintptr_t)adr + PolHdr + CacLin - 1) & ~(uintptr_t)(CacLin - 1));
+   ((void **)ptr)[-1] = adr;
+   ((intptr_t *)ptr)[-2] = cls;
+   memset(ptr, 0, siz);
+
+   return(ptr);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Give a block back to the pool, or to the heap if it is a large one or if   */
+/* its class is full, so that the pool never keeps more than a few MB         */
+/*----------------------------------------------------------------------------*/
+
+static void PolFre(ParSct *par, void *ptr)
+{
+   int   cls;
+   void  *adr;
+
+   if(!ptr)
+      return;
+
+   adr = ((void **)ptr)[-1];
+   cls = (int)((intptr_t *)ptr)[-2];
+
+   if( (cls == MaxPolCls) || (par->PolNmb[ cls ] >= MaxPolBlk) )
+   {
+      LPL_free(par->lmb, adr);
+      return;
+   }
+
+   *(void **)adr = par->PolTab[ cls ];
+   par->PolTab[ cls ] = adr;
+   par->PolNmb[ cls ]++;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Release all the pool's blocks                                              */
+/*----------------------------------------------------------------------------*/
+
+static void FrePol(ParSct *par)
+{
+   int   cls;
+   void  *adr;
+
+   for(cls=MinPolCls; cls<MaxPolCls; cls++)
+      while((adr = par->PolTab[ cls ]))
+      {
+         par->PolTab[ cls ] = *(void **)adr;
+         LPL_free(par->lmb, adr);
+      }
+
+   memset(par->PolNmb, 0, MaxPolCls * sizeof(int));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Call the user's procedure with a single argument or variable arguments     */
+/*----------------------------------------------------------------------------*/
+
+static void CalPrc(ParSct *par, itg BegIdx, itg EndIdx, int PthIdx)
+{
+   EvtSct evt;
+   PthSct *pth;
+
+   // Time the WP of the profiled launches
+   if(par->PrfFlg && (par->CurLch >= 0))
+      evt.beg = GetWallClock();
+
+   // Reduction loops get the thread's scratch as an extra argument,
+   // the generic function type keeps the cast warning free
+   if(par->RedFlg)
+      ((void (*)(itg, itg, int, void *, void *))(void (*)(void))par->prc)
+         (BegIdx, EndIdx, PthIdx, par->arg, &par->RedTab[ PthIdx * par->RedSlb ]);
+   else if(par->NmbVarArg)
+      CalVarArgPrc(BegIdx, EndIdx, PthIdx, par);
+   else
+      par->prc(BegIdx, EndIdx, PthIdx, par->arg);
+
+   if(par->PrfFlg && (par->CurLch >= 0))
+   {
+      pth = &par->PthTab[ PthIdx ];
+      evt.end = GetWallClock();
+      evt.BegIdx = BegIdx;
+      evt.EndIdx = EndIdx;
+      evt.lch = par->CurLch;
+      evt.tid = PthIdx;
+      AddEvt(&pth->EvtTab, &pth->NmbEvt, &pth->MaxEvt, &evt);
+   }
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* Duplication macros                                                        */
 /*----------------------------------------------------------------------------*/
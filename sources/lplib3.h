@@ -11,7 +11,7 @@
 /*   Description:       Handles threads, scheduling, pipelines & dependencies */
 /*   Author:            Loic MARECHAL                                         */
 /*   Creation date:     feb 25 2008                                           */
-/*   Last modification: oct 31 2024                                           */
+/*   Last modification: oct 14 2026                                           */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
 
@@ -42,26 +42,57 @@ extern "C" {
 int      AddDependency           (int64_t, itg, itg);
 void     AddDependencyFast       (int64_t, int, itg *, int, itg *);
 int      BeginDependency         (int64_t, int, int);
+int      BuildDependencyParallel (int64_t, int, int, int, itg *, float [2]);
 int      EndDependency           (int64_t, float [2]);
+int      ExportProfile           (int64_t, char *);
 void     FreeType                (int64_t, int);
+void     FreeWorkList            (int64_t, int);
 void     GetDependencyStats      (int64_t, int, int, float [2]);
 void     GetLplibInformation     (int64_t, int *, int *);
+float    GetLocalityStats        (int64_t);
+int      GetLoopProfile          (int64_t, void *, double *);
 int      GetNumberOfCores        ();
+float    GetWorkStealingStats    (int64_t, itg *, int *);
 double   GetWallClock            ();
+int      HilbertEncodeBatch      (int64_t, int, int, itg, double *,
+                                  double *, uint64_t *);
 int      HilbertRenumbering      (int64_t, itg, double [6],
                                   double (*)[3], uint64_t (*)[2]);
 int      HilbertRenumbering2D    (int64_t, itg, double [4],
                                   double (*)[2], uint64_t (*)[2]);
 int64_t  InitParallel            (int);
 int64_t  InitParallelAttr        (int, size_t, void *);
+int64_t  InitTeam                (int64_t, int);
 float    LaunchParallel          (int64_t, int, int, void *, void *);
 float    LaunchParallelMultiArg  (int64_t, int, int, void *, int, ...);
+int64_t  LaunchParallelAsync     (int64_t, int, int, void *, void *, int);
+float    LaunchParallelReduce    (int64_t, int, int, void *, void *, int,
+                                  size_t, void *, void *);
+float    LaunchQueuedLoops       (int64_t);
+itg      LaunchWorkList          (int64_t, int, int, int, void *, void *);
 int      LaunchPipeline          (int64_t, void *, void *, int, int *);
 int      LaunchPipelineMultiArg  (int64_t, int, int *, void *prc, int, ...);
 int      NewType                 (int64_t, itg);
+int      NewWorkList             (int64_t, itg, int, int);
+int      ParallelGather          (int64_t, void *, void *, size_t, itg, itg *);
 int      ParallelMemClear        (int64_t, void *, size_t);
+int      ParallelMemCopy         (int64_t, void *, void *, size_t);
+int      ParallelMemFill         (int64_t, void *, size_t, void *, size_t);
+int      ParallelPrefixSum       (int64_t, itg, itg *);
+int      ParallelTypeMemClear    (int64_t, int, void *, size_t);
 void     ParallelQsort           (int64_t, void *, size_t, size_t, 
                                   int (*)(const void *, const void *));
+int      ParallelRadixSort       (int64_t, uint64_t (*)[2], size_t);
+int      ParallelScatter         (int64_t, void *, void *, size_t, itg, itg *);
+int      PushWorkList            (int64_t, int, int, itg);
+int      QueueParallelLoop       (int64_t, int, int, void *, void *);
+int      RefreshDependency       (int64_t, int, int, itg, itg *, int, itg *,
+                                  float [2]);
+int      RenumberElements        (int64_t, int, itg, double *, itg *,
+                                  itg, int, itg *, itg *);
+int      RenumberMesh            (int64_t, int, itg, double *, itg *, int,
+                                  itg *, int *, itg **, itg **, itg *);
+int      RenumberVertices        (int64_t, int, itg, double *, itg *, itg *);
 int      ResizeType              (int64_t, int, itg);
 void     StopParallel            (int64_t);
 int      UpdateDependency        (int64_t, int, int, itg, itg);
@@ -75,6 +106,9 @@ int      HalveDependencyBlocks   (int64_t, int, int);
 int      SetColorGrains          (int64_t, int, int, int *, int, int *);
 int      LaunchColorGrains       (int64_t, int, void *, void *);
 int      SetElementsColorGrain   (int64_t, int, int, int , int *);
+int      SetGeometricBlocks      (int64_t, int, int, double *, itg **);
+int      TestParallel            (int64_t, int64_t);
+float    WaitParallel            (int64_t, int64_t);
 
 #ifdef __cplusplus
 } // end extern "C"
@@ -95,8 +129,34 @@ enum ArgAtr {
    DisableBlockSorting,
    StaticScheduling,
    SetSmallBlock,
-   SetDependencyBlock
+   SetDependencyBlock,
+   DynamicScheduling,
+   LockFreeScheduling,
+   SetSpinWait,
+   EnableWorkStealing,
+   DisableWorkStealing,
+   SetThreadPinning,
+   EnableLocalityScheduling,
+   DisableLocalityScheduling,
+   DenseDependencies,
+   SparseDependencies,
+   AutomaticDependencies,
+   EnableAutomaticBlocks,
+   DisableAutomaticBlocks,
+   EnableProfiling,
+   DisableProfiling,
+   DeterministicScheduling
 };
 
+enum PinMod {NoPinning, CompactPinning, ScatterPinning};
+enum SfcTyp {HilbertCurve = 1, ZCurve};
+enum PrfSta {  ProfileLaunches, ProfileWallTime, ProfileBusyTime, ProfileIdleTime,
+               ProfileImbalance, ProfileBlocked, ProfileWorkPackages,
+               ProfileConcurrency, ProfileNmbStats };
+enum LstMod {FifoWorkList = 1, LifoWorkList};
+enum RedOpr {  ReduceSumDouble = 1, ReduceMinDouble, ReduceMaxDouble,
+               ReduceSumFloat, ReduceMinFloat, ReduceMaxFloat,
+               ReduceSumItg, ReduceMinItg, ReduceMaxItg, ReduceCustom };
+
 
 #endif  //-- define _LPLIB_H
@@ -0,0 +1,138 @@
+#ifndef _LPLIB_HPP
+#define _LPLIB_HPP
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               LPlib V4.00                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*   Description:       Optional C++ front end taking lambdas or functors     */
+/*   Author:            Loic MARECHAL                                         */
+/*   Creation date:     oct 14 2026                                           */
+/*   Last modification: oct 14 2026                                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------*/
+/* The C calls only see a trampoline instantiated for each callable type:     */
+/* it is called once per WP and the callable's body, including the loop over  */
+/* the WP's lines, is compiled inline within it so that it can be vectorized  */
+/* Callables may capture any number of variables of any type, they must not   */
+/* throw as exceptions cannot cross the library's C frames                    */
+/*----------------------------------------------------------------------------*/
+
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "lplib3.h"
+
+
+namespace lplib
+{
+
+/*----------------------------------------------------------------------------*/
+/* Trampolines                                                                */
+/*----------------------------------------------------------------------------*/
+
+// Give the callable a whole range: f(BegIdx, EndIdx, PthIdx)
+template <typename F>
+void RngPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   (*static_cast<F *>(arg))(BegIdx, EndIdx, PthIdx);
+}
+
+// Call it on each line of the range: f(idx, PthIdx)
+template <typename F>
+void LinPrc(itg BegIdx, itg EndIdx, int PthIdx, void *arg)
+{
+   F &f = *static_cast<F *>(arg);
+
+   for(itg i=BegIdx; i<=EndIdx; i++)
+      f(i, PthIdx);
+}
+
+// Colors' grains come with int indices: f(BegIdx, EndIdx, GrnIdx)
+template <typename F>
+void GrnPrc(int BegIdx, int EndIdx, int GrnIdx, void *arg)
+{
+   (*static_cast<F *>(arg))(BegIdx, EndIdx, GrnIdx);
+}
+
+// A pipe owns a copy of its callable and releases it once run: f()
+template <typename F>
+void PipPrc(void *arg)
+{
+   F *f = static_cast<F *>(arg);
+
+   (*f)();
+   delete f;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Loops                                                                      */
+/*----------------------------------------------------------------------------*/
+
+// Same as the C LaunchParallel with a callable taking (BegIdx, EndIdx, PthIdx)
+template <typename F>
+float LaunchParallel(int64_t ParIdx, int TypIdx1, int TypIdx2, F &&f)
+{
+   typedef typename std::remove_reference<F>::type FncTyp;
+
+   return(::LaunchParallel(ParIdx, TypIdx1, TypIdx2,
+            (void *)&RngPrc<FncTyp>, (void *)&f));
+}
+
+// Same as above with a callable taking (idx, PthIdx) for each line
+template <typename F>
+float ParallelFor(int64_t ParIdx, int TypIdx1, int TypIdx2, F &&f)
+{
+   typedef typename std::remove_reference<F>::type FncTyp;
+
+   return(::LaunchParallel(ParIdx, TypIdx1, TypIdx2,
+            (void *)&LinPrc<FncTyp>, (void *)&f));
+}
+
+// Same as the C LaunchColorGrains with a callable taking (BegIdx, EndIdx, GrnIdx)
+template <typename F>
+int LaunchColorGrains(int64_t ParIdx, int TypIdx, F &&f)
+{
+   typedef typename std::remove_reference<F>::type FncTyp;
+
+   return(::LaunchColorGrains(ParIdx, TypIdx,
+            (void *)&GrnPrc<FncTyp>, (void *)&f));
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Pipelines                                                                  */
+/*----------------------------------------------------------------------------*/
+
+// Same as the C LaunchPipeline: the callable is copied or moved as the pipe
+// runs after the caller's scope, so its captures must outlive it
+template <typename F>
+int LaunchPipeline(int64_t ParIdx, int NmbDep, int *DepTab, F &&f)
+{
+   typedef typename std::decay<F>::type FncTyp;
+   FncTyp *ptr;
+   int idx;
+
+   if(!(ptr = new (std::nothrow) FncTyp(std::forward<F>(f))))
+      return(0);
+
+   if(!(idx = ::LaunchPipeline(ParIdx, (void *)&PipPrc<FncTyp>,
+            (void *)ptr, NmbDep, DepTab)))
+   {
+      delete ptr;
+   }
+
+   return(idx);
+}
+
+} // end namespace lplib
+
+
+#endif  //-- define _LPLIB_HPP
@@ -9,13 +9,14 @@
 /* Description:         lplib's helper functions' headers                     */
 /* Author:              Loic MARECHAL                                         */
 /* Creation date:       may 16 2024                                           */
-/* Last modification:   oct 31 2024                                           */
+/* Last modification:   oct 14 2026                                           */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
 
 
-#ifndef LPLIB3_HELPERS_H
-#define LPLIB3_HELPERS_H
+// Not the header's LPLIB3_HELPERS_H guard, which would hide its content
+#ifndef LPLIB3_HELPERS_C
+#define LPLIB3_HELPERS_C
 
 
 /*----------------------------------------------------------------------------*/
@@ -25,6 +26,7 @@
 #include <assert.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "lplib3.h"
 #include "lplib3_helpers.h"
 
@@ -54,6 +56,7 @@
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 #define POW(a) ((a) * (a))
 #define MAXEDG 1000
+#define MAXFAC 1000
 
 
 /*----------------------------------------------------------------------------*/
@@ -67,9 +70,29 @@ typedef struct
 
 typedef struct
 {
-   itg      beg, end, HshSiz, ColPos, NmbEdg, EdgAdr, *EleTab, (*EdgTab)[2];
-   int      NmbCpu;
+   itg vtx[4], EleIdx, NexBuc;
+   int FacIdx;
+}FacSct;
+
+typedef struct
+{
+   itg      ColPos, MaxBuc, NmbBuf, MaxBuf, NmbBnd, (*BufTab)[2];
    HshSct   *HshTab;
+   FacSct   *FacTab;
+}PthSct;
+
+typedef struct
+{
+   itg      PthIdx, BufIdx, NmbEdg, EdgAdr;
+}SlcSct;
+
+typedef struct
+{
+   itg      HshSiz, SlcSiz, *EleTab, (*EdgTab)[2], *NgbTab;
+   int      NmbCpu, EleSiz, NmbEleEdg, NmbEleFac;
+   const int (*EleEdg)[2], (*EleFac)[4];
+   SlcSct   *SlcTab;
+   PthSct   PthTab[ MaxPth ];
 }ParSct;
 
 
@@ -79,79 +102,159 @@ typedef struct
 
 void ParEdg1(itg, itg, int, ParSct *);
 void ParEdg2(itg, itg, int, ParSct *);
+void ParEdg3(itg, itg, int, ParSct *);
+void ParNgb1(itg, itg, int, ParSct *);
+void ParNgb2(itg, itg, int, ParSct *);
+void SetFacKey(itg *, const int *, itg *);
 
 
 /*----------------------------------------------------------------------------*/
 /* Global tables                                                              */
 /*----------------------------------------------------------------------------*/
 
-const int tvpe[6][2] = { {0,1}, {1,2}, {2,0}, {3,0}, {3,1}, {3,2} };
+// Number of vertices and edges of each kind of element
+const int EleVer[8] = {1, 2, 3, 4, 4, 5, 6, 8};
+const int EleNmbEdg[8] = {0, 1, 3, 4, 6, 8, 9, 12};
+
+// Local vertices of each element's edges
+const int EleEdg[8][12][2] = {
+   { {0,0} },
+   { {0,1} },
+   { {0,1}, {1,2}, {2,0} },
+   { {0,1}, {1,2}, {2,3}, {3,0} },
+   { {0,1}, {1,2}, {2,0}, {3,0}, {3,1}, {3,2} },
+   { {0,1}, {1,2}, {2,3}, {3,0}, {0,4}, {1,4}, {2,4}, {3,4} },
+   { {0,1}, {1,2}, {2,0}, {3,4}, {4,5}, {5,3}, {0,3}, {1,4}, {2,5} },
+   { {0,1}, {1,2}, {2,3}, {3,0}, {4,5}, {5,6}, {6,7}, {7,4},
+     {0,4}, {1,5}, {2,6}, {3,7} } };
+
+// Number of faces of each kind of element, the faces of surface elements
+// are their edges, face i of a simplex is opposite to its vertex i
+const int EleNmbFac[8] = {0, 0, 3, 4, 4, 5, 5, 6};
+
+// Local vertices of each element's faces, triangles end with a -1
+const int EleFac[8][6][4] = {
+   { {-1,-1,-1,-1} },
+   { {-1,-1,-1,-1} },
+   { {1,2,-1,-1}, {2,0,-1,-1}, {0,1,-1,-1} },
+   { {0,1,-1,-1}, {1,2,-1,-1}, {2,3,-1,-1}, {3,0,-1,-1} },
+   { {1,2,3,-1}, {2,0,3,-1}, {3,0,1,-1}, {0,2,1,-1} },
+   { {0,1,4,-1}, {1,2,4,-1}, {2,3,4,-1}, {3,0,4,-1}, {0,3,2,1} },
+   { {0,2,1,-1}, {3,4,5,-1}, {0,1,4,3}, {1,2,5,4}, {2,0,3,5} },
+   { {0,3,2,1}, {4,5,6,7}, {0,1,5,4}, {1,2,6,5}, {2,3,7,6}, {3,0,4,7} } };
 
 
 /*----------------------------------------------------------------------------*/
-/* Build edges in parallel: head procedure                                    */
+/* Build edges in parallel with a temporary LPlib instance                    */
+/* Kept for compatibility, prefer ParallelBuildMeshEdges with your own        */
+/* LPlib instance to avoid creating a new thread pool on each call            */
 /*----------------------------------------------------------------------------*/
 
 itg ParallelBuildEdges(itg NmbEle, int EleTyp, itg *EleTab, itg **UsrEdg)
 {
-   itg      i, HshSiz, IncSiz, adr = 0, NmbEdg = 0, (*EdgTab)[2];
+   itg      NmbEdg;
    int64_t  LibIdx;
-   int      TetTyp, NmbCpu;
-   HshSct   *HshTab;
-   ParSct   par[ MaxPth ];
 
-   // As for now only tets are supported
-   //if(EleTyp != LplTet)
-     //return(0);
+   if(!(LibIdx = InitParallel(GetNumberOfCores())))
+      return(0);
 
-   // Setup LPlib and datatypes
-   NmbCpu = GetNumberOfCores();
-   LibIdx = InitParallel(NmbCpu);
-   TetTyp = NewType(LibIdx, NmbEle);
+   NmbEdg = ParallelBuildMeshEdges(LibIdx, 1, &EleTyp, &NmbEle, &EleTab, UsrEdg);
+   StopParallel(LibIdx);
 
-   // Setup parallel parameters
-   IncSiz = (NmbEle / NmbCpu) / NmbCpu;
-   HshSiz =  IncSiz * NmbCpu;
+   return(NmbEdg);
+}
 
-   for(i=0;i<NmbCpu;i++)
+
+/*----------------------------------------------------------------------------*/
+/* Build the unique edges of a mesh made of NmbTab element tables             */
+/* with a caller provided LPlib instance                                      */
+/* Table i stores NmbEle[i] elements of kind EleTyp[i] from index 1           */
+/* The edges table is allocated and stored from index 1 as well               */
+/*----------------------------------------------------------------------------*/
+
+itg ParallelBuildMeshEdges(int64_t LibIdx, int NmbTab, int *EleTyp,
+                           itg *NmbEle, itg **EleTab, itg **UsrEdg)
+{
+   itg      i, TotEdg = 0, NmbEdg = 0, (*EdgTab)[2];
+   int      t, NmbCpu, NmbTyp, TmpTyp, SlcTyp;
+   ParSct   *par;
+
+   if(!LibIdx || (NmbTab < 1) || !EleTyp || !NmbEle || !EleTab || !UsrEdg)
+      return(0);
+
+   for(t=0;t<NmbTab;t++)
    {
-      par[i].beg = i * IncSiz;
-      par[i].end = (i + 1) * IncSiz;
-      par[i].HshSiz = HshSiz;
-      par[i].ColPos = HshSiz;
-      par[i].EleTab = EleTab;
-      par[i].NmbCpu = NmbCpu;
-      par[i].EdgAdr = 0;
+      if( (EleTyp[t] < LplVer) || (EleTyp[t] > LplHex) || (NmbEle[t] < 0) )
+         return(0);
+
+      TotEdg += NmbEle[t] * EleNmbEdg[ EleTyp[t] ];
    }
 
-   // Each thread builds a local edge table
-   LaunchParallel(LibIdx, TetTyp, 0, (void *)ParEdg1, (void *)par);
+   if(!TotEdg)
+      return(0);
 
-   // Count the number of unique edges in each thread
-   LaunchParallel(LibIdx, TetTyp, 0, (void *)ParEdg2, (void *)par);
+   GetLplibInformation(LibIdx, &NmbCpu, &NmbTyp);
+   par = calloc(1, sizeof(ParSct));
+   assert(par);
 
-   // Allocate the global edge table and give a slice of it to each threads
+   // Edges are spread among key slices whose merge is balanced among threads,
+   // the direct entries are sized after the number of unique edges per thread
+   par->NmbCpu = NmbCpu;
+   par->SlcSiz = MAX(1, TotEdg / (6 * NmbCpu * NmbCpu * 16));
+   par->HshSiz = par->SlcSiz * NmbCpu * 16;
+   par->SlcTab = calloc(NmbCpu * 16 + 1, sizeof(SlcSct));
+   assert(par->SlcTab);
 
-   for(i=0;i<NmbCpu;i++)
+   // First pass: each thread hashes its elements' edges in a local table
+   for(t=0;t<NmbTab;t++)
+   {
+      if(!EleNmbEdg[ EleTyp[t] ] || !NmbEle[t])
+         continue;
+
+      par->EleTab = EleTab[t];
+      par->EleSiz = EleVer[ EleTyp[t] ];
+      par->NmbEleEdg = EleNmbEdg[ EleTyp[t] ];
+      par->EleEdg = EleEdg[ EleTyp[t] ];
+
+      TmpTyp = NewType(LibIdx, NmbEle[t]);
+      assert(TmpTyp);
+      LaunchParallel(LibIdx, TmpTyp, 0, (void *)ParEdg1, (void *)par);
+      FreeType(LibIdx, TmpTyp);
+   }
+
+   // Second pass: each slice of keys is merged among all local tables
+   // and its unique edges are buffered by the thread that handled it
+   SlcTyp = NewType(LibIdx, NmbCpu * 16);
+   assert(SlcTyp);
+   LaunchParallel(LibIdx, SlcTyp, 0, (void *)ParEdg2, (void *)par);
+
+   // Prefix sum of the slices' edges gives their output address
+   for(i=1;i<=NmbCpu * 16;i++)
    {
-      par[i].EdgAdr = NmbEdg + 1;
-      NmbEdg += par[i].NmbEdg;
+      par->SlcTab[i].EdgAdr = NmbEdg + 1;
+      NmbEdg += par->SlcTab[i].NmbEdg;
    }
 
    EdgTab = malloc((NmbEdg+1) * 2 * sizeof(itg));
    assert(EdgTab);
+   par->EdgTab = EdgTab;
 
-   for(i=0;i<NmbCpu;i++)
-      par[i].EdgTab = EdgTab;
+   // Copy each slice's buffered edges to their final location
+   LaunchParallel(LibIdx, SlcTyp, 0, (void *)ParEdg3, (void *)par);
+   FreeType(LibIdx, SlcTyp);
 
-   // Now each threads counts and stores the unique edges
-   LaunchParallel(LibIdx, TetTyp, 0, (void *)ParEdg2, (void *)par);
-
-   // Free the local hash tables
+   // Free the local hash tables and buffers
    for(i=0;i<NmbCpu;i++)
-      free(par[i].HshTab);
+   {
+      if(par->PthTab[i].HshTab)
+         free(par->PthTab[i].HshTab);
 
-   StopParallel(LibIdx);
+      if(par->PthTab[i].BufTab)
+         free(par->PthTab[i].BufTab);
+   }
+
+   free(par->SlcTab);
+   free(par);
 
    *UsrEdg = (itg *)EdgTab;
 
@@ -160,34 +263,40 @@ itg ParallelBuildEdges(itg NmbEle, int EleTyp, itg *EleTab, itg **UsrEdg)
 
 
 /*----------------------------------------------------------------------------*/
-/* Build thread subdomain's edges                                             */
+/* Hash the edges of a range of elements in the thread's local table          */
 /*----------------------------------------------------------------------------*/
 
 void ParEdg1(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
 {
-   itg i, j, key, idx0, idx1, MinIdx, MaxIdx;
-   itg siz = par[ PthIdx ].HshSiz, col = par[ PthIdx ].ColPos;
+   itg i, key, idx0, idx1, MinIdx, MaxIdx, siz = par->HshSiz;
+   int j, EleSiz = par->EleSiz;
+   PthSct *pth = &par->PthTab[ PthIdx ];
    HshSct *hsh;
-   itg *tet, *EleTab = par[ PthIdx ].EleTab;
+   itg *ele, *EleTab = par->EleTab;
 
-   // allocate a thread local hash table
-   hsh = par[ PthIdx ].HshTab = malloc(7 * siz * sizeof(HshSct));
-   assert(hsh);
+   // Allocate the thread local hash table on first use and clear its direct
+   // entries, there is no need to clear the collision entries
+   if(!pth->HshTab)
+   {
+      pth->MaxBuc = 2 * siz;
+      pth->ColPos = siz;
+      pth->HshTab = malloc(pth->MaxBuc * sizeof(HshSct));
+      assert(pth->HshTab);
+      memset(pth->HshTab, 0, siz * sizeof(HshSct));
+   }
 
-   // Clear the hash table's direct entries,
-   // there is no need to clear the collision entries
-   memset(hsh, 0, siz * sizeof(HshSct));
+   hsh = pth->HshTab;
 
-   // Loop over each tet and each tet's edges
+   // Loop over each element and each element's edges
    for(i=BegIdx; i<=EndIdx; i++)
    {
-      tet = &EleTab[ i * 4 ];
+      ele = &EleTab[ i * EleSiz ];
 
-      for(j=0;j<6;j++)
+      for(j=0;j<par->NmbEleEdg;j++)
       {
          // Compute the hashing key from the edge's vertices indices
-         idx0 = tet[ tvpe[j][0] ];
-         idx1 = tet[ tvpe[j][1] ];
+         idx0 = ele[ par->EleEdg[j][0] ];
+         idx1 = ele[ par->EleEdg[j][1] ];
 
          if(idx0 < idx1)
          {
@@ -200,7 +309,7 @@ void ParEdg1(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
             MaxIdx = idx0;
          }
 
-         key = (3 * MinIdx + 5 * MaxIdx) % siz;
+         key = (itg)((3 * (uint64_t)MinIdx + 5 * (uint64_t)MaxIdx) % siz);
 
          // If the bucket is empty, store the edge
          if(!hsh[ key ].MinIdx)
@@ -218,13 +327,20 @@ void ParEdg1(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
                break;
 
             // If not, allocate a new bucket from the overflow table
-            // and link it to the main entry */
+            // and link it to the main entry, the table grows when full
             if(hsh[ key ].NexBuc)
                key = hsh[ key ].NexBuc;
             else
             {
-               hsh[ key ].NexBuc = col;
-               key = col++;
+               if(pth->ColPos >= pth->MaxBuc)
+               {
+                  pth->MaxBuc *= 2;
+                  hsh = pth->HshTab = realloc(pth->HshTab, pth->MaxBuc * sizeof(HshSct));
+                  assert(hsh);
+               }
+
+               hsh[ key ].NexBuc = pth->ColPos;
+               key = pth->ColPos++;
                hsh[ key ].MinIdx = MinIdx;
                hsh[ key ].MaxIdx = MaxIdx;
                hsh[ key ].NexBuc = 0;
@@ -237,75 +353,350 @@ void ParEdg1(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
 
 
 /*----------------------------------------------------------------------------*/
-/* Setup the missing links between tets that cross subdomains                 */
+/* Merge the entries of a slice of keys among all threads' local tables       */
+/* and buffer the unique edges                                                */
 /*----------------------------------------------------------------------------*/
 
 void ParEdg2(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
 {
-   itg i, key, PthNmbEdg = 0, edg[ MAXEDG ][2];
-   itg siz = par[ PthIdx ].HshSiz, NmbCpu = par[ PthIdx ].NmbCpu;
+   itg i, s, key, edg[ MAXEDG ][2];
    int NmbEdg, flg, j, k;
-   HshSct *hsh = par[ PthIdx ].HshTab, *buc;
-   itg (*EdgTab)[2] = par[ PthIdx ].EdgTab;
+   PthSct *pth = &par->PthTab[ PthIdx ];
+   HshSct *buc;
 
-   // Loop over the hash table direct entries following an interleaved stencil
-   for(i=par[ PthIdx ].beg; i<par[ PthIdx ].end; i++)
+   for(s=BegIdx; s<=EndIdx; s++)
    {
-      NmbEdg = 0;
+      par->SlcTab[s].PthIdx = PthIdx;
+      par->SlcTab[s].BufIdx = pth->NmbBuf;
 
-      // Loop over every entries with the same key
-      // among all threads' local hash tables
-      for(j=0;j<NmbCpu;j++)
+      // Loop over the slice's direct entries
+      for(i=(s-1) * par->SlcSiz; i<s * par->SlcSiz; i++)
       {
-         key = i;
+         NmbEdg = 0;
 
-         // In case of collision, follow the links
-         do
+         // Loop over every entries with the same key
+         // among all threads' local hash tables
+         for(j=0;j<par->NmbCpu;j++)
          {
-            buc = &par[j].HshTab[ key ];
+            if(!par->PthTab[j].HshTab)
+               continue;
 
-            if(buc->MinIdx)
+            key = i;
+
+            // In case of collision, follow the links
+            do
             {
-               // Since edges from different local hash tables may be the same, 
-               // they compared again to avoid duplicates
-               flg = 0;
+               buc = &par->PthTab[j].HshTab[ key ];
 
-               for(k=0;k<NmbEdg;k++)
-                  if( (buc->MinIdx == edg[k][0]) && (buc->MaxIdx == edg[k][1]) )
+               if(buc->MinIdx)
+               {
+                  // Since edges from different local hash tables may be the same,
+                  // they compared again to avoid duplicates
+                  flg = 0;
+
+                  for(k=0;k<NmbEdg;k++)
+                     if( (buc->MinIdx == edg[k][0]) && (buc->MaxIdx == edg[k][1]) )
+                     {
+                        flg= 1;
+                        break;
+                     }
+
+                  // If this edge does not belong to the list, add it to the end
+                  if(!flg)
                   {
-                     flg= 1;
-                     break;
+                     edg[ NmbEdg ][0] = buc->MinIdx;
+                     edg[ NmbEdg ][1] = buc->MaxIdx;
+                     NmbEdg++;
+
+                     if(NmbEdg >= MAXEDG)
+                     {
+                        puts("Too many local edges, increase MAXEDG value.");
+                        exit(1);
+                     }
                   }
+               }
+            }while((key = buc->NexBuc));
+         }
+
+         // Append the key's unique edges to the thread's buffer
+         if(pth->NmbBuf + NmbEdg > pth->MaxBuf)
+         {
+            pth->MaxBuf = MAX(2 * pth->MaxBuf, pth->NmbBuf + NmbEdg + par->SlcSiz);
+            pth->BufTab = realloc(pth->BufTab, pth->MaxBuf * 2 * sizeof(itg));
+            assert(pth->BufTab);
+         }
+
+         memcpy(pth->BufTab[ pth->NmbBuf ], edg, NmbEdg * 2 * sizeof(itg));
+         pth->NmbBuf += NmbEdg;
+      }
+
+      par->SlcTab[s].NmbEdg = pth->NmbBuf - par->SlcTab[s].BufIdx;
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Copy the slices' buffered edges to the global table                        */
+/*----------------------------------------------------------------------------*/
+
+void ParEdg3(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
+{
+   itg s;
+   SlcSct *slc;
+   (void)(PthIdx);
+
+   for(s=BegIdx; s<=EndIdx; s++)
+   {
+      slc = &par->SlcTab[s];
+
+      if(slc->NmbEdg)
+         memcpy(  par->EdgTab[ slc->EdgAdr ],
+                  par->PthTab[ slc->PthIdx ].BufTab[ slc->BufIdx ],
+                  slc->NmbEdg * 2 * sizeof(itg) );
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Build the neighbours of a table of NmbEle elements of kind EleTyp          */
+/* (triangles, quads, tets, pyramids, prisms or hexes) stored from index 1    */
+/* NgbTab must hold NmbEle+1 lines of EleNmbFac[ EleTyp ] entries:            */
+/* the index of the element sharing each face or 0 on the boundary            */
+/* Returns the number of unique faces                                         */
+/*----------------------------------------------------------------------------*/
+
+itg ParallelBuildNeighbours(int64_t LibIdx, int EleTyp, itg NmbEle,
+                            itg *EleTab, itg *NgbTab)
+{
+   itg      i, TotFac, NmbBnd = 0;
+   int      NmbCpu, NmbTyp, TmpTyp, SlcTyp;
+   ParSct   *par;
+
+   if( !LibIdx || (EleTyp < LplTri) || (EleTyp > LplHex) || (NmbEle < 1)
+   ||  !EleTab || !NgbTab )
+   {
+      return(0);
+   }
+
+   GetLplibInformation(LibIdx, &NmbCpu, &NmbTyp);
+   par = calloc(1, sizeof(ParSct));
+   assert(par);
+
+   // Each inner face is shared by two elements
+   TotFac = NmbEle * EleNmbFac[ EleTyp ];
+   par->NmbCpu = NmbCpu;
+   par->SlcSiz = MAX(1, TotFac / (2 * NmbCpu * NmbCpu * 16));
+   par->HshSiz = par->SlcSiz * NmbCpu * 16;
+   par->EleTab = EleTab;
+   par->NgbTab = NgbTab;
+   par->EleSiz = EleVer[ EleTyp ];
+   par->NmbEleFac = EleNmbFac[ EleTyp ];
+   par->EleFac = EleFac[ EleTyp ];
+
+   // First pass: each thread hashes its elements' faces in a local table
+   // and links the faces shared by its own elements
+   TmpTyp = NewType(LibIdx, NmbEle);
+   assert(TmpTyp);
+   LaunchParallel(LibIdx, TmpTyp, 0, (void *)ParNgb1, (void *)par);
+   FreeType(LibIdx, TmpTyp);
+
+   // Second pass: the remaining faces are merged among all local tables
+   // by slices of keys, each element's face is written by a single thread
+   SlcTyp = NewType(LibIdx, NmbCpu * 16);
+   assert(SlcTyp);
+   LaunchParallel(LibIdx, SlcTyp, 0, (void *)ParNgb2, (void *)par);
+   FreeType(LibIdx, SlcTyp);
+
+   for(i=0;i<NmbCpu;i++)
+   {
+      NmbBnd += par->PthTab[i].NmbBnd;
+
+      if(par->PthTab[i].FacTab)
+         free(par->PthTab[i].FacTab);
+   }
+
+   free(par);
 
-               // If this edge does not belong to the list, add it to the end
-               if(!flg)
+   return((TotFac - NmbBnd) / 2 + NmbBnd);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Sort a face's vertices to make a key independent of the orientation        */
+/*----------------------------------------------------------------------------*/
+
+void SetFacKey(itg *ele, const int *FacVer, itg *vtx)
+{
+   int i, j;
+   itg tmp;
+
+   for(i=0;i<4;i++)
+      vtx[i] = (FacVer[i] >= 0) ? ele[ FacVer[i] ] : 0;
+
+   // Insertion sort with the missing vertices at the end
+   for(i=1;i<4;i++)
+      for(j=i; j>0 && vtx[j] && (!vtx[j-1] || (vtx[j] < vtx[j-1])); j--)
+      {
+         tmp = vtx[j];
+         vtx[j] = vtx[j-1];
+         vtx[j-1] = tmp;
+      }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Hash the faces of a range of elements in the thread's local table          */
+/* and link the elements sharing a face                                       */
+/*----------------------------------------------------------------------------*/
+
+void ParNgb1(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
+{
+   itg i, key, vtx[4], siz = par->HshSiz;
+   int j, NmbFac = par->NmbEleFac;
+   PthSct *pth = &par->PthTab[ PthIdx ];
+   FacSct *hsh, *buc;
+   itg *NgbTab = par->NgbTab;
+
+   // Allocate the thread local hash table on first use and clear its direct
+   // entries, there is no need to clear the collision entries
+   if(!pth->FacTab)
+   {
+      pth->MaxBuc = 2 * siz;
+      pth->ColPos = siz;
+      pth->FacTab = malloc(pth->MaxBuc * sizeof(FacSct));
+      assert(pth->FacTab);
+      memset(pth->FacTab, 0, siz * sizeof(FacSct));
+   }
+
+   hsh = pth->FacTab;
+
+   for(i=BegIdx; i<=EndIdx; i++)
+   {
+      for(j=0;j<NmbFac;j++)
+         NgbTab[ i * NmbFac + j ] = 0;
+
+      for(j=0;j<NmbFac;j++)
+      {
+         SetFacKey(&par->EleTab[ i * par->EleSiz ], par->EleFac[j], vtx);
+         key = (itg)(( 3 * (uint64_t)vtx[0] + 5 * (uint64_t)vtx[1]
+                     + 7 * (uint64_t)vtx[2] + 11 * (uint64_t)vtx[3]) % siz);
+
+         // If the bucket is empty, store the face
+         if(!hsh[ key ].vtx[0])
+         {
+            memcpy(hsh[ key ].vtx, vtx, 4 * sizeof(itg));
+            hsh[ key ].EleIdx = i;
+            hsh[ key ].FacIdx = j;
+            continue;
+         }
+
+         // Otherwise, search through the linked list
+         do
+         {
+            buc = &hsh[ key ];
+
+            // If the same unlinked face is found, link both elements
+            if(buc->EleIdx && !memcmp(buc->vtx, vtx, 4 * sizeof(itg)))
+            {
+               NgbTab[ i * NmbFac + j ] = buc->EleIdx;
+               NgbTab[ buc->EleIdx * NmbFac + buc->FacIdx ] = i;
+               buc->EleIdx = 0;
+               break;
+            }
+
+            // If not, allocate a new bucket from the overflow table
+            // and link it to the main entry, the table grows when full
+            if(buc->NexBuc)
+               key = buc->NexBuc;
+            else
+            {
+               if(pth->ColPos >= pth->MaxBuc)
                {
-                  edg[ NmbEdg ][0] = buc->MinIdx;
-                  edg[ NmbEdg ][1] = buc->MaxIdx;
-                  NmbEdg++;
+                  pth->MaxBuc *= 2;
+                  hsh = pth->FacTab = realloc(pth->FacTab, pth->MaxBuc * sizeof(FacSct));
+                  assert(hsh);
+               }
+
+               hsh[ key ].NexBuc = pth->ColPos;
+               key = pth->ColPos++;
+               memcpy(hsh[ key ].vtx, vtx, 4 * sizeof(itg));
+               hsh[ key ].EleIdx = i;
+               hsh[ key ].FacIdx = j;
+               hsh[ key ].NexBuc = 0;
+               break;
+            }
+         }while(1);
+      }
+   }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* Link the faces of a slice of keys left unlinked in the local tables        */
+/*----------------------------------------------------------------------------*/
+
+void ParNgb2(itg BegIdx, itg EndIdx, int PthIdx, ParSct *par)
+{
+   itg i, s, key;
+   int NmbFac, j, k, l, FacSiz = par->NmbEleFac;
+   PthSct *pth = &par->PthTab[ PthIdx ];
+   FacSct *buc, *fac[ MAXFAC ];
+   itg *NgbTab = par->NgbTab;
 
-                  if(NmbEdg >= MAXEDG)
+   for(s=BegIdx; s<=EndIdx; s++)
+   {
+      // Loop over the slice's direct entries
+      for(i=(s-1) * par->SlcSiz; i<s * par->SlcSiz; i++)
+      {
+         NmbFac = 0;
+
+         // Gather the unlinked faces with the same key
+         // among all threads' local hash tables
+         for(j=0;j<par->NmbCpu;j++)
+         {
+            if(!par->PthTab[j].FacTab)
+               continue;
+
+            key = i;
+
+            do
+            {
+               buc = &par->PthTab[j].FacTab[ key ];
+
+               if(buc->vtx[0] && buc->EleIdx)
+               {
+                  fac[ NmbFac++ ] = buc;
+
+                  if(NmbFac >= MAXFAC)
                   {
-                     puts("Too many local edges, increase MAXEDG value.");
+                     puts("Too many local faces, increase MAXFAC value.");
                      exit(1);
                   }
                }
-            }
-         }while((key = buc->NexBuc));
-      }
+            }while((key = buc->NexBuc));
+         }
 
-      // On the second run, add the list of local edges to the global ones
-      if(par[ PthIdx ].EdgAdr)
-         for(j=0;j<NmbEdg;j++)
+         // Link the pairs of identical faces, the others lie on the boundary
+         for(k=0;k<NmbFac;k++)
          {
-            EdgTab[ par[ PthIdx ].EdgAdr + PthNmbEdg + j ][0] = edg[j][0];
-            EdgTab[ par[ PthIdx ].EdgAdr + PthNmbEdg + j ][1] = edg[j][1];
-         }
+            if(!fac[k])
+               continue;
 
-      PthNmbEdg += NmbEdg;
-   }
+            for(l=k+1;l<NmbFac;l++)
+               if(fac[l] && !memcmp(fac[k]->vtx, fac[l]->vtx, 4 * sizeof(itg)))
+                  break;
 
-   par[ PthIdx ].NmbEdg = PthNmbEdg;
+            if(l < NmbFac)
+            {
+               NgbTab[ fac[k]->EleIdx * FacSiz + fac[k]->FacIdx ] = fac[l]->EleIdx;
+               NgbTab[ fac[l]->EleIdx * FacSiz + fac[l]->FacIdx ] = fac[k]->EleIdx;
+               fac[l] = NULL;
+            }
+            else
+               pth->NmbBnd++;
+         }
+      }
+   }
 }
 
 #endif
@@ -9,7 +9,7 @@
 /* Description:         lplib's helper functions' headers                     */
 /* Author:              Loic MARECHAL                                         */
 /* Creation date:       may 16 2024                                           */
-/* Last modification:   oct 31 2024                                           */
+/* Last modification:   oct 14 2026                                           */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
 
@@ -53,6 +53,8 @@ extern "C" {
 #endif
 
 itg ParallelBuildEdges(itg, int, itg *, itg **);
+itg ParallelBuildMeshEdges(int64_t, int, int *, itg *, itg **, itg **);
+itg ParallelBuildNeighbours(int64_t, int, itg, itg *, itg *);
 
 #ifdef __cplusplus
 } // end extern "C"